@@ -0,0 +1,421 @@
+#include "builder/binary_builder.h"
+
+#include "builder/design_builder.h"
+#include "builder/tree_builder.h"
+#include "iroha/binary_format.h"
+#include "iroha/i_design.h"
+#include "iroha/i_platform.h"
+#include "iroha/resource_class.h"
+#include "iroha/resource_params.h"
+#include "numeric/numeric_manager.h"
+
+namespace iroha {
+namespace builder {
+
+BinaryBuilder::BinaryBuilder(DesignBuilder *builder,
+			     TreeBuilder *tree_builder)
+  : builder_(builder), tree_builder_(tree_builder),
+    cur_(nullptr), end_(nullptr), has_error_(false) {
+}
+
+void BinaryBuilder::Build(const char *data, size_t size, IDesign *design) {
+  if (!binary::IsBinary(data, size)) {
+    SetError("Not a binary design");
+    return;
+  }
+  cur_ = data + binary::kMagicLength;
+  end_ = data + size;
+  int version = ReadUInt();
+  if (version != binary::kVersion) {
+    builder_->SetError() << "Unsupported binary version: " << version;
+    return;
+  }
+  for (auto *rc : design->resource_classes_) {
+    resource_classes_[rc->GetName()] = rc;
+  }
+  BuildResourceParams(design->GetParams());
+  int num_platforms = ReadUInt();
+  for (int i = 0; i < num_platforms && !has_error_; ++i) {
+    BuildPlatform(design);
+  }
+  int num_images = ReadUInt();
+  for (int i = 0; i < num_images && !has_error_; ++i) {
+    BuildArrayImage(design);
+  }
+  int num_modules = ReadUInt();
+  for (int i = 0; i < num_modules && !has_error_; ++i) {
+    IModule *mod = BuildModule(design);
+    if (mod != nullptr) {
+      design->modules_.push_back(mod);
+    }
+  }
+  if (!has_error_ && cur_ != end_) {
+    SetError("Trailing data");
+  }
+}
+
+IModule *BinaryBuilder::BuildModule(IDesign *design) {
+  int id = ReadInt();
+  const string &name = ReadStr();
+  IModule *module = new IModule(design, name);
+  module->SetId(id);
+  if (ReadUInt()) {
+    tree_builder_->AddParentModule(ReadInt(), module);
+  }
+  BuildResourceParams(module->GetParams());
+  int num_tables = ReadUInt();
+  for (int i = 0; i < num_tables && !has_error_; ++i) {
+    ITable *table = BuildTable(module);
+    if (table != nullptr) {
+      module->tables_.push_back(table);
+    }
+  }
+  return module;
+}
+
+ITable *BinaryBuilder::BuildTable(IModule *module) {
+  regs_.clear();
+  resources_.clear();
+  states_.clear();
+  insns_.clear();
+  depending_insns_.clear();
+
+  ITable *table = new ITable(module);
+  table->SetId(ReadInt());
+  table->SetName(ReadStr());
+  int num_regs = ReadUInt();
+  for (int i = 0; i < num_regs && !has_error_; ++i) {
+    IRegister *reg = BuildRegister(table);
+    table->registers_.push_back(reg);
+    regs_.push_back(reg);
+  }
+  int num_resources = ReadUInt();
+  for (int i = 0; i < num_resources && !has_error_; ++i) {
+    IResource *res = BuildResource(table);
+    if (res == nullptr) {
+      return table;
+    }
+    if (!resource::IsTransition(*res->GetClass())) {
+      table->resources_.push_back(res);
+    }
+    resources_.push_back(res);
+  }
+  int num_states = ReadUInt();
+  int num_insns = ReadUInt();
+  if (has_error_) {
+    return table;
+  }
+  for (int i = 0; i < num_states; ++i) {
+    IState *st = new IState(table);
+    table->states_.push_back(st);
+    states_.push_back(st);
+  }
+  insns_.reserve(num_insns);
+  int initial = ReadIndex(num_states + 1);
+  if (initial > 0) {
+    table->SetInitialState(states_[initial - 1]);
+  }
+  for (IState *st : states_) {
+    if (has_error_) {
+      return table;
+    }
+    BuildState(st);
+  }
+  for (auto &p : depending_insns_) {
+    if (p.second >= insns_.size()) {
+      SetError("Invalid depending insn");
+      break;
+    }
+    p.first->depending_insns_.push_back(insns_[p.second]);
+  }
+  return table;
+}
+
+IRegister *BinaryBuilder::BuildRegister(ITable *table) {
+  int id = ReadInt();
+  const string &name = ReadStr();
+  IRegister *reg = new IRegister(table, name);
+  reg->SetId(id);
+  int kind = ReadUInt();
+  if (kind == binary::REG_CONST) {
+    reg->SetConst(true);
+  } else if (kind == binary::REG_WIRE) {
+    reg->SetStateLocal(true);
+  }
+  BuildValueType(&reg->value_type_);
+  if (ReadUInt()) {
+    Numeric value;
+    value.type_ = reg->value_type_;
+    Numeric::DefaultManager()->MayPopulateStorage(value.type_,
+						  value.GetMutableArray());
+    BuildValue(&value);
+    reg->SetInitialValue(value);
+  }
+  if (ReadUInt()) {
+    BuildResourceParams(reg->GetParams(true));
+  }
+  return reg;
+}
+
+IResource *BinaryBuilder::BuildResource(ITable *table) {
+  int id = ReadInt();
+  const string &klass = ReadStr();
+  if (has_error_) {
+    return nullptr;
+  }
+  auto it = resource_classes_.find(klass);
+  if (it == resource_classes_.end()) {
+    builder_->SetError() << "Unknown resource class: " << klass;
+    has_error_ = true;
+    return nullptr;
+  }
+  IResourceClass *rc = it->second;
+  IResource *res;
+  if (resource::IsTransition(*rc)) {
+    // Use pre installed resource.
+    res = table->resources_[0];
+  } else {
+    res = new IResource(table, rc);
+  }
+  res->SetId(id);
+  BuildValueTypes(&res->input_types_);
+  BuildValueTypes(&res->output_types_);
+  BuildResourceParams(res->GetParams());
+  int flags = ReadUInt();
+  if (flags & binary::RES_ARRAY) {
+    int address_width = ReadUInt();
+    IValueType data_type;
+    BuildValueType(&data_type);
+    bool is_external = ReadUInt();
+    bool is_ram = ReadUInt();
+    IArray *array = new IArray(res, address_width, data_type,
+			       is_external, is_ram);
+    res->SetArray(array);
+    if (flags & binary::RES_ARRAY_IMAGE) {
+      tree_builder_->AddArrayImage(array, ReadInt());
+    }
+  }
+  if (flags & binary::RES_CALLEE_TABLE) {
+    int mod_id = ReadInt();
+    int tab_id = ReadInt();
+    tree_builder_->AddCalleeTable(mod_id, tab_id, res);
+  }
+  if (flags & binary::RES_PARENT_RESOURCE) {
+    int mod_id = ReadInt();
+    int tab_id = ReadInt();
+    int res_id = ReadInt();
+    tree_builder_->AddParentResource(mod_id, tab_id, res_id, res);
+  }
+  return res;
+}
+
+void BinaryBuilder::BuildState(IState *st) {
+  st->SetId(ReadInt());
+  if (ReadUInt()) {
+    IProfile *profile = st->GetMutableProfile();
+    profile->valid_ = true;
+    profile->raw_count_ = ReadInt();
+    profile->normalized_count_ = ReadInt();
+  }
+  int num_insns = ReadUInt();
+  for (int i = 0; i < num_insns && !has_error_; ++i) {
+    BuildInsn(st);
+  }
+}
+
+void BinaryBuilder::BuildInsn(IState *st) {
+  int id = ReadInt();
+  int res_idx = ReadIndex(resources_.size());
+  if (has_error_) {
+    return;
+  }
+  IInsn *insn = new IInsn(resources_[res_idx]);
+  insn->SetId(id);
+  insn->SetOperand(ReadStr());
+  int num_targets = ReadUInt();
+  for (int i = 0; i < num_targets; ++i) {
+    int idx = ReadIndex(states_.size());
+    if (has_error_) {
+      return;
+    }
+    insn->target_states_.push_back(states_[idx]);
+  }
+  int num_inputs = ReadUInt();
+  for (int i = 0; i < num_inputs; ++i) {
+    int idx = ReadIndex(regs_.size());
+    if (has_error_) {
+      return;
+    }
+    insn->inputs_.push_back(regs_[idx]);
+  }
+  int num_outputs = ReadUInt();
+  for (int i = 0; i < num_outputs; ++i) {
+    int idx = ReadIndex(regs_.size());
+    if (has_error_) {
+      return;
+    }
+    insn->outputs_.push_back(regs_[idx]);
+  }
+  int num_deps = ReadUInt();
+  for (int i = 0; i < num_deps && !has_error_; ++i) {
+    depending_insns_.push_back(make_pair(insn, (int)ReadUInt()));
+  }
+  st->insns_.push_back(insn);
+  insns_.push_back(insn);
+}
+
+void BinaryBuilder::BuildValueType(IValueType *vt) {
+  uint64_t u = ReadUInt();
+  vt->SetWidth(u >> 1);
+  vt->SetIsSigned(u & 1);
+}
+
+void BinaryBuilder::BuildValueTypes(vector<IValueType> *types) {
+  int num_types = ReadUInt();
+  for (int i = 0; i < num_types && !has_error_; ++i) {
+    IValueType type;
+    BuildValueType(&type);
+    types->push_back(type);
+  }
+}
+
+void BinaryBuilder::BuildValue(Numeric *value) {
+  int count = ReadUInt();
+  uint64_t *limbs = Numeric::GetMutableLimbs(value->type_,
+					     value->GetMutableArray());
+  int max_count = Numeric::GetLimbCount(value->type_);
+  if (count > max_count || end_ - cur_ < count * 8) {
+    SetError("Malformed value");
+    return;
+  }
+  for (int i = 0; i < count; ++i) {
+    uint64_t v = 0;
+    for (int j = 0; j < 8; ++j) {
+      v |= ((uint64_t)(unsigned char)cur_[j]) << (j * 8);
+    }
+    limbs[i] = v;
+    cur_ += 8;
+  }
+}
+
+void BinaryBuilder::BuildResourceParams(ResourceParams *params) {
+  int num_keys = ReadUInt();
+  for (int i = 0; i < num_keys && !has_error_; ++i) {
+    string key = ReadStr();
+    vector<string> values;
+    int num_values = ReadUInt();
+    for (int j = 0; j < num_values && !has_error_; ++j) {
+      values.push_back(ReadStr());
+    }
+    params->SetValues(key, values);
+  }
+}
+
+void BinaryBuilder::BuildArrayImage(IDesign *design) {
+  IArrayImage *array_image = new IArrayImage(design);
+  array_image->SetId(ReadInt());
+  array_image->SetName(ReadStr());
+  int num_values = ReadUInt();
+  for (int i = 0; i < num_values && !has_error_; ++i) {
+    array_image->values_.push_back(ReadUInt());
+  }
+  design->array_images_.push_back(array_image);
+}
+
+void BinaryBuilder::BuildPlatform(IDesign *design) {
+  IPlatform *platform = new IPlatform(design);
+  design->platforms_.push_back(platform);
+  platform->SetName(ReadStr());
+  int num_defs = ReadUInt();
+  for (int i = 0; i < num_defs && !has_error_; ++i) {
+    platform::Definition *def = new platform::Definition(platform);
+    def->condition_ = BuildNode(def);
+    def->value_ = BuildNode(def);
+    platform->defs_.push_back(def);
+  }
+}
+
+platform::DefNode *BinaryBuilder::BuildNode(platform::Definition *def) {
+  int type = ReadUInt();
+  if (type == 0 || has_error_) {
+    return nullptr;
+  }
+  platform::DefNode *node = new platform::DefNode(def);
+  if (type == 1) {
+    node->is_atom_ = true;
+    node->str_ = ReadStr();
+    if (node->str_.empty()) {
+      node->num_ = ReadInt();
+    }
+    return node;
+  }
+  int num_nodes = ReadUInt();
+  for (int i = 0; i < num_nodes && !has_error_; ++i) {
+    node->nodes_.push_back(BuildNode(def));
+  }
+  return node;
+}
+
+uint64_t BinaryBuilder::ReadUInt() {
+  uint64_t u = 0;
+  int shift = 0;
+  while (true) {
+    if (cur_ == end_ || shift > 63) {
+      SetError("Unexpected end of data");
+      return 0;
+    }
+    unsigned char c = *cur_;
+    ++cur_;
+    u |= ((uint64_t)(c & 0x7f)) << shift;
+    if (!(c & 0x80)) {
+      break;
+    }
+    shift += 7;
+  }
+  return u;
+}
+
+int64_t BinaryBuilder::ReadInt() {
+  uint64_t u = ReadUInt();
+  // zigzag
+  return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+int BinaryBuilder::ReadIndex(int size) {
+  int idx = ReadUInt();
+  if (idx >= size) {
+    SetError("Index out of range");
+    return 0;
+  }
+  return idx;
+}
+
+const string &BinaryBuilder::ReadStr() {
+  static string empty_string;
+  int idx = ReadUInt();
+  if (idx < strings_.size()) {
+    return strings_[idx];
+  }
+  if (idx > strings_.size()) {
+    SetError("Invalid string index");
+    return empty_string;
+  }
+  int len = ReadUInt();
+  if (has_error_ || end_ - cur_ < len) {
+    SetError("Unexpected end of data");
+    return empty_string;
+  }
+  strings_.push_back(string(cur_, len));
+  cur_ += len;
+  return strings_.back();
+}
+
+void BinaryBuilder::SetError(const char *msg) {
+  if (!has_error_) {
+    builder_->SetError() << msg;
+  }
+  has_error_ = true;
+}
+
+}  // namespace builder
+}  // namespace iroha
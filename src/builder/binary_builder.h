@@ -0,0 +1,66 @@
+// -*- C++ -*-
+//
+// Build Iroha design from the binary format (see iroha/binary_format.h).
+//
+#ifndef _builder_binary_builder_h_
+#define _builder_binary_builder_h_
+
+#include "iroha/common.h"
+
+#include <deque>
+#include <map>
+
+namespace iroha {
+namespace builder {
+
+class DesignBuilder;
+class TreeBuilder;
+
+class BinaryBuilder {
+public:
+  BinaryBuilder(DesignBuilder *builder, TreeBuilder *tree_builder);
+
+  void Build(const char *data, size_t size, IDesign *design);
+
+private:
+  IModule *BuildModule(IDesign *design);
+  ITable *BuildTable(IModule *module);
+  IRegister *BuildRegister(ITable *table);
+  IResource *BuildResource(ITable *table);
+  void BuildState(IState *st);
+  void BuildInsn(IState *st);
+  void BuildValueType(IValueType *vt);
+  void BuildValueTypes(vector<IValueType> *types);
+  void BuildValue(Numeric *value);
+  void BuildResourceParams(ResourceParams *params);
+  void BuildArrayImage(IDesign *design);
+  void BuildPlatform(IDesign *design);
+  platform::DefNode *BuildNode(platform::Definition *def);
+  uint64_t ReadUInt();
+  int64_t ReadInt();
+  // Reads an index and checks it is smaller than size.
+  int ReadIndex(int size);
+  const string &ReadStr();
+  void SetError(const char *msg);
+
+  DesignBuilder *builder_;
+  TreeBuilder *tree_builder_;
+  const char *cur_;
+  const char *end_;
+  bool has_error_;
+  // deque to keep references returned by ReadStr() valid.
+  deque<string> strings_;
+  map<string, IResourceClass *> resource_classes_;
+  // Objects in the current table in the written order.
+  vector<IRegister *> regs_;
+  vector<IResource *> resources_;
+  vector<IState *> states_;
+  vector<IInsn *> insns_;
+  // Pairs of insn and the index of depending insn.
+  vector<pair<IInsn *, int> > depending_insns_;
+};
+
+}  // namespace builder
+}  // namespace iroha
+
+#endif  // _builder_binary_builder_h_
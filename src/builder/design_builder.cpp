@@ -1,9 +1,11 @@
 #include "builder/design_builder.h"
 
+#include "builder/binary_builder.h"
 #include "builder/reader.h"
 #include "builder/fsm_builder.h"
 #include "builder/platform_builder.h"
 #include "builder/tree_builder.h"
+#include "iroha/binary_format.h"
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
 #include "iroha/resource_class.h"
@@ -14,16 +16,16 @@ namespace iroha {
 namespace builder {
 
 IDesign *DesignBuilder::ReadDesign(const string &fn, bool search) {
-  File *f = Reader::ReadFile(fn, search);
+  File *f = Reader::LoadFile(fn, search);
   if (!f) {
     return nullptr;
   }
   std::unique_ptr<File> deleter(f);
-  if (f->exps.size()) {
-    DesignBuilder builder;
-    return builder.Build(f->exps);
+  DesignBuilder builder;
+  if (binary::IsBinary(f->data, f->data_size)) {
+    return builder.BuildBinary(f->data, f->data_size);
   }
-  return nullptr;
+  return builder.BuildStream(f);
 }
 
 DesignBuilder::DesignBuilder() : has_error_(false) {
@@ -36,30 +38,67 @@ IDesign *DesignBuilder::Build(vector<Exp *> &exps) {
   IDesign *design = new IDesign;
   tree_builder_.reset(new TreeBuilder(design, this));
   for (Exp *root : exps) {
-    if (root->Size() == 0) {
-      SetError() << "Empty toplevel expression\n";
-      continue;
-    }
-    const string &element_name = root->GetHead();
-    if (element_name == "MODULE") {
-      IModule *module = BuildModule(root, design);
-      if (module) {
-	design->modules_.push_back(module);
-      } else {
-	SetError();
-      }
-    } else if (element_name == "PARAMS") {
-      BuildResourceParams(root, design->GetParams());
-    } else if (element_name == "ARRAY-IMAGE") {
-      BuildArrayImage(root, design);
-    } else if (element_name == "PLATFORM") {
-      PlatformBuilder builder(*this);
-      builder.BuildPlatform(root, design);
+    BuildToplevel(root, design);
+  }
+  return Resolve(design);
+}
+
+IDesign *DesignBuilder::BuildStream(File *f) {
+  IDesign *design = new IDesign;
+  tree_builder_.reset(new TreeBuilder(design, this));
+  Reader reader(f);
+  int num_exps = 0;
+  Exp *root;
+  while ((root = reader.ReadToplevel()) != nullptr) {
+    BuildToplevel(root, design);
+    // Forward references are kept in tree_builder_ by ids, so the
+    // expression is not needed anymore.
+    reader.ReleaseToplevel();
+    ++num_exps;
+  }
+  if (reader.HasError() || num_exps == 0) {
+    // Same as Build() with the empty result from the Reader.
+    delete design;
+    return nullptr;
+  }
+  return Resolve(design);
+}
+
+void DesignBuilder::BuildToplevel(Exp *root, IDesign *design) {
+  if (root->Size() == 0) {
+    SetError() << "Empty toplevel expression\n";
+    return;
+  }
+  const string &element_name = root->GetHead();
+  if (element_name == "MODULE") {
+    IModule *module = BuildModule(root, design);
+    if (module) {
+      design->modules_.push_back(module);
     } else {
-      SetError() << "Unsupported toplevel expression: "
-		 << element_name;
+      SetError();
     }
+  } else if (element_name == "PARAMS") {
+    BuildResourceParams(root, design->GetParams());
+  } else if (element_name == "ARRAY-IMAGE") {
+    BuildArrayImage(root, design);
+  } else if (element_name == "PLATFORM") {
+    PlatformBuilder builder(*this);
+    builder.BuildPlatform(root, design);
+  } else {
+    SetError() << "Unsupported toplevel expression: "
+	       << element_name;
   }
+}
+
+IDesign *DesignBuilder::BuildBinary(const char *data, size_t size) {
+  IDesign *design = new IDesign;
+  tree_builder_.reset(new TreeBuilder(design, this));
+  BinaryBuilder builder(this, tree_builder_.get());
+  builder.Build(data, size, design);
+  return Resolve(design);
+}
+
+IDesign *DesignBuilder::Resolve(IDesign *design) {
   if (!HasError()) {
     tree_builder_->Resolve();
   }
@@ -215,8 +254,7 @@ IRegister *DesignBuilder::BuildRegister(Exp *e, ITable *table) {
     Numeric value;
     value.SetValue0(Util::AtoULL(ini));
     value.type_ = reg->value_type_;
-    Numeric::DefaultManager()->MayPopulateStorage(value.type_,
-						  value.GetMutableArray());
+    Numeric::MayExpandStorage(nullptr, &value);
     reg->SetInitialValue(value);
   }
   if (e->Size() >= 7) {
@@ -13,6 +13,7 @@ namespace iroha {
 namespace builder {
 
 class Exp;
+class File;
 class TreeBuilder;
 
 class DesignBuilder {
@@ -21,11 +22,16 @@ public:
   ~DesignBuilder();
 
   IDesign *Build(vector<Exp *> &exps);
+  // Builds each toplevel element as soon as it is read and frees it.
+  IDesign *BuildStream(File *f);
+  IDesign *BuildBinary(const char *data, size_t size);
   ostream &SetError();
 
   static IDesign *ReadDesign(const string &fn, bool search);
 
 private:
+  void BuildToplevel(Exp *root, IDesign *design);
+  IDesign *Resolve(IDesign *design);
   IModule *BuildModule(Exp *e, IDesign *design);
   ITable *BuildTable(Exp *e, IModule *module);
   IState *BuildState(Exp *e, ITable *table);
@@ -2,6 +2,7 @@
 
 #include "builder/design_builder.h"
 #include "builder/reader.h"
+#include "design/design_util.h"
 #include "iroha/i_design.h"
 
 namespace iroha {
@@ -9,16 +10,6 @@ namespace builder {
 
 FsmBuilder::FsmBuilder(ITable *table, DesignBuilder *builder)
   : table_(table), builder_(builder), initial_state_id_(-1) {
-  Init();
-}
-
-void FsmBuilder::Init() {
-  for (auto *res : table_->resources_) {
-    resources_[res->GetId()] = res;
-  }
-  for (auto *reg : table_->registers_) {
-    registers_[reg->GetId()] = reg;
-  }
 }
 
 void FsmBuilder::AddState(Exp *e) {
@@ -111,7 +102,7 @@ IInsn *FsmBuilder::BuildInsn(Exp *e) {
     return nullptr;
   }
   int res_id = Util::Atoi(e->vec[3]->atom.str);
-  IResource *res = resources_[res_id];
+  IResource *res = DesignUtil::FindResourceById(table_, res_id);
   if (!res) {
     builder_->SetError() << "Unknown resource id: " << res_id;
     return nullptr;
@@ -154,7 +145,7 @@ void FsmBuilder::BuildProfile(Exp *e, IState *st) {
 
 void FsmBuilder::BuildInsnParams(Exp *e, vector<IRegister *> *regs) {
   int reg_id = Util::Atoi(e->atom.str);
-  IRegister *reg = registers_[reg_id];
+  IRegister *reg = DesignUtil::FindRegisterById(table_, reg_id);
   if (!reg) {
     builder_->SetError() << "Unknown register id: " << reg_id;
     return;
@@ -21,7 +21,6 @@ public:
   void ResolveInsns();
 
 private:
-  void Init();
   IInsn *BuildInsn(Exp *e);
   void BuildInsnParams(Exp *e, vector<IRegister *> *regs);
   void ResolveDependingInsns(Exp *e, IInsn *insn);
@@ -31,9 +30,7 @@ private:
   DesignBuilder *builder_;
   int initial_state_id_;
 
-  map<int, IResource *> resources_;
   map<int, IInsn *> insns_;
-  map<int, IRegister *> registers_;
   map<int, IState *> states_;
   map<int, Exp *> exps_;
 };
@@ -1,63 +1,201 @@
 #include "builder/reader.h"
 
-#include <fstream>
 #include <ctype.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
 
 namespace iroha {
 namespace builder {
 
-Exp::~Exp() {
-  for (Exp *e : vec) {
-    if (e) {
-      delete e;
-    }
-  }
+static const size_t kArenaBlockSize = 1024 * 1024;
+
+bool StringPiece::operator==(const char *s) const {
+  return strncmp(ptr_, s, len_) == 0 && s[len_] == '\0';
+}
+
+bool StringPiece::operator==(const string &s) const {
+  return s.size() == len_ && memcmp(ptr_, s.c_str(), len_) == 0;
+}
+
+ostream &operator<<(ostream &os, const StringPiece &s) {
+  os.write(s.data(), s.size());
+  return os;
 }
 
-const string &Exp::GetHead() {
-  static string empty_string;
+StringPiece Exp::GetHead() {
   if (vec.size() == 0) {
-    return empty_string;
+    return StringPiece();
   }
   return vec[0]->atom.str;
 }
 
-const string &Exp::Str(int nth) {
+StringPiece Exp::Str(int nth) {
   if (nth < vec.size()) {
     return vec[nth]->atom.str;
   }
-  static string empty_string;
-  return empty_string;
+  return StringPiece();
 }
 
 int Exp::Size() {
   return vec.size();
 }
 
+Arena::Arena() : first_block_size_(0), cur_(nullptr), remaining_(0) {
+}
+
+Arena::~Arena() {
+  for (char *b : blocks_) {
+    delete[] b;
+  }
+}
+
+void *Arena::Alloc(size_t size) {
+  // Keeps pointer alignment.
+  size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  if (size > remaining_) {
+    size_t block_size = kArenaBlockSize;
+    if (size > block_size) {
+      block_size = size;
+    }
+    cur_ = new char[block_size];
+    if (blocks_.empty()) {
+      first_block_size_ = block_size;
+    }
+    blocks_.push_back(cur_);
+    remaining_ = block_size;
+  }
+  void *p = cur_;
+  cur_ += size;
+  remaining_ -= size;
+  return p;
+}
+
+void Arena::Reset() {
+  if (blocks_.empty()) {
+    return;
+  }
+  for (size_t i = 1; i < blocks_.size(); ++i) {
+    delete[] blocks_[i];
+  }
+  blocks_.resize(1);
+  cur_ = blocks_[0];
+  remaining_ = first_block_size_;
+}
+
+File::File() : data(nullptr), data_size(0), mapped_(false) {
+}
+
 File::~File() {
-  for (Exp *e : exps) {
-    delete e;
+  if (mapped_) {
+    munmap(const_cast<char *>(data), data_size);
+  }
+}
+
+bool File::MapFile(const string &fn) {
+  int fd = open(fn.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    close(fd);
+    return false;
+  }
+  if (!S_ISREG(st.st_mode)) {
+    // e.g. named pipes can't be mapped.
+    close(fd);
+    std::ifstream ifs(fn);
+    if (ifs.fail()) {
+      return false;
+    }
+    return ReadStream(ifs);
+  }
+  data_size = st.st_size;
+  if (data_size > 0) {
+    void *p = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      data_size = 0;
+      return false;
+    }
+    madvise(p, data_size, MADV_SEQUENTIAL);
+    data = (const char *)p;
+    mapped_ = true;
+  }
+  close(fd);
+  return true;
+}
+
+bool File::ReadStream(istream &is) {
+  ostringstream os;
+  os << is.rdbuf();
+  buf_ = os.str();
+  data = buf_.c_str();
+  data_size = buf_.size();
+  return true;
+}
+
+Exp *File::NewExp() {
+  return new(arena.Alloc(sizeof(Exp))) Exp();
+}
+
+void File::SetList(Exp *e, Exp **exps, int size) {
+  e->vec.size_ = size;
+  if (size == 0) {
+    return;
+  }
+  e->vec.exps_ = (Exp **)arena.Alloc(sizeof(Exp *) * size);
+  memcpy(e->vec.exps_, exps, sizeof(Exp *) * size);
+}
+
+void File::ReleaseExps(const char *pos) {
+  exps.clear();
+  arena.Reset();
+  if (!mapped_) {
+    return;
+  }
+  // Drops pages of the mapped text from this process.
+  long page_size = sysconf(_SC_PAGESIZE);
+  size_t len = ((pos - data) / page_size) * page_size;
+  if (len > 0) {
+    madvise(const_cast<char *>(data), len, MADV_DONTNEED);
   }
 }
 
 File *Reader::ReadFile(const string &fn, bool search) {
-  std::istream *ifs;
-  unique_ptr<istream> ifs_deleter;
+  File *f = LoadFile(fn, search);
+  if (f != nullptr) {
+    ParseFile(f);
+  }
+  return f;
+}
+
+File *Reader::LoadFile(const string &fn, bool search) {
+  File *f = new File;
   if (fn.empty() || fn == "-") {
-    ifs = &cin;
-  } else {
-    if (search) {
-      ifs = Util::OpenFile(fn);
-    } else {
-      ifs = new std::ifstream(fn);
-    }
-    ifs_deleter.reset(ifs);
+    f->ReadStream(cin);
+    return f;
+  }
+  string path = fn;
+  if (search) {
+    path = Util::FindFile(fn);
   }
-  if (ifs == nullptr || ifs->fail()) {
+  if (path.empty() || !f->MapFile(path)) {
+    delete f;
     return nullptr;
   }
-  std::unique_ptr<Reader> reader(new Reader(*ifs));
-  return reader->Read();
+  return f;
+}
+
+bool Reader::ParseFile(File *f) {
+  Reader reader(f);
+  return reader.Parse();
 }
 
 void Reader::DumpFile(File *f) {
@@ -88,35 +226,62 @@ void Reader::DumpExp(Exp *s) {
   cout << ")";
 }
 
-Reader::Reader(istream &ifs) : ifs_(ifs), column_(0), has_error_(false) {
+Reader::Reader(istream &ifs)
+  : ifs_(&ifs), file_(nullptr), cur_(nullptr), end_(nullptr),
+    has_error_(false) {
+}
+
+Reader::Reader(File *f)
+  : ifs_(nullptr), file_(f), cur_(nullptr), end_(nullptr),
+    has_error_(false) {
 }
 
 File *Reader::Read() {
-  File *f = new File;
-  string s = ReadToken();
-  while (!s.empty()) {
-    UnreadToken(s);
-    Exp *e = ReadExp();
-    if (HasError()) {
-      delete e;
-      for (Exp *cur : f->exps) {
-	delete cur;
-      }
-      f->exps.clear();
-      break;
-    } else {
-      f->exps.push_back(e);
-    }
-    s = ReadToken();
+  if (file_ == nullptr) {
+    file_ = new File;
+    file_->ReadStream(*ifs_);
   }
-  return f;
+  Parse();
+  return file_;
+}
+
+bool Reader::Parse() {
+  Exp *e;
+  while ((e = ReadToplevel()) != nullptr) {
+    file_->exps.push_back(e);
+  }
+  if (HasError()) {
+    file_->exps.clear();
+  }
+  return !HasError();
+}
+
+Exp *Reader::ReadToplevel() {
+  if (cur_ == nullptr) {
+    cur_ = file_->data;
+    end_ = file_->data + file_->data_size;
+  }
+  StringPiece s = ReadToken();
+  if (s.empty() || HasError()) {
+    return nullptr;
+  }
+  UnreadToken(s);
+  Exp *e = ReadExp();
+  if (HasError()) {
+    return nullptr;
+  }
+  return e;
+}
+
+void Reader::ReleaseToplevel() {
+  file_->ReleaseExps(cur_);
 }
 
 Exp *Reader::ReadExp() {
   if (HasError()) {
     return nullptr;
   }
-  string token = ReadToken();
+  StringPiece token = ReadToken();
   if (token.empty()) {
     SetError();
     return nullptr;
@@ -124,11 +289,11 @@ Exp *Reader::ReadExp() {
   if (token == "(") {
     return ReadList();
   }
-  Exp *s = new Exp;
-  const char *t = token.c_str();
+  Exp *s = file_->NewExp();
+  const char *t = token.data();
   int len = token.size();
   if (len >= 2 && t[0] == '"' && t[len - 1] == '"') {
-    s->atom.str = string(t + 1, len - 2);
+    s->atom.str = StringPiece(t + 1, len - 2);
   } else {
     s->atom.str = token;
   }
@@ -139,9 +304,10 @@ Exp *Reader::ReadList() {
   if (HasError()) {
     return nullptr;
   }
-  Exp *lst = new Exp;
+  Exp *lst = file_->NewExp();
+  size_t base = stack_.size();
   while (true) {
-    string token = ReadToken();
+    StringPiece token = ReadToken();
     if (token == ")") {
       break;
     }
@@ -150,86 +316,66 @@ Exp *Reader::ReadList() {
       break;
     }
     UnreadToken(token);
-    lst->vec.push_back(ReadExp());
+    stack_.push_back(ReadExp());
   }
-  return lst;
-}
-
-bool Reader::EnsureLine() {
- again:
-  if (column_ == cur_line_.size()) {
-    if (ifs_.eof()) {
-      return false;
-    }
-    std::getline(ifs_, cur_line_);
-    column_ = 0;
-    if (cur_line_.empty()) {
-      goto again;
-    }
+  int size = stack_.size() - base;
+  if (size > 0) {
+    file_->SetList(lst, &stack_[base], size);
   }
-  return true;
+  stack_.resize(base);
+  return lst;
 }
 
-string Reader::ReadToken() {
+StringPiece Reader::ReadToken() {
   if (!unread_token_.empty()) {
-    string tmp = unread_token_;
-    unread_token_.clear();
+    StringPiece tmp = unread_token_;
+    unread_token_ = StringPiece();
     return tmp;
   }
- again:
-  if (!EnsureLine()) {
-    return string();
-  }
-  // Skip spaces.
-  const char *c = CurrentChar();
-  while (*c > 0 && isspace(*c)) {
-    ++column_;
-    if (column_ == cur_line_.size()) {
-      goto again;
+  // Skip spaces and comments.
+  while (cur_ < end_) {
+    char c = *cur_;
+    if (c > 0 && isspace(c)) {
+      ++cur_;
+    } else if (c == ';') {
+      while (cur_ < end_ && *cur_ != '\n') {
+	++cur_;
+      }
+    } else {
+      break;
     }
-    c = CurrentChar();
   }
-  if (*c == ';') {
-    column_ = cur_line_.size();
-    goto again;
+  if (cur_ == end_) {
+    return StringPiece();
   }
   // Seek the end of token.
-  const char *start = c;
-  bool in_quote = (*start == '"');
-  int len = 0;
-  c = CurrentChar();
-  while (column_ < cur_line_.size()) {
-    if (in_quote) {
-      if (*c == '"' && len > 0) {
-	++column_;
-	++len;
+  const char *start = cur_;
+  if (*cur_ == '(' || *cur_ == ')') {
+    ++cur_;
+  } else if (*cur_ == '"') {
+    // Quoted string ends at the line end at last.
+    ++cur_;
+    while (cur_ < end_ && *cur_ != '\n') {
+      if (*cur_++ == '"') {
 	break;
       }
-    } else if (*c > 0 && isspace(*c)) {
-      break;
-    }
-    bool one_char = (*c == '(' || *c == ')');
-    if (one_char && !in_quote && len > 0) {
-      break;
     }
-    ++column_;
-    ++len;
-    if (one_char && len == 1) {
-      break;
+  } else {
+    while (cur_ < end_) {
+      char c = *cur_;
+      if ((c > 0 && isspace(c)) || c == '(' || c == ')') {
+	break;
+      }
+      ++cur_;
     }
-    c = CurrentChar();
   }
-  return string(start, len);
+  return StringPiece(start, cur_ - start);
 }
 
-void Reader::UnreadToken(string &t) {
+void Reader::UnreadToken(StringPiece t) {
   unread_token_ = t;
 }
 
-const char *Reader::CurrentChar() {
-  return cur_line_.c_str() + column_;
-}
-
 void Reader::SetError() {
   has_error_ = true;
 }
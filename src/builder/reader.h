@@ -7,52 +7,138 @@
 namespace iroha {
 namespace builder {
 
+class Exp;
+
+// Points to a range of characters in the source text of a File.
+// Not null terminated.
+class StringPiece {
+public:
+  StringPiece() : ptr_(nullptr), len_(0) {}
+  StringPiece(const char *ptr, int len) : ptr_(ptr), len_(len) {}
+
+  const char *data() const { return ptr_; }
+  int size() const { return len_; }
+  bool empty() const { return len_ == 0; }
+  string as_string() const { return string(ptr_, len_); }
+  operator string() const { return as_string(); }
+
+  bool operator==(const char *s) const;
+  bool operator==(const string &s) const;
+  bool operator!=(const char *s) const { return !(*this == s); }
+  bool operator!=(const string &s) const { return !(*this == s); }
+
+private:
+  const char *ptr_;
+  int len_;
+};
+
+ostream &operator<<(ostream &os, const StringPiece &s);
+
 class Atom {
 public:
-  string str;
+  StringPiece str;
+};
+
+// Child expressions of a list. The array is allocated in the Arena.
+class ExpList {
+public:
+  ExpList() : exps_(nullptr), size_(0) {}
+
+  Exp *operator[](int nth) const { return exps_[nth]; }
+  int size() const { return size_; }
+  Exp **begin() const { return exps_; }
+  Exp **end() const { return exps_ + size_; }
+
+  Exp **exps_;
+  int size_;
 };
 
+// Exp is allocated in the Arena of the File and never deleted individually.
 class Exp {
 public:
-  ~Exp();
-  const string &GetHead();
-  const string &Str(int nth);
+  StringPiece GetHead();
+  StringPiece Str(int nth);
   int Size();
 
   Atom atom;
-  vector<Exp *> vec;
+  ExpList vec;
+};
+
+// Bump allocator. All the memory is released when it is destructed.
+class Arena {
+public:
+  Arena();
+  ~Arena();
+
+  void *Alloc(size_t size);
+  // Releases everything allocated so far, but keeps the first block.
+  void Reset();
+
+private:
+  vector<char *> blocks_;
+  size_t first_block_size_;
+  char *cur_;
+  size_t remaining_;
 };
 
 class File {
 public:
+  File();
   ~File();
+
+  // Maps the file to the memory, or reads the entire stream to a buffer.
+  bool MapFile(const string &fn);
+  bool ReadStream(istream &is);
+  Exp *NewExp();
+  void SetList(Exp *e, Exp **exps, int size);
+  // Frees Exps and tells the OS that the text before pos won't be used.
+  void ReleaseExps(const char *pos);
+
   vector<Exp *> exps;
+  Arena arena;
+  const char *data;
+  size_t data_size;
+
+private:
+  bool mapped_;
+  string buf_;
 };
 
 class Reader {
 public:
   Reader(istream &ifs);
+  Reader(File *f);
 
   File *Read();
+  // Reads one toplevel expression and returns it without storing to the
+  // File. Returns nullptr at the end or an error.
+  Exp *ReadToplevel();
+  // Frees the expressions returned so far.
+  void ReleaseToplevel();
+  bool HasError();
 
   static File *ReadFile(const string &fn, bool search);
+  // Loads the content of the file without parsing.
+  static File *LoadFile(const string &fn, bool search);
+  static bool ParseFile(File *f);
   static void DumpFile(File *s);
   static void DumpExp(Exp *e);
 
 private:
+  bool Parse();
   Exp *ReadExp();
   Exp *ReadList();
-  bool EnsureLine();
-  string ReadToken();
-  void UnreadToken(string &t);
-  const char *CurrentChar();
+  StringPiece ReadToken();
+  void UnreadToken(StringPiece t);
   void SetError();
-  bool HasError();
-  
-  istream &ifs_;
-  string unread_token_;
-  string cur_line_;
-  int column_;
+
+  istream *ifs_;
+  File *file_;
+  const char *cur_;
+  const char *end_;
+  StringPiece unread_token_;
+  // Children of lists being read.
+  vector<Exp *> stack_;
   bool has_error_;
 };
 
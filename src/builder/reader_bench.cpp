@@ -0,0 +1,132 @@
+// Measures the time to load a large synthetic design.
+//
+// reader_bench [number of modules] [number of states per table]
+#include "builder/design_builder.h"
+#include "builder/reader.h"
+#include "iroha/i_design.h"
+
+#include <chrono>
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+void WriteTable(int num_states, ostream &os) {
+  os << " (TABLE 1 ()\n"
+     << "  (REGISTERS\n";
+  for (int i = 1; i <= num_states; ++i) {
+    os << "   (REGISTER " << i << " r_" << i << "\n"
+       << "    REG (UINT 32) ())\n";
+  }
+  os << "   (REGISTER " << (num_states + 1) << " ()\n"
+     << "    CONST (UINT 32) 1)\n"
+     << "  )\n"
+     << "  (RESOURCES\n"
+     << "   (RESOURCE 1 tr\n"
+     << "    () ()\n"
+     << "    (PARAMS))\n"
+     << "   (RESOURCE 2 add\n"
+     << "    ((UINT 32) (UINT 32)) ((UINT 32))\n"
+     << "    (PARAMS))\n"
+     << "  )\n"
+     << "  (INITIAL 1)\n";
+  int insn_id = 1;
+  for (int i = 1; i <= num_states; ++i) {
+    int src = (i == 1) ? num_states : (i - 1);
+    int next = (i == num_states) ? 1 : (i + 1);
+    os << "  (STATE " << i << "\n"
+       << "   (INSN " << insn_id << " add 2 () () (" << src << " "
+       << (num_states + 1) << ") (" << i << ") ())\n"
+       << "   (INSN " << (insn_id + 1) << " tr 1 () (" << next
+       << ") () () ())\n"
+       << "  )\n";
+    insn_id += 2;
+  }
+  os << " )\n";
+}
+
+void WriteDesign(int num_modules, int num_states, ostream &os) {
+  os << "(PARAMS )\n";
+  for (int m = 1; m <= num_modules; ++m) {
+    os << "(MODULE " << m << " mod_" << m << "\n"
+       << " (PARAMS )\n";
+    if (m > 1) {
+      os << " (PARENT 1)\n";
+    }
+    WriteTable(num_states, os);
+    os << ")\n";
+  }
+}
+
+double Elapsed(chrono::steady_clock::time_point start) {
+  auto d = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::duration<double> >(d).count();
+}
+
+long MaxRssKB() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_modules = 100;
+  int num_states = 10000;
+  if (argc > 1) {
+    num_modules = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_states = atoi(argv[2]);
+  }
+  char fn[] = "/tmp/reader_bench_XXXXXX";
+  int fd = mkstemp(fn);
+  if (fd < 0) {
+    cerr << "Failed to create a temporary file\n";
+    return 1;
+  }
+  close(fd);
+  {
+    ofstream os(fn);
+    WriteDesign(num_modules, num_states, os);
+  }
+  ifstream is(fn, ifstream::ate | ifstream::binary);
+  cout << "modules=" << num_modules << " states/table=" << num_states
+       << " bytes=" << is.tellg() << "\n";
+
+  // Streaming build first, since the max RSS never decreases.
+  auto start = chrono::steady_clock::now();
+  IDesign *design = builder::DesignBuilder::ReadDesign(fn, false);
+  cout << "stream read+build: " << Elapsed(start) << "s"
+       << " maxrss=" << MaxRssKB() << "KB\n";
+  delete design;
+
+  start = chrono::steady_clock::now();
+  builder::File *f = builder::Reader::ReadFile(fn, false);
+  cout << "read: " << Elapsed(start) << "s\n";
+
+  start = chrono::steady_clock::now();
+  builder::DesignBuilder builder;
+  design = builder.Build(f->exps);
+  cout << "build: " << Elapsed(start) << "s"
+       << " maxrss=" << MaxRssKB() << "KB\n";
+
+  start = chrono::steady_clock::now();
+  delete f;
+  cout << "free exps: " << Elapsed(start) << "s\n";
+
+  unlink(fn);
+  if (design == nullptr) {
+    cerr << "Failed to build the design\n";
+    return 1;
+  }
+  delete design;
+  return 0;
+}
@@ -2,6 +2,7 @@
 
 #include "builder/design_builder.h"
 #include "builder/reader.h"
+#include "design/design_util.h"
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
 
@@ -52,12 +53,7 @@ bool TreeBuilder::Resolve() {
     }
     IResource *res = p.first;
     int table_id = table_ids_[res];
-    ITable *callee_tab = nullptr;
-    for (ITable *t : mod->tables_) {
-      if (t->GetId() == table_id) {
-	callee_tab = t;
-      }
-    }
+    ITable *callee_tab = DesignUtil::FindTableById(mod, table_id);
     CHECK(callee_tab != nullptr);
     res->SetCalleeTable(callee_tab);
   }
@@ -95,16 +91,11 @@ bool TreeBuilder::Resolve() {
 
 IResource *TreeBuilder::FindResource(IModule *mod,
 				     int table_id, int resource_id) {
-  for (ITable *tab : mod->tables_) {
-    if (tab->GetId() == table_id) {
-      for (IResource *res : tab->resources_) {
-	if (res->GetId() == resource_id) {
-	  return res;
-	}
-      }
-    }
+  ITable *tab = DesignUtil::FindTableById(mod, table_id);
+  if (tab == nullptr) {
+    return nullptr;
   }
-  return nullptr;
+  return DesignUtil::FindResourceById(tab, resource_id);
 }
 
 }  // namespace builder
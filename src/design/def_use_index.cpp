@@ -0,0 +1,176 @@
+#include "design/def_use_index.h"
+
+#include "iroha/i_design.h"
+
+#include <algorithm>
+
+namespace iroha {
+
+namespace {
+
+template<class K>
+const vector<IInsn *> &GetList(const unordered_map<K, vector<IInsn *> > &m,
+			       K key) {
+  static const vector<IInsn *> empty;
+  auto it = m.find(key);
+  if (it == m.end()) {
+    return empty;
+  }
+  return it->second;
+}
+
+// Adds insn for each distinct register in regs.
+template<class K>
+void AddToLists(const vector<IRegister *> &regs, IInsn *insn,
+		unordered_map<K, vector<IInsn *> > *m) {
+  for (int i = 0; i < regs.size(); ++i) {
+    IRegister *reg = regs[i];
+    if (find(regs.begin(), regs.begin() + i, reg) != regs.begin() + i) {
+      continue;
+    }
+    (*m)[reg].push_back(insn);
+  }
+}
+
+template<class K>
+void RemoveFromList(K key, IInsn *insn,
+		    unordered_map<K, vector<IInsn *> > *m) {
+  auto it = m->find(key);
+  if (it == m->end()) {
+    return;
+  }
+  vector<IInsn *> &insns = it->second;
+  auto pos = find(insns.begin(), insns.end(), insn);
+  if (pos != insns.end()) {
+    insns.erase(pos);
+  }
+  if (insns.empty()) {
+    m->erase(it);
+  }
+}
+
+}  // namespace
+
+DefUseIndex::DefUseIndex(ITable *table) : table_(table) {
+}
+
+DefUseIndex *DefUseIndex::Create(ITable *table) {
+  DefUseIndex *index = new DefUseIndex(table);
+  index->Build();
+  table->SetDefUseIndex(index);
+  return index;
+}
+
+DefUseIndex *DefUseIndex::Get(const ITable *table) {
+  return table->GetDefUseIndex();
+}
+
+DefUseIndex *DefUseIndex::GetOrCreate(ITable *table) {
+  DefUseIndex *index = table->GetDefUseIndex();
+  if (index == nullptr) {
+    index = Create(table);
+  }
+  return index;
+}
+
+void DefUseIndex::Drop(ITable *table) {
+  table->SetDefUseIndex(nullptr);
+}
+
+void DefUseIndex::DropAll(IDesign *design) {
+  for (IModule *mod : design->modules_) {
+    for (ITable *tab : mod->tables_) {
+      Drop(tab);
+    }
+  }
+}
+
+void DefUseIndex::Build() {
+  for (IState *st : table_->states_) {
+    for (IInsn *insn : st->insns_) {
+      AddInsn(st, insn);
+    }
+  }
+}
+
+const vector<IInsn *> &DefUseIndex::GetDefs(const IRegister *reg) const {
+  return GetList(defs_, reg);
+}
+
+const vector<IInsn *> &DefUseIndex::GetUses(const IRegister *reg) const {
+  return GetList(uses_, reg);
+}
+
+const vector<IInsn *> &
+DefUseIndex::GetInsnsByResource(const IResource *res) const {
+  return GetList(resource_insns_, res);
+}
+
+IState *DefUseIndex::GetState(const IInsn *insn) const {
+  auto it = insns_.find(insn);
+  if (it == insns_.end()) {
+    return nullptr;
+  }
+  return it->second.st;
+}
+
+void DefUseIndex::AddInsn(IState *st, IInsn *insn) {
+  if (insns_.find(insn) != insns_.end()) {
+    RemoveInsn(insn);
+  }
+  InsnEntry &e = insns_[insn];
+  e.st = st;
+  AddOperands(insn);
+}
+
+void DefUseIndex::RemoveInsn(IInsn *insn) {
+  auto it = insns_.find(insn);
+  if (it == insns_.end()) {
+    return;
+  }
+  RemoveOperands(insn);
+  insns_.erase(it);
+}
+
+void DefUseIndex::MoveInsn(IInsn *insn, IState *dst_st) {
+  auto it = insns_.find(insn);
+  if (it == insns_.end()) {
+    AddInsn(dst_st, insn);
+    return;
+  }
+  it->second.st = dst_st;
+}
+
+void DefUseIndex::UpdateInsn(IInsn *insn) {
+  auto it = insns_.find(insn);
+  if (it == insns_.end()) {
+    return;
+  }
+  RemoveOperands(insn);
+  AddOperands(insn);
+}
+
+void DefUseIndex::AddOperands(IInsn *insn) {
+  InsnEntry &e = insns_[insn];
+  e.res = insn->GetResource();
+  e.inputs = insn->inputs_;
+  e.outputs = insn->outputs_;
+  resource_insns_[e.res].push_back(insn);
+  AddToLists(e.inputs, insn, &uses_);
+  AddToLists(e.outputs, insn, &defs_);
+}
+
+void DefUseIndex::RemoveOperands(IInsn *insn) {
+  InsnEntry &e = insns_[insn];
+  RemoveFromList<const IResource *>(e.res, insn, &resource_insns_);
+  for (IRegister *reg : e.inputs) {
+    RemoveFromList<const IRegister *>(reg, insn, &uses_);
+  }
+  for (IRegister *reg : e.outputs) {
+    RemoveFromList<const IRegister *>(reg, insn, &defs_);
+  }
+  e.inputs.clear();
+  e.outputs.clear();
+}
+
+}  // namespace iroha
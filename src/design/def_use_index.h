@@ -0,0 +1,69 @@
+// -*- C++ -*-
+//
+// Optional index of a table to find insns defining and using each
+// register, and insns of each resource without scanning all states.
+//
+// The index is attached to an ITable by Create() and kept up to date by
+// DesignTool (EraseInsn, DeleteInsn, MoveInsn, InsertNextState) and
+// DesignUtil::GetTransitionInsn. Code modifying insns or states directly
+// has to call AddInsn(), RemoveInsn() or UpdateInsn(), or Drop() the index.
+// Optimizer drops indexes after each phase.
+//
+#ifndef _design_def_use_index_h_
+#define _design_def_use_index_h_
+
+#include "iroha/common.h"
+
+#include <unordered_map>
+
+namespace iroha {
+
+class DefUseIndex {
+public:
+  DefUseIndex(ITable *table);
+
+  // Builds the index and attaches it to the table.
+  static DefUseIndex *Create(ITable *table);
+  // Returns the index attached to the table or nullptr.
+  static DefUseIndex *Get(const ITable *table);
+  // Returns the attached index or creates one.
+  static DefUseIndex *GetOrCreate(ITable *table);
+  static void Drop(ITable *table);
+  static void DropAll(IDesign *design);
+
+  // Each insn appears once even if it has the register multiple times.
+  const vector<IInsn *> &GetDefs(const IRegister *reg) const;
+  const vector<IInsn *> &GetUses(const IRegister *reg) const;
+  const vector<IInsn *> &GetInsnsByResource(const IResource *res) const;
+  // nullptr if the insn is not in the table.
+  IState *GetState(const IInsn *insn) const;
+
+  void AddInsn(IState *st, IInsn *insn);
+  void RemoveInsn(IInsn *insn);
+  void MoveInsn(IInsn *insn, IState *dst_st);
+  // Call after inputs_, outputs_ or the resource of insn are modified.
+  void UpdateInsn(IInsn *insn);
+
+private:
+  void Build();
+  void AddOperands(IInsn *insn);
+  void RemoveOperands(IInsn *insn);
+
+  // Operands when the insn was added to be able to remove it later.
+  struct InsnEntry {
+    IState *st;
+    IResource *res;
+    vector<IRegister *> inputs;
+    vector<IRegister *> outputs;
+  };
+
+  ITable *table_;
+  unordered_map<const IInsn *, InsnEntry> insns_;
+  unordered_map<const IRegister *, vector<IInsn *> > defs_;
+  unordered_map<const IRegister *, vector<IInsn *> > uses_;
+  unordered_map<const IResource *, vector<IInsn *> > resource_insns_;
+};
+
+}  // namespace iroha
+
+#endif  // _design_def_use_index_h_
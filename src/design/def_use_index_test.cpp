@@ -0,0 +1,79 @@
+// Checks that DefUseIndex follows DesignTool modifications.
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "iroha/test_util.h"
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+IInsn *AddInsn(IState *st, IResource *res, IRegister *in0, IRegister *in1,
+	       IRegister *out) {
+  IInsn *insn = new IInsn(res);
+  insn->inputs_.push_back(in0);
+  insn->inputs_.push_back(in1);
+  insn->outputs_.push_back(out);
+  st->insns_.push_back(insn);
+  return insn;
+}
+
+}  // namespace
+
+void Basic() {
+  TEST_CASE("Basic");
+  IDesign design;
+  IModule *mod = new IModule(&design, "m");
+  design.modules_.push_back(mod);
+  ITable *tab = new ITable(mod);
+  mod->tables_.push_back(tab);
+  IState *st1 = new IState(tab);
+  IState *st2 = new IState(tab);
+  tab->states_.push_back(st1);
+  tab->states_.push_back(st2);
+  IResource *add = DesignTool::GetBinOpResource(tab, resource::kAdd, 32);
+  IRegister *a = DesignTool::AllocRegister(tab, "a", 32);
+  IRegister *b = DesignTool::AllocRegister(tab, "b", 32);
+  IRegister *c = DesignTool::AllocRegister(tab, "c", 32);
+  IInsn *i1 = AddInsn(st1, add, a, a, b);
+  IInsn *i2 = AddInsn(st2, add, b, a, c);
+
+  DefUseIndex *index = DefUseIndex::Create(tab);
+  ASSERT(DefUseIndex::Get(tab) == index);
+  ASSERT_EQ(2, index->GetUses(a).size());
+  ASSERT_EQ(1, index->GetDefs(b).size());
+  ASSERT(index->GetDefs(b)[0] == i1);
+  ASSERT(index->GetUses(b)[0] == i2);
+  ASSERT_EQ(0, index->GetDefs(a).size());
+  ASSERT_EQ(2, DesignUtil::GetInsnsByResource(add).size());
+  ASSERT(index->GetState(i2) == st2);
+
+  DesignTool::MoveInsn(i2, st2, st1);
+  ASSERT(index->GetState(i2) == st1);
+
+  i2->inputs_[0] = c;
+  index->UpdateInsn(i2);
+  ASSERT_EQ(0, index->GetUses(b).size());
+  ASSERT(index->GetUses(c)[0] == i2);
+
+  DesignTool::EraseInsn(st1, i1);
+  ASSERT_EQ(1, index->GetUses(a).size());
+  ASSERT_EQ(0, index->GetDefs(b).size());
+  ASSERT(index->GetState(i1) == nullptr);
+
+  IInsn *tr = DesignUtil::GetTransitionInsn(st2);
+  ASSERT(index->GetState(tr) == st2);
+  ASSERT_EQ(1, DesignUtil::GetInsnsByResource(add).size());
+
+  DefUseIndex::Drop(tab);
+  ASSERT(DefUseIndex::Get(tab) == nullptr);
+}
+
+int main(int argc, char **argv) {
+  Basic();
+
+  return 0;
+}
@@ -2,6 +2,7 @@
 
 #include <set>
 
+#include "design/def_use_index.h"
 #include "design/design_util.h"
 #include "design/validator.h"
 #include "iroha/insn_operands.h"
@@ -48,6 +49,10 @@ void DesignTool::EraseInsn(IState *st, IInsn *insn) {
   for (auto it = st->insns_.begin(); it != st->insns_.end(); ++it) {
     if (*it == insn) {
       st->insns_.erase(it);
+      DefUseIndex *index = DefUseIndex::Get(st->GetTable());
+      if (index != nullptr) {
+	index->RemoveInsn(insn);
+      }
       return;
     }
   }
@@ -65,6 +70,7 @@ IResource *DesignTool::GetOneResource(ITable *table, const string &class_name) {
   }
   res = new IResource(table, rc);
   table->resources_.push_back(res);
+  table->resource_index_.Add(table->resources_, res);
   return res;
 }
 
@@ -77,10 +83,17 @@ IResource *DesignTool::GetBinOpResource(ITable *table,
       return res;
     }
   }
+  return CreateBinOpResource(table, class_name, width);
+}
+
+IResource *DesignTool::CreateBinOpResource(ITable *table,
+					   const string &class_name,
+					   int width) {
   IDesign *design = table->GetModule()->GetDesign();
   IResourceClass *rc = DesignUtil::FindResourceClass(design, class_name);
   IResource *res = new IResource(table, rc);
   table->resources_.push_back(res);
+  table->resource_index_.Add(table->resources_, res);
 
   IValueType t;
   t.SetWidth(width);
@@ -203,6 +216,7 @@ IResource *DesignTool::CopySimpleResource(IResource *res) {
   ResourceParams *params = res->GetParams();
   new_res->GetParams()->Merge(params);
   tab->resources_.push_back(new_res);
+  tab->resource_index_.Add(tab->resources_, new_res);
   return new_res;
 }
 
@@ -211,6 +225,7 @@ IRegister *DesignTool::AllocRegister(ITable *table, const string &name,
   IRegister *reg = new IRegister(table, name);
   reg->value_type_.SetWidth(width);
   table->registers_.push_back(reg);
+  table->register_index_.Add(table->registers_, reg);
   return reg;
 }
 
@@ -220,18 +235,31 @@ IRegister *DesignTool::AllocConstNum(ITable *table,
   Numeric v;
   v.SetValue0(value);
   v.type_.SetWidth(width);
+  Numeric::MayExpandStorage(nullptr, &v);
 
   reg->SetInitialValue(v);
   reg->SetConst(true);
   table->registers_.push_back(reg);
+  table->register_index_.Add(table->registers_, reg);
+  return reg;
+}
+
+IRegister *DesignTool::AllocConstNum(ITable *table, const Numeric &value) {
+  IRegister *reg = new IRegister(table, "");
+  Numeric v = value;
+  reg->SetInitialValue(v);
+  reg->SetConst(true);
+  table->registers_.push_back(reg);
+  table->register_index_.Add(table->registers_, reg);
   return reg;
 }
 
 void DesignTool::SetRegisterInitialValue(uint64_t value,
 					 IRegister *reg) {
   Numeric v;
-  v.type_ = reg->value_type_;
   v.SetValue0(value);
+  v.type_ = reg->value_type_;
+  Numeric::MayExpandStorage(nullptr, &v);
   reg->SetInitialValue(v);
 }
 
@@ -263,6 +291,10 @@ void DesignTool::DeleteInsn(IState *st, IInsn *insn) {
     return;
   }
   st->insns_.erase(it);
+  DefUseIndex *index = DefUseIndex::Get(st->GetTable());
+  if (index != nullptr) {
+    index->RemoveInsn(insn);
+  }
 }
 
 void DesignTool::MoveInsn(IInsn *insn, IState *src_st, IState *dst_st) {
@@ -276,6 +308,10 @@ void DesignTool::MoveInsn(IInsn *insn, IState *src_st, IState *dst_st) {
     }
     ++nth;
   }
+  DefUseIndex *index = DefUseIndex::Get(dst_st->GetTable());
+  if (index != nullptr) {
+    index->MoveInsn(insn, dst_st);
+  }
 }
 
 }  // namespace iroha
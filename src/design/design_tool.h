@@ -22,6 +22,10 @@ public:
   static IResource *GetBinOpResource(ITable *table,
 				     const string &class_name,
 				     int width);
+  // Always allocates a new one unlike GetBinOpResource().
+  static IResource *CreateBinOpResource(ITable *table,
+					const string &class_name,
+					int width);
   static IResource *CreateShifterResource(ITable *table);
   static IResource *CreateArrayResource(ITable *table,
 					int addres_width,
@@ -54,6 +58,8 @@ public:
 				  int width);
   static IRegister *AllocConstNum(ITable *table,
 				  int width, uint64_t value);
+  // value can be wider than 64 bits. Its storage is taken over.
+  static IRegister *AllocConstNum(ITable *table, const Numeric &value);
   static void SetRegisterInitialValue(uint64_t value,
 				      IRegister *reg);
   static IInsn *CreateShiftInsn(IRegister *reg, bool to_left,
@@ -1,5 +1,6 @@
 #include "design/design_util.h"
 
+#include "design/def_use_index.h"
 #include "iroha/i_design.h"
 #include "iroha/resource_class.h"
 #include "iroha/logging.h"
@@ -116,6 +117,10 @@ IInsn *DesignUtil::GetTransitionInsn(IState *st) {
 							   resource::kTransition);
     insn = new IInsn(tr);
     st->insns_.push_back(insn);
+    DefUseIndex *index = DefUseIndex::Get(table);
+    if (index != nullptr) {
+      index->AddInsn(st, insn);
+    }
   }
   return insn;
 }
@@ -143,6 +148,10 @@ IInsn *DesignUtil::FindDataFlowInInsn(ITable *table) {
 
 vector<IInsn *> DesignUtil::GetInsnsByResource(const IResource *res) {
   ITable *tab = res->GetTable();
+  DefUseIndex *index = DefUseIndex::Get(tab);
+  if (index != nullptr) {
+    return index->GetInsnsByResource(res);
+  }
   vector<IInsn *> insns;
   for (IState *st : tab->states_) {
     for (IInsn *insn : st->insns_) {
@@ -169,30 +178,15 @@ bool DesignUtil::IsTerminalState(IState *st) {
 
 IResource *DesignUtil::FindResourceById(ITable *tab,
 					int res_id) {
-  for (IResource *res : tab->resources_) {
-    if (res->GetId() == res_id) {
-      return res;
-    }
-  }
-  return nullptr;
+  return tab->resource_index_.Find(tab->resources_, res_id);
 }
 
 ITable *DesignUtil::FindTableById(IModule *mod, int tab_id) {
-  for (ITable *tab : mod->tables_) {
-    if (tab->GetId() == tab_id) {
-      return tab;
-    }
-  }
-  return nullptr;
+  return mod->table_index_.Find(mod->tables_, tab_id);
 }
 
 IRegister *DesignUtil::FindRegisterById(ITable *tab, int reg_id) {
-  for (IRegister *reg : tab->registers_) {
-    if (reg->GetId() == reg_id) {
-      return reg;
-    }
-  }
-  return nullptr;
+  return tab->register_index_.Find(tab->registers_, reg_id);
 }
 
 }  // namespace iroha
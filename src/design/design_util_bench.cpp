@@ -0,0 +1,94 @@
+// Measures DesignUtil::FindRegisterById on large tables.
+//
+// design_util_bench [max number of registers]
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "design/validator.h"
+#include "iroha/i_design.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+double Elapsed(chrono::steady_clock::time_point start) {
+  auto d = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::duration<double> >(d).count();
+}
+
+// Old implementation for comparison.
+IRegister *ScanRegister(ITable *tab, int reg_id) {
+  for (IRegister *reg : tab->registers_) {
+    if (reg->GetId() == reg_id) {
+      return reg;
+    }
+  }
+  return nullptr;
+}
+
+void Run(int num_regs) {
+  IDesign design;
+  IModule *mod = new IModule(&design, "m");
+  design.modules_.push_back(mod);
+  ITable *tab = new ITable(mod);
+  mod->tables_.push_back(tab);
+  for (int i = 0; i < num_regs; ++i) {
+    DesignTool::AllocRegister(tab, "", 32);
+  }
+  Validator::Validate(&design);
+  vector<int> ids;
+  for (int i = 1; i <= num_regs; ++i) {
+    ids.push_back(i);
+  }
+  mt19937 rng(1);
+  shuffle(ids.begin(), ids.end(), rng);
+
+  auto start = chrono::steady_clock::now();
+  long found = 0;
+  for (int id : ids) {
+    found += (DesignUtil::FindRegisterById(tab, id) != nullptr);
+  }
+  double index_time = Elapsed(start);
+
+  // Scans only some of them, since it is quadratic in total.
+  int num_scans = min(num_regs, 2000);
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < num_scans; ++i) {
+    found += (ScanRegister(tab, ids[i]) != nullptr);
+  }
+  double scan_time = Elapsed(start) / num_scans * num_regs;
+
+  // Allocates a register and looks it up in turn like a phase does.
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < 1000; ++i) {
+    IRegister *reg = DesignTool::AllocRegister(tab, "", 32);
+    reg->SetId(num_regs + i + 1);
+    found += (DesignUtil::FindRegisterById(tab, reg->GetId()) == reg);
+    found += (DesignUtil::FindRegisterById(tab, ids[i]) != nullptr);
+  }
+  double mixed_time = Elapsed(start);
+
+  cout << "regs=" << num_regs
+       << " lookup all: index " << index_time << "s"
+       << ", scan (estimated) " << scan_time << "s"
+       << "; 1000 alloc+lookup: " << mixed_time << "s"
+       << " (" << found << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int max_regs = 100000;
+  if (argc > 1) {
+    max_regs = atoi(argv[1]);
+  }
+  for (int n = 1000; n <= max_regs; n *= 10) {
+    Run(n);
+  }
+  return 0;
+}
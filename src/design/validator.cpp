@@ -40,12 +40,28 @@ void Validator::Validate(IDesign *design) {
     ValidateTableId(mod);
     for (auto *tab : mod->tables_) {
       ValidateTable(tab);
+      tab->SetNeedsValidation(false);
     }
     // Validate reg names after ids.
     ValidateRegName(mod);
   }
 }
 
+void Validator::ValidateModified(IDesign *design, set<IModule *> *modules) {
+  ValidateModuleId(design);
+  ValidateArrayImageId(design);
+  for (auto *mod : design->modules_) {
+    ValidateTableId(mod);
+    for (auto *tab : mod->tables_) {
+      if (tab->NeedsValidation()) {
+	ValidateTable(tab);
+	tab->SetNeedsValidation(false);
+	modules->insert(mod);
+      }
+    }
+  }
+}
+
 void Validator::ValidateTable(ITable *table) {
   ValidateStateId(table);
   ValidateInsnId(table);
@@ -67,6 +83,7 @@ void Validator::ValidateStateId(ITable *table) {
 
 void Validator::ValidateTableId(IModule *mod) {
   ValidateVectorId(mod->tables_);
+  mod->table_index_.Build(mod->tables_);
 }
 
 void Validator::ValidateInsnId(ITable *table) {
@@ -83,27 +100,36 @@ void Validator::ValidateInsnId(ITable *table) {
 
 void Validator::ValidateResourceId(ITable *table) {
   ValidateVectorId(table->resources_);
+  table->resource_index_.Build(table->resources_);
 }
 
 void Validator::ValidateRegisterId(ITable *table) {
   ValidateVectorId(table->registers_);
+  table->register_index_.Build(table->registers_);
 }
 
 void Validator::ValidateRegName(IModule *mod) {
   set<string> names;
+  // Last suffix number used for each base name in GetUniqueName().
+  map<string, int> suffixes;
   for (auto *tab : mod->tables_) {
     for (auto *reg : tab->registers_) {
       string name = reg->GetName();
       if (name.empty() || names.find(name) != names.end()) {
-	name = GetUniqueName(names, reg);
+	name = GetUniqueName(names, &suffixes, reg);
+	// Renaming here doesn't require another validation.
+	bool needs = tab->NeedsValidation();
 	reg->SetName(name);
+	tab->SetNeedsValidation(needs);
       }
       names.insert(name);
     }
   }
 }
 
-string Validator::GetUniqueName(set<string> &names, IRegister *reg) {
+string Validator::GetUniqueName(set<string> &names,
+				 map<string, int> *suffixes,
+				 IRegister *reg) {
   string name = reg->GetName();
   if (name.empty()) {
     name = "anon";
@@ -112,8 +138,9 @@ string Validator::GetUniqueName(set<string> &names, IRegister *reg) {
   if (names.find(r) == names.end()) {
     return r;
   }
+  // names only grows, so smaller numbers than the last one are still used.
+  int &n = (*suffixes)[r];
   string s;
-  int n = 0;
   do {
     ++n;
     s = r + "_" + Util::Itoa(n);
@@ -4,6 +4,7 @@
 
 #include "iroha/common.h"
 
+#include <map>
 #include <set>
 
 namespace iroha {
@@ -11,6 +12,11 @@ namespace iroha {
 class Validator {
 public:
   static void Validate(IDesign *design);
+  // Validates ids of tables marked by ITable::SetNeedsValidation() and
+  // adds their modules to modules. Register names of the modules have to
+  // be validated by ValidateRegName() after this. The result is same as
+  // Validate() as long as modifications are marked.
+  static void ValidateModified(IDesign *design, set<IModule *> *modules);
   static void ValidateTable(ITable *table);
   static void ValidateRegName(IModule *mod);
 
@@ -23,7 +29,9 @@ private:
   static void ValidateRegisterId(ITable *table);
   static void ValidateResourceId(ITable *table);
 
-  static string GetUniqueName(set<string> &names, IRegister *reg);
+  static string GetUniqueName(set<string> &names,
+			      map<string, int> *suffixes,
+			      IRegister *reg);
 };
 
 }  // namespace iroha
@@ -4,7 +4,8 @@
   'make_global_settings': [
   ],
   'target_defaults': {
-    'cflags': ['-fPIC', '-Wall', '-Wno-sign-compare'],
+    'cflags': ['-fPIC', '-Wall', '-Wno-sign-compare', '-pthread'],
+    'ldflags': ['-pthread'],
     'defines': ['PACKAGE="iroha"', 'VERSION="0.0.1"'],
     'xcode_settings': {
       'OTHER_CFLAGS': [
@@ -40,6 +41,132 @@
         ':numeric'
       ],
     },
+    {
+      'target_name': 'reader_bench',
+      'product_name': 'reader_bench',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'builder/reader_bench.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'object_pool_bench',
+      'product_name': 'object_pool_bench',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'iroha/object_pool_bench.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'design_util_bench',
+      'product_name': 'design_util_bench',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'design/design_util_bench.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'numeric_manager_bench',
+      'product_name': 'numeric_manager_bench',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'numeric/numeric_manager_bench.cpp',
+      ],
+      'dependencies': [
+        ':numeric'
+      ],
+    },
+    {
+      'target_name': 'data_flow_bench',
+      'product_name': 'data_flow_bench',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'opt/data_flow_bench.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'def_use_index_test',
+      'product_name': 'def_use_index_test',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'design/def_use_index_test.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'sccp_test',
+      'product_name': 'sccp_test',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'opt/constant/sccp_test.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'gvn_test',
+      'product_name': 'gvn_test',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'opt/gvn/gvn_test.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
+    {
+      'target_name': 'binary_writer_test',
+      'product_name': 'binary_writer_test',
+      'type': 'executable',
+      'include_dirs': [
+        './',
+      ],
+      'sources': [
+        'writer/binary_writer_test.cpp',
+      ],
+      'dependencies': [
+        ':libiroha'
+      ],
+    },
     {
       'target_name': 'libiroha',
       'product_name': 'iroha',
@@ -48,6 +175,8 @@
         './',
       ],
       'sources': [
+        'builder/binary_builder.cpp',
+        'builder/binary_builder.h',
         'builder/design_builder.cpp',
         'builder/design_builder.h',
         'builder/fsm_builder.cpp',
@@ -58,12 +187,15 @@
         'builder/platform_builder.h',
         'builder/tree_builder.cpp',
         'builder/tree_builder.h',
+        'design/def_use_index.cpp',
+        'design/def_use_index.h',
         'design/design_tool.cpp',
         'design/design_tool.h',
         'design/design_util.cpp',
         'design/design_util.h',
         'design/validator.cpp',
         'design/validator.h',
+        'iroha/binary_format.h',
         'iroha/common.h',
         'iroha/dot/dot.cpp',
         'iroha/dot/dot.h',
@@ -71,6 +203,7 @@
         'iroha/i_design.h',
         'iroha/i_platform.cpp',
         'iroha/i_platform.h',
+        'iroha/id_index.h',
         'iroha/insn_operands.h',
         'iroha/iroha.cpp',
         'iroha/iroha.h',
@@ -90,6 +223,8 @@
         'iroha/stl_util.h',
 	'iroha/test_util.h',
         'iroha/writer_api.h',
+        'opt/analysis_manager.cpp',
+        'opt/analysis_manager.h',
         'opt/array_elimination.cpp',
         'opt/array_elimination.h',
         'opt/array_split_rdata.cpp',
@@ -98,6 +233,7 @@
         'opt/bb_collector.h',
         'opt/bb_set.cpp',
         'opt/bb_set.h',
+        'opt/bit_vector.h',
         'opt/clean/empty_state.cpp',
         'opt/clean/empty_state.h',
         'opt/clean/empty_table.cpp',
@@ -110,8 +246,14 @@
         'opt/clean/unused_register.h',
         'opt/clean/unused_resource.cpp',
         'opt/clean/unused_resource.h',
+        'opt/constant/constant_folder.cpp',
+        'opt/constant/constant_folder.h',
         'opt/constant/constant_propagation.cpp',
         'opt/constant/constant_propagation.h',
+        'opt/constant/sccp.cpp',
+        'opt/constant/sccp.h',
+        'opt/constant/sccp_phase.cpp',
+        'opt/constant/sccp_phase.h',
         'opt/common.h',
         'opt/compound.cpp',
         'opt/compound.h',
@@ -127,14 +269,33 @@
         'opt/dominator_tree_builder.h',
         'opt/dominator_tree.cpp',
         'opt/dominator_tree.h',
+        'opt/gvn/gvn.cpp',
+        'opt/gvn/gvn.h',
+        'opt/gvn/gvn_phase.cpp',
+        'opt/gvn/gvn_phase.h',
+        'opt/ifconv/if_conversion.cpp',
+        'opt/ifconv/if_conversion.h',
+        'opt/ifconv/if_conversion_phase.cpp',
+        'opt/ifconv/if_conversion_phase.h',
+        'opt/loop/licm.cpp',
+        'opt/loop/licm.h',
+        'opt/loop/licm_phase.cpp',
+        'opt/loop/licm_phase.h',
         'opt/loop/loop_block.cpp',
         'opt/loop/loop_block.h',
         'opt/optimizer.cpp',
         'opt/optimizer.h',
         'opt/opt_util.cpp',
         'opt/opt_util.h',
+        'opt/opt_test_util.h',
         'opt/phase.cpp',
         'opt/phase.h',
+        'opt/phase_stats.cpp',
+        'opt/phase_stats.h',
+        'opt/pipeline/loop_pipeliner.cpp',
+        'opt/pipeline/loop_pipeliner.h',
+        'opt/pipeline/modulo_scheduler.cpp',
+        'opt/pipeline/modulo_scheduler.h',
         'opt/pipeline/pipeline_phase.h',
         'opt/pipeline/pipeline_phase.cpp',
 	'opt/profile/profile.cpp',
@@ -188,18 +349,32 @@
         'opt/ssa/ssa_converter.h',
         'opt/ssa/ssa.cpp',
         'opt/ssa/ssa.h',
+        'opt/strength/strength_reduction.cpp',
+        'opt/strength/strength_reduction.h',
+        'opt/strength/strength_reduction_phase.cpp',
+        'opt/strength/strength_reduction_phase.h',
         'opt/study.cpp',
         'opt/study.h',
         'opt/unroll/state_copier.cpp',
         'opt/unroll/state_copier.h',
+        'opt/unroll/unroll_factor.cpp',
+        'opt/unroll/unroll_factor.h',
         'opt/unroll/unroll_phase.cpp',
         'opt/unroll/unroll_phase.h',
         'opt/unroll/unroller.cpp',
         'opt/unroll/unroller.h',
+        'opt/width/narrow_width_phase.cpp',
+        'opt/width/narrow_width_phase.h',
+        'opt/width/value_range.cpp',
+        'opt/width/value_range.h',
+        'opt/width/width_narrower.cpp',
+        'opt/width/width_narrower.h',
         'platform/platform.cpp',
         'platform/platform.h',
         'platform/platform_db.cpp',
         'platform/platform_db.h',
+        'writer/binary_writer.cpp',
+        'writer/binary_writer.h',
         'writer/connection.cpp',
         'writer/connection.h',
         'writer/dot_writer.cpp',
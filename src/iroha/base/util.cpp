@@ -3,12 +3,18 @@
 #include <algorithm>
 #include <string.h>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 
 namespace iroha {
 
 vector<string> Util::import_paths_;
 
+namespace {
+// Guards Util::import_paths_.
+std::mutex import_paths_mu;
+}  // namespace
+
 string Util::Itoa(int i) {
   stringstream ss;
   ss << i;
@@ -51,6 +57,7 @@ bool Util::IsInteger(const string &a) {
 }
 
 void Util::SetImportPaths(const vector<string> &paths) {
+  std::lock_guard<std::mutex> lock(import_paths_mu);
   import_paths_ = paths;
 }
 
@@ -91,23 +98,42 @@ string Util::Join(const vector<string> &v, const string &sep) {
 }
 
 istream *Util::OpenFile(const string &s) {
-  // TODO: Search import_paths_ first.
-  ifstream *ifs = new ifstream(s);
+  string path = FindFile(s);
+  if (path.empty()) {
+    return nullptr;
+  }
+  ifstream *ifs = new ifstream(path);
   if (!ifs->fail()) {
     return ifs;
   }
   delete ifs;
+  return nullptr;
+}
+
+string Util::FindFile(const string &s) {
+  // TODO: Search import_paths_ first.
+  {
+    ifstream ifs(s);
+    if (!ifs.fail()) {
+      return s;
+    }
+  }
   if (s.find("/") == 0 || s.find(".") == 0) {
-    return nullptr;
+    return string();
+  }
+  vector<string> paths;
+  {
+    std::lock_guard<std::mutex> lock(import_paths_mu);
+    paths = import_paths_;
   }
-  for (const string &p : import_paths_) {
-    ifs = new ifstream(p + "/" + s);
-    if (!ifs->fail()) {
-      return ifs;
+  for (const string &p : paths) {
+    string path = p + "/" + s;
+    ifstream ifs(path);
+    if (!ifs.fail()) {
+      return path;
     }
-    delete ifs;
   }
-  return nullptr;
+  return string();
 }
 
 string Util::BaseName(const string &fn) {
@@ -23,6 +23,8 @@ public:
   static string ToLower(const string &s);
   static string Join(const vector<string> &v, const string &sep);
   static istream *OpenFile(const string &s);
+  // Returns the path to open for s, searching import paths. Empty if not found.
+  static string FindFile(const string &s);
   static string BaseName(const string &fn);
 
   static vector<string> import_paths_;
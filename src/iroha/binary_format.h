@@ -0,0 +1,49 @@
+// -*- C++ -*-
+//
+// Binary representation of IDesign. This is used to pass a design
+// between iroha processes without printing and parsing S-expressions.
+//
+// All integers are LEB128 varints (signed values are zigzag encoded)
+// unless noted. Strings are interned; each string is written as its
+// index and the first occurrence is followed by its length and bytes.
+// References inside a table (registers, resources, states and insns)
+// are indexes in the table. References across tables use ids like the
+// text format.
+//
+#ifndef _iroha_binary_format_h_
+#define _iroha_binary_format_h_
+
+#include <string.h>
+
+namespace iroha {
+namespace binary {
+
+// Doesn't conflict with the text format which starts with '(', ';' or
+// spaces.
+static const char kMagic[] = "\0IROHA-B";
+static const int kMagicLength = 8;
+static const int kVersion = 1;
+
+// Storage type of registers.
+enum RegisterKind {
+  REG_NORMAL = 0,
+  REG_CONST = 1,
+  REG_WIRE = 2,
+};
+
+// Optional fields of a resource.
+enum ResourceFlags {
+  RES_ARRAY = 1,
+  RES_ARRAY_IMAGE = 2,
+  RES_CALLEE_TABLE = 4,
+  RES_PARENT_RESOURCE = 8,
+};
+
+inline bool IsBinary(const char *data, size_t size) {
+  return size >= kMagicLength && memcmp(data, kMagic, kMagicLength) == 0;
+}
+
+}  // namespace binary
+}  // namespace iroha
+
+#endif  // _iroha_binary_format_h_
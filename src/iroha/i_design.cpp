@@ -1,5 +1,6 @@
 #include "iroha/i_design.h"
 
+#include "design/def_use_index.h"
 #include "design/design_util.h"
 #include "iroha/i_platform.h"
 #include "iroha/opt_api.h"
@@ -97,6 +98,14 @@ IArrayImage *IArray::GetArrayImage() const {
   return array_image_;
 }
 
+void *IResource::operator new(size_t size) {
+  return Slab<IResource>::Alloc(size);
+}
+
+void IResource::operator delete(void *p, size_t size) {
+  Slab<IResource>::Free(p, size);
+}
+
 IResource::IResource(ITable *table, IResourceClass *resource_class)
   : table_(table), resource_class_(resource_class),
     params_(new ResourceParams), id_(-1), array_(nullptr),
@@ -105,6 +114,7 @@ IResource::IResource(ITable *table, IResourceClass *resource_class)
     table->GetModule()->GetDesign()->GetObjectPool();
   pool->resources_.Add(this);
   pool->resource_params_.Add(params_);
+  table->SetNeedsValidation(true);
 }
 
 IResource::~IResource() {
@@ -161,6 +171,14 @@ IValueType IValueType::FromNumericWidth(const NumericWidth &w) {
   return iv;
 }
 
+void *IRegister::operator new(size_t size) {
+  return Slab<IRegister>::Alloc(size);
+}
+
+void IRegister::operator delete(void *p, size_t size) {
+  Slab<IRegister>::Free(p, size);
+}
+
 IRegister::IRegister(ITable *table, const string &name)
   : table_(table), name_(name), id_(-1),
     has_initial_value_(false), is_const_(false), state_local_(false),
@@ -168,6 +186,7 @@ IRegister::IRegister(ITable *table, const string &name)
   IDesign *design =
     table->GetModule()->GetDesign();
   design->GetObjectPool()->registers_.Add(this);
+  table->SetNeedsValidation(true);
 }
 
 ITable *IRegister::GetTable() const {
@@ -180,6 +199,7 @@ const string &IRegister::GetName() const {
 
 void IRegister::SetName(const string &name) {
   name_ = name;
+  table_->SetNeedsValidation(true);
 }
 
 int IRegister::GetId() const {
@@ -235,10 +255,18 @@ ResourceParams *IRegister::GetParams(bool cr) {
   return params_.get();
 }
 
+void *IInsn::operator new(size_t size) {
+  return Slab<IInsn>::Alloc(size);
+}
+
+void IInsn::operator delete(void *p, size_t size) {
+  Slab<IInsn>::Free(p, size);
+}
+
 IInsn::IInsn(IResource *resource) : resource_(resource), id_(-1) {
-  IDesign *design =
-    resource_->GetTable()->GetModule()->GetDesign();
-  design->GetObjectPool()->insns_.Add(this);
+  ITable *table = resource_->GetTable();
+  table->GetModule()->GetDesign()->GetObjectPool()->insns_.Add(this);
+  table->SetNeedsValidation(true);
 }
 
 IResource *IInsn::GetResource() const {
@@ -268,8 +296,17 @@ void IInsn::SetOperand(const string &opr) {
 IProfile::IProfile() : valid_(false), raw_count_(0), normalized_count_(0) {
 }
 
+void *IState::operator new(size_t size) {
+  return Slab<IState>::Alloc(size);
+}
+
+void IState::operator delete(void *p, size_t size) {
+  Slab<IState>::Free(p, size);
+}
+
 IState::IState(ITable *table) : table_(table), id_(-1) {
   table->GetModule()->GetDesign()->GetObjectPool()->states_.Add(this);
+  table->SetNeedsValidation(true);
 }
 
 ITable *IState::GetTable() const {
@@ -293,7 +330,8 @@ const IProfile &IState::GetProfile() const {
 }
 
 ITable::ITable(IModule *module)
-  : module_(module), id_(-1), initial_state_(nullptr) {
+  : module_(module), id_(-1), initial_state_(nullptr),
+    needs_validation_(true) {
   module->GetDesign()->GetObjectPool()->tables_.Add(this);
 
   // Add transition resource for sure.
@@ -306,6 +344,9 @@ ITable::ITable(IModule *module)
   resources_.push_back(tr);
 }
 
+ITable::~ITable() {
+}
+
 IModule *ITable::GetModule() const {
   return module_;
 }
@@ -335,6 +376,22 @@ IState *ITable::GetInitialState() const {
   return initial_state_;
 }
 
+DefUseIndex *ITable::GetDefUseIndex() const {
+  return def_use_index_.get();
+}
+
+void ITable::SetDefUseIndex(DefUseIndex *index) {
+  def_use_index_.reset(index);
+}
+
+bool ITable::NeedsValidation() const {
+  return needs_validation_;
+}
+
+void ITable::SetNeedsValidation(bool needs) {
+  needs_validation_ = needs;
+}
+
 IModule::IModule(IDesign *design, const string &name)
   : design_(design), id_(-1), name_(name), parent_(nullptr),
     params_(new ResourceParams) {
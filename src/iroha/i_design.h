@@ -3,6 +3,7 @@
 #define _iroha_i_design_h_
 
 #include "iroha/common.h"
+#include "iroha/id_index.h"
 #include "numeric/numeric.h"
 
 namespace iroha {
@@ -11,6 +12,7 @@ namespace opt {
 class DebugAnnotation;
 }  // namespace opt
 
+class DefUseIndex;
 class OptAPI;
 class WriterAPI;
 
@@ -80,6 +82,9 @@ class IResource {
 public:
   IResource(ITable *table, IResourceClass *resource_class);
   ~IResource();
+  // Allocated from Slab<IResource> (see object_pool.h).
+  static void *operator new(size_t size);
+  static void operator delete(void *p, size_t size);
   ITable *GetTable() const;
   int GetId() const;
   void SetId(int id);
@@ -108,6 +113,9 @@ private:
 class IRegister {
 public:
   IRegister(ITable *table, const string &name);
+  // Allocated from Slab<IRegister> (see object_pool.h).
+  static void *operator new(size_t size);
+  static void operator delete(void *p, size_t size);
   ITable *GetTable() const;
   int GetId() const;
   void SetId(int id);
@@ -142,6 +150,9 @@ private:
 class IInsn {
 public:
   IInsn(IResource *resource);
+  // Allocated from Slab<IInsn> (see object_pool.h).
+  static void *operator new(size_t size);
+  static void operator delete(void *p, size_t size);
 
   IResource *GetResource() const;
   void SetResource(IResource *resource);
@@ -178,6 +189,9 @@ public:
 class IState {
 public:
   IState(ITable *table);
+  // Allocated from Slab<IState> (see object_pool.h).
+  static void *operator new(size_t size);
+  static void operator delete(void *p, size_t size);
   ITable *GetTable() const;
   int GetId() const;
   void SetId(int id);
@@ -198,6 +212,7 @@ private:
 class ITable {
 public:
   ITable(IModule *module);
+  ~ITable();
   IModule *GetModule() const;
   int GetId() const;
   void SetId(int id);
@@ -205,16 +220,29 @@ public:
   void SetName(const string &name);
   void SetInitialState(IState *state);
   IState *GetInitialState() const;
+  // Optional. See design/def_use_index.h
+  DefUseIndex *GetDefUseIndex() const;
+  // Takes the ownership.
+  void SetDefUseIndex(DefUseIndex *index);
+  // Set when states, insns, registers or resources are created for this
+  // table or its registers are renamed. Cleared by Validator.
+  bool NeedsValidation() const;
+  void SetNeedsValidation(bool needs);
 
   vector<IState *> states_;
   vector<IResource *> resources_;
   vector<IRegister *> registers_;
+  // Used by DesignUtil::Find*ById.
+  IdIndex<IResource> resource_index_;
+  IdIndex<IRegister> register_index_;
 
 private:
   IModule *module_;
   int id_;
   string name_;
   IState *initial_state_;
+  unique_ptr<DefUseIndex> def_use_index_;
+  bool needs_validation_;
 };
 
 // IModule corresponds to a module in HDL.
@@ -231,6 +259,8 @@ public:
   ResourceParams *GetParams() const;
 
   vector<ITable *> tables_;
+  // Used by DesignUtil::FindTableById.
+  IdIndex<ITable> table_index_;
 
 private:
   IDesign *design_;
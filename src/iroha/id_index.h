@@ -0,0 +1,164 @@
+// -*- C++ -*-
+#ifndef _iroha_id_index_h_
+#define _iroha_id_index_h_
+
+#include "iroha/common.h"
+
+namespace iroha {
+
+// Dense id -> position index of objects in a vector (e.g.
+// ITable::registers_). Used by DesignUtil::Find*ById.
+//
+// DesignTool and Validator update it when they add objects or assign ids.
+// Other code may modify the vector directly, so a lookup checks the
+// object at the recorded position and rebuilds the index on a mismatch
+// or when the vector was resized or reallocated. An element replaced or
+// renumbered in place can't be detected that way, so a miss is confirmed
+// by the linear scan.
+template<class T>
+class IdIndex {
+public:
+  IdIndex() : data_(nullptr), size_(0), valid_(false), sparse_(false) {}
+
+  T *Find(const vector<T *> &v, int id) {
+    if (!IsFresh(v)) {
+      Build(v);
+    }
+    T *t;
+    bool fresh = Lookup(v, id, &t);
+    if (fresh && t == nullptr && !unassigned_.empty()) {
+      // The id may have been assigned to an object added without an id.
+      AddAssigned(v);
+      fresh = valid_ && Lookup(v, id, &t);
+    }
+    if (!fresh) {
+      // An element was replaced or its id was changed.
+      Build(v);
+      Lookup(v, id, &t);
+    }
+    if (t == nullptr && !sparse_) {
+      t = Scan(v, id);
+      if (t != nullptr) {
+	Build(v);
+      }
+    }
+    return t;
+  }
+
+  // Call after t is appended to v.
+  void Add(const vector<T *> &v, T *t) {
+    if (!valid_ || size_ + 1 != v.size() || v.back() != t) {
+      valid_ = false;
+      return;
+    }
+    data_ = v.data();
+    size_ = v.size();
+    SetPos(v, v.size() - 1);
+  }
+
+  void Invalidate() {
+    valid_ = false;
+  }
+
+  void Build(const vector<T *> &v) {
+    valid_ = true;
+    data_ = v.data();
+    size_ = v.size();
+    unassigned_.clear();
+    int max_id = -1;
+    for (T *t : v) {
+      if (t->GetId() > max_id) {
+	max_id = t->GetId();
+      }
+    }
+    // Falls back to the linear scan if ids are too sparse.
+    sparse_ = (max_id > kMaxGap + 2 * (int)v.size());
+    pos_.clear();
+    if (sparse_) {
+      return;
+    }
+    pos_.resize(max_id + 1, -1);
+    for (int i = 0; i < v.size(); ++i) {
+      SetPos(v, i);
+    }
+  }
+
+private:
+  static const int kMaxGap = 1024;
+
+  bool IsFresh(const vector<T *> &v) const {
+    return valid_ && data_ == v.data() && size_ == v.size();
+  }
+
+  void SetPos(const vector<T *> &v, int pos) {
+    if (sparse_) {
+      return;
+    }
+    int id = v[pos]->GetId();
+    if (id < 0) {
+      unassigned_.push_back(pos);
+      return;
+    }
+    if (id >= pos_.size()) {
+      if (id > kMaxGap + 2 * (int)v.size()) {
+	valid_ = false;
+	return;
+      }
+      pos_.resize(id + 1, -1);
+    }
+    // The first one wins if there are duplicated ids.
+    if (pos_[id] < 0) {
+      pos_[id] = pos;
+    }
+  }
+
+  void AddAssigned(const vector<T *> &v) {
+    vector<int> positions;
+    positions.swap(unassigned_);
+    for (int pos : positions) {
+      SetPos(v, pos);
+    }
+  }
+
+  // Returns false if the index is stale.
+  bool Lookup(const vector<T *> &v, int id, T **t) const {
+    *t = nullptr;
+    if (sparse_) {
+      *t = Scan(v, id);
+      return true;
+    }
+    if (id < 0 || id >= pos_.size()) {
+      return true;
+    }
+    int pos = pos_[id];
+    if (pos < 0) {
+      return true;
+    }
+    if (v[pos]->GetId() != id) {
+      return false;
+    }
+    *t = v[pos];
+    return true;
+  }
+
+  static T *Scan(const vector<T *> &v, int id) {
+    for (T *t : v) {
+      if (t->GetId() == id) {
+	return t;
+      }
+    }
+    return nullptr;
+  }
+
+  vector<int> pos_;
+  T *const *data_;
+  size_t size_;
+  // Positions of objects without ids when the index was updated.
+  vector<int> unassigned_;
+  bool valid_;
+  bool sparse_;
+};
+
+}  // namespace iroha
+
+#endif  // _iroha_id_index_h_
@@ -1,8 +1,14 @@
 #include "iroha/iroha_main.h"
 
 #include "iroha/iroha.h"
+#include "iroha/logging.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 namespace iroha {
 
@@ -17,13 +23,22 @@ void printUsage() {
 	    << "  -I Set import paths (comma separated. can have multiple -I options)\n"
 	    << "  -h Output HTML\n"
 	    << "  -dot Output Dot (graphviz)\n"
+	    << "  -bin Output binary IR (can be read by iroha)\n"
 	    << "  -o [fn] output to the file name\n"
+	    << "  -j [N] Process files on N threads. Each output is named after\n"
+	    << "     its input (e.g. a.iroha -> a.v) unless -o is given.\n"
+	    << "     A fatal error in any file aborts the whole batch\n"
 	    << "  -d Debug dump\n"
 	    << "  -k Don't validate ids and names\n"
 	    << "  --output_marker=[marker]\n"
 	    << "  --root=[root dir]\n"
 	    << "  --flavor=[flavor]\n"
-	    << "  -opt [optimizer names (comma separated)]\n";
+	    << "  --phase-stats[=json file] Report time, memory and object counts\n"
+	    << "     of each phase and table\n"
+	    << "  -opt [optimizer names (comma separated)]\n"
+	    << "  -opt-jobs [N] Apply optimizers to tables on N threads\n"
+	    << "  -opt-validate [incremental|deferred|full] Validation after\n"
+	    << "     each optimizer (default: incremental)\n";
   std::cout << "    available optimizers: ";
   vector<string> phases = Iroha::GetOptimizerPhaseNames();
   for (size_t i = 0; i < phases.size(); ++i) {
@@ -43,25 +58,205 @@ string getFlagValue(int argc, char **argv, int *idx) {
   return argv[*idx];
 }
 
-// Internal main function to embed the functionality in different binaries.
-int main(int argc, char **argv) {
-  vector<string> files;
+struct Options {
   bool verilog = false;
   bool dot = false;
   bool html = false;
+  bool bin = false;
   bool shell = false;
   bool selfShell = false;
   bool vcd = false;
   bool skipValidation = false;
   bool debugWriter = false;
-  bool showVersion = false;
+  int opt_jobs = 1;
+  string opt_validate;
+  bool phase_stats = false;
 
-  string output;
-  string debug_dump;
   string output_marker;
   string root_dir;
   string flavor;
   vector<string> opts;
+};
+
+// Output file name for fn in the batch mode. e.g. dir/a.iroha -> a.v
+string batchFileName(const Options &o, const string &fn) {
+  string base = (fn == "-") ? "stdin" : Util::BaseName(fn);
+  int pos = base.rfind('.');
+  if (pos != string::npos && pos > 0) {
+    base = base.substr(0, pos);
+  }
+  if (o.verilog) {
+    return base + ".v";
+  }
+  if (o.html) {
+    return base + ".html";
+  }
+  if (o.dot) {
+    return base + ".dot";
+  }
+  if (o.bin) {
+    return base + ".bin";
+  }
+  // Avoids to overwrite the input.
+  return base + ".out.iroha";
+}
+
+// Processes one input file. Returns false if the output can't be written.
+// written is set if the output is written.
+bool processFile(const Options &o, const string &fn, const string &output,
+		 const string &debug_dump, const string &stats_json,
+		 bool *written) {
+  IDesign *design = Iroha::ReadDesignFromFile(fn);
+  if (design == nullptr) {
+    LOG(USER) << "Failed to read design from: " << fn;
+    return true;
+  }
+  std::unique_ptr<IDesign> deleter(design);
+  OptAPI *optimizer = Iroha::CreateOptimizer(design);
+  if (!debug_dump.empty()) {
+    optimizer->EnableDebugAnnotation();
+  }
+  optimizer->SetNumJobs(o.opt_jobs);
+  if (!o.opt_validate.empty() &&
+      !optimizer->SetValidationMode(o.opt_validate)) {
+    LOG(USER) << "Unknown validation mode: " << o.opt_validate;
+  }
+  if (o.phase_stats) {
+    optimizer->EnablePhaseStats();
+  }
+  bool has_opt_err = false;
+  for (const string &phase : o.opts) {
+    if (!optimizer->ApplyPhase(phase)) {
+      has_opt_err = true;
+    }
+  }
+  optimizer->FinishPhases();
+  if (has_opt_err) {
+    LOG(USER) << "Failed to optimize the design: " << fn;
+  }
+  WriterAPI *writer = Iroha::CreateWriter(design);
+  if (!o.output_marker.empty() || !o.root_dir.empty() || !o.flavor.empty() ||
+      o.debugWriter) {
+    writer->SetOutputConfig(o.root_dir, o.flavor, o.output_marker,
+			    o.debugWriter);
+  }
+  if (o.shell || o.selfShell) {
+    if (!output.empty()) {
+      writer->OutputShellModule(true, o.selfShell, o.vcd);
+    }
+  }
+  if (o.verilog) {
+    writer->SetLanguage("verilog");
+  }
+  if (o.html) {
+    writer->SetLanguage("html");
+  }
+  if (o.dot) {
+    writer->SetLanguage("dot");
+  }
+  if (o.bin) {
+    writer->SetLanguage("bin");
+  }
+  if (!o.skipValidation) {
+    optimizer->StartStatsStep("validate");
+    DesignTool::Validate(design);
+    optimizer->EndStatsStep();
+  }
+  optimizer->StartStatsStep("writer");
+  bool write_ok = writer->Write(output);
+  optimizer->EndStatsStep();
+  optimizer->WritePhaseStats(stats_json);
+  if (!write_ok) {
+    return false;
+  }
+  *written = true;
+  if (!debug_dump.empty()) {
+    optimizer->DumpIntermediateToFiles(debug_dump);
+  }
+  return true;
+}
+
+// Processes files on num_jobs threads. Messages of each file are buffered
+// and printed in the order of the files, so the result doesn't depend on
+// the scheduling. A LOG(FATAL) in any file aborts the process. Outputs
+// completed before that are kept. Writer builds each output in memory
+// before it opens the file, so the other outputs are normally not created.
+int processBatch(const Options &o, const vector<string> &files,
+		 const string &output, const string &debug_dump,
+		 const string &stats_json, int num_jobs) {
+  struct Job {
+    ostringstream log;
+    string output;
+    bool ok = true;
+    bool written = false;
+    bool done = false;
+  };
+  vector<Job> jobs(files.size());
+  Options batch_opts = o;
+  // Printed by this thread in order instead of by the writers.
+  batch_opts.output_marker.clear();
+  std::mutex mu;
+  std::condition_variable cv;
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    int i;
+    while ((i = next++) < (int)files.size()) {
+      Job &job = jobs[i];
+      job.output = output;
+      if (job.output.empty()) {
+	job.output = batchFileName(o, files[i]);
+      }
+      string dump = debug_dump;
+      if (!dump.empty() && files.size() > 1) {
+	dump += "." + Util::BaseName(job.output);
+      }
+      string json = stats_json;
+      if (!json.empty() && files.size() > 1) {
+	json += "." + Util::BaseName(job.output);
+      }
+      Logger::SetOutput(&job.log);
+      job.ok = processFile(batch_opts, files[i], job.output, dump, json,
+			   &job.written);
+      Logger::SetOutput(nullptr);
+      std::lock_guard<std::mutex> lock(mu);
+      job.done = true;
+      cv.notify_all();
+    }
+  };
+  vector<std::thread> threads;
+  for (int i = 0; i < num_jobs && i < (int)files.size(); ++i) {
+    threads.push_back(std::thread(worker));
+  }
+  int res = 0;
+  for (Job &job : jobs) {
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      cv.wait(lock, [&job]() { return job.done; });
+    }
+    cerr << job.log.str();
+    if (!job.ok) {
+      res = 1;
+    }
+    if (job.written && !o.output_marker.empty()) {
+      cout << o.output_marker << job.output << "\n";
+    }
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  return res;
+}
+
+// Internal main function to embed the functionality in different binaries.
+int main(int argc, char **argv) {
+  vector<string> files;
+  Options o;
+  bool showVersion = false;
+  int num_jobs = 0;
+
+  string output;
+  string debug_dump;
+  string stats_json;
   vector<string> inc_paths;
 
   for (int i = 1; i < argc; ++i) {
@@ -75,43 +270,54 @@ int main(int argc, char **argv) {
       continue;
     }
     if (arg == "-s") {
-      shell = true;
+      o.shell = true;
       continue;
     }
     if (arg == "-S") {
-      selfShell = true;
+      o.selfShell = true;
       continue;
     }
     if (arg == "-v") {
-      verilog = true;
+      o.verilog = true;
       continue;
     }
     if (arg == "-h") {
-      html = true;
+      o.html = true;
       continue;
     }
     if (arg == "-k") {
-      skipValidation = true;
+      o.skipValidation = true;
       continue;
     }
     if (arg == "-dot") {
-      dot = true;
+      o.dot = true;
+      continue;
+    }
+    if (arg == "-bin") {
+      o.bin = true;
       continue;
     }
     if (arg == "-vcd") {
-      vcd = true;
+      o.vcd = true;
       continue;
     }
     if (arg == "-o") {
       output = getFlagValue(argc, argv, &i);
       continue;
     }
+    if (arg == "-j") {
+      num_jobs = Util::Atoi(getFlagValue(argc, argv, &i));
+      if (num_jobs < 1) {
+	num_jobs = 1;
+      }
+      continue;
+    }
     if (arg == "-d") {
       debug_dump = getFlagValue(argc, argv, &i);
       continue;
     }
     if (arg == "-dw") {
-      debugWriter = true;
+      o.debugWriter = true;
       continue;
     }
     if (arg == "-I") {
@@ -123,34 +329,52 @@ int main(int argc, char **argv) {
       }
       continue;
     }
+    if (arg == "-opt-jobs") {
+      o.opt_jobs = Util::Atoi(getFlagValue(argc, argv, &i));
+      if (o.opt_jobs < 1) {
+	o.opt_jobs = 1;
+      }
+      continue;
+    }
+    if (arg == "-opt-validate") {
+      o.opt_validate = getFlagValue(argc, argv, &i);
+      continue;
+    }
     if (arg == "-opt") {
-      string o = getFlagValue(argc, argv, &i);
-      iroha::Util::SplitStringUsing(o, ",", &opts);
+      string opt = getFlagValue(argc, argv, &i);
+      iroha::Util::SplitStringUsing(opt, ",", &o.opts);
       continue;
     }
     vector<string> tokens;
     iroha::Util::SplitStringUsing(arg, "=", &tokens);
     if (tokens[0] == "--output_marker") {
       if (tokens.size() == 1) {
-	output_marker = getFlagValue(argc, argv, &i);
+	o.output_marker = getFlagValue(argc, argv, &i);
       } else {
-	output_marker = tokens[1];
+	o.output_marker = tokens[1];
       }
       continue;
     }
     if (tokens[0] == "--root") {
       if (tokens.size() == 1) {
-	root_dir = getFlagValue(argc, argv, &i);
+	o.root_dir = getFlagValue(argc, argv, &i);
       } else {
-	root_dir = tokens[1];
+	o.root_dir = tokens[1];
+      }
+      continue;
+    }
+    if (tokens[0] == "--phase-stats") {
+      o.phase_stats = true;
+      if (tokens.size() > 1) {
+	stats_json = tokens[1];
       }
       continue;
     }
     if (tokens[0] == "--flavor") {
       if (tokens.size() == 1) {
-	flavor = getFlagValue(argc, argv, &i);
+	o.flavor = getFlagValue(argc, argv, &i);
       } else {
-	flavor = tokens[1];
+	o.flavor = tokens[1];
       }
       continue;
     }
@@ -169,53 +393,18 @@ int main(int argc, char **argv) {
     Iroha::SetImportPaths(inc_paths);
   }
 
-  for (string &fn : files) {
-    IDesign *design = Iroha::ReadDesignFromFile(fn);
-    if (design == nullptr) {
-      cerr << "Failed to read design from: " << fn << "\n";
-      continue;
-    }
-    std::unique_ptr<IDesign> deleter(design);
-    OptAPI *optimizer = Iroha::CreateOptimizer(design);
-    if (!debug_dump.empty()) {
-      optimizer->EnableDebugAnnotation();
-    }
-    bool has_opt_err = false;
-    for (string &phase : opts) {
-      if (!optimizer->ApplyPhase(phase)) {
-	has_opt_err = true;
-      }
-    }
-    if (has_opt_err) {
-      cerr << "Failed to optimize the design: " << fn << "\n";
-    }
-    WriterAPI *writer = Iroha::CreateWriter(design);
-    if (!output_marker.empty() || !root_dir.empty() || !flavor.empty() ||
-	debugWriter) {
-      writer->SetOutputConfig(root_dir, flavor, output_marker, debugWriter);
-    }
-    if (shell || selfShell) {
-      if (!output.empty()) {
-	writer->OutputShellModule(true, selfShell, vcd);
-      }
-    }
-    if (verilog) {
-      writer->SetLanguage("verilog");
-    }
-    if (html) {
-      writer->SetLanguage("html");
-    }
-    if (dot) {
-      writer->SetLanguage("dot");
-    }
-    if (!skipValidation) {
-      DesignTool::Validate(design);
-    }
-    if (!writer->Write(output)) {
+  if (num_jobs > 0) {
+    if (!output.empty() && files.size() > 1) {
+      cerr << "-o can't be used with -j for multiple files\n";
       return 1;
     }
-    if (!debug_dump.empty()) {
-      optimizer->DumpIntermediateToFiles(debug_dump);
+    return processBatch(o, files, output, debug_dump, stats_json, num_jobs);
+  }
+
+  for (string &fn : files) {
+    bool written = false;
+    if (!processFile(o, fn, output, debug_dump, stats_json, &written)) {
+      return 1;
     }
   }
   return 0;
@@ -5,7 +5,9 @@
 
 namespace iroha {
 
-static stringstream ss;
+// Each thread builds its own messages (e.g. iroha -j N).
+static thread_local stringstream ss;
+static thread_local ostream *output;
 
 ostream &Logger::GetStream(LogSeverity sev) {
   return ss;
@@ -16,16 +18,28 @@ void Logger::Finalize(LogSeverity sev, const char *fn, int line) {
     ss.str("");
     return;
   }
+  ostream *os = output;
+  if (os == nullptr || sev == FATAL) {
+    os = &cerr;
+  }
   if (sev != USER) {
-    cerr << fn << ":" << line << ":";
+    *os << fn << ":" << line << ":";
   }
-  cerr << ss.str() << "\n";
+  *os << ss.str() << "\n";
   ss.str("");
   if (sev == FATAL) {
     abort();
   }
 }
 
+void Logger::SetOutput(ostream *os) {
+  output = os;
+}
+
+ostream *Logger::GetOutput() {
+  return output;
+}
+
 LogFinalizer::LogFinalizer(LogSeverity sev, const char *fn, int line)
   : sev_(sev), fn_(fn), line_(line) {
 }
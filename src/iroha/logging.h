@@ -22,6 +22,11 @@ class Logger {
 public:
   static std::ostream &GetStream(LogSeverity sev);
   static void Finalize(LogSeverity sev, const char *fn, int line);
+  // Sends messages from the calling thread to os (cerr if nullptr).
+  // FATAL messages are always written to cerr.
+  static void SetOutput(std::ostream *os);
+  // nullptr if messages go to cerr.
+  static std::ostream *GetOutput();
 };
 
 class LogFinalizer {
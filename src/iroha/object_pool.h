@@ -4,29 +4,175 @@
 
 #include "iroha/common.h"
 
+#include <mutex>
+#include <unordered_set>
+
 namespace iroha {
 
+// Allocates objects of T from slabs of fixed size blocks. This is used by
+// class specific operator new/delete of numerous objects (e.g. IInsn).
+//
+// Freed blocks are kept in a per thread free list and reused by the next
+// allocation. Slabs are never returned, so the addresses stay valid
+// until the objects are freed. Blocks on the free list of an exiting thread
+// are passed to other threads.
+template<class T>
+class Slab {
+public:
+  static void *Alloc(size_t size) {
+    if (size != sizeof(T)) {
+      // Derived class.
+      return ::operator new(size);
+    }
+    Cache &c = GetCache();
+    if (c.free_ == nullptr) {
+      c.Refill();
+    }
+    Block *b = c.free_;
+    c.free_ = b->next_;
+    return b;
+  }
+
+  static void Free(void *p, size_t size) {
+    if (p == nullptr) {
+      return;
+    }
+    if (size != sizeof(T)) {
+      ::operator delete(p);
+      return;
+    }
+    Cache &c = GetCache();
+    Block *b = (Block *)p;
+    b->next_ = c.free_;
+    c.free_ = b;
+  }
+
+private:
+  struct Block {
+    Block *next_;
+  };
+  static const size_t kBlockSize =
+    sizeof(T) > sizeof(Block) ? sizeof(T) : sizeof(Block);
+  static const size_t kSlabSize = 64 * 1024;
+  static const int kBlocksPerSlab =
+    (kSlabSize / kBlockSize) > 16 ? (kSlabSize / kBlockSize) : 16;
+
+  // Shared by threads. Allocated once and never deleted.
+  struct Global {
+    std::mutex mu_;
+    Block *free_ = nullptr;
+  };
+
+  struct Cache {
+    Block *free_ = nullptr;
+
+    ~Cache() {
+      if (free_ == nullptr) {
+	return;
+      }
+      Block *last = free_;
+      while (last->next_ != nullptr) {
+	last = last->next_;
+      }
+      Global *g = GetGlobal();
+      std::lock_guard<std::mutex> lock(g->mu_);
+      last->next_ = g->free_;
+      g->free_ = free_;
+    }
+
+    void Refill() {
+      Global *g = GetGlobal();
+      {
+	std::lock_guard<std::mutex> lock(g->mu_);
+	if (g->free_ != nullptr) {
+	  free_ = g->free_;
+	  g->free_ = nullptr;
+	  return;
+	}
+      }
+      char *slab = (char *)::operator new(kBlockSize * kBlocksPerSlab);
+      for (int i = kBlocksPerSlab - 1; i >= 0; --i) {
+	Block *b = (Block *)(slab + i * kBlockSize);
+	b->next_ = free_;
+	free_ = b;
+      }
+    }
+  };
+
+  static Cache &GetCache() {
+    static thread_local Cache cache;
+    return cache;
+  }
+
+  static Global *GetGlobal() {
+    static Global *global = new Global;
+    return global;
+  }
+};
+
+// Add() and Release() can be called from multiple threads (e.g. phases
+// processing tables in parallel).
 template<class T>
 class Pool {
 public:
   ~Pool() {
+    Compact();
     for (int i = 0; i < ptrs_.size(); ++i) {
       delete ptrs_[i];
     }
   }
   void Add(T *p) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = released_.find(p);
+    if (it != released_.end()) {
+      // Released (and maybe deleted and allocated again at the same
+      // address) before compaction. The slot is still in ptrs_.
+      released_.erase(it);
+      return;
+    }
     ptrs_.push_back(p);
   }
+  // Takes p out of the pool without deleting it. The slot is removed by
+  // the next compaction, which runs when half of the slots are released.
   void Release(T *p) {
-    std::vector<T *> tmp_ptrs_;
-    for (auto *t : ptrs_) {
-      if (t != p) {
-	tmp_ptrs_.push_back(t);
+    std::lock_guard<std::mutex> lock(mu_);
+    released_.insert(p);
+    if (released_.size() > kMinCompaction &&
+	released_.size() * 2 > ptrs_.size()) {
+      CompactLocked();
+    }
+  }
+  void Compact() {
+    std::lock_guard<std::mutex> lock(mu_);
+    CompactLocked();
+  }
+  // Number of objects owned by this pool.
+  int Size() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return ptrs_.size() - released_.size();
+  }
+
+private:
+  static const size_t kMinCompaction = 64;
+
+  void CompactLocked() {
+    if (released_.empty()) {
+      return;
+    }
+    int n = 0;
+    for (int i = 0; i < ptrs_.size(); ++i) {
+      if (released_.find(ptrs_[i]) == released_.end()) {
+	ptrs_[n] = ptrs_[i];
+	++n;
       }
     }
-    ptrs_ = tmp_ptrs_;
+    ptrs_.resize(n);
+    released_.clear();
   }
+
+  std::mutex mu_;
   std::vector<T *> ptrs_;
+  std::unordered_set<T *> released_;
 };
 
 class ObjectPool {
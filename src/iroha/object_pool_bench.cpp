@@ -0,0 +1,74 @@
+// Measures creation and release of numerous insns in the ObjectPool.
+//
+// object_pool_bench [number of insns]
+#include "iroha/iroha.h"
+#include "iroha/object_pool.h"
+
+#include <chrono>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+double Elapsed(chrono::steady_clock::time_point start) {
+  auto d = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::duration<double> >(d).count();
+}
+
+long MaxRssKB() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_insns = 4000000;
+  if (argc > 1) {
+    num_insns = atoi(argv[1]);
+  }
+  cout << "insns=" << num_insns << "\n";
+  for (int round = 0; round < 2; ++round) {
+    // The second round reuses the blocks freed by the first one.
+    IDesign *design = new IDesign;
+    IModule *mod = new IModule(design, "m");
+    design->modules_.push_back(mod);
+    ITable *tab = new ITable(mod);
+    mod->tables_.push_back(tab);
+    IResource *res = tab->resources_[0];
+    Pool<IInsn> *pool = &design->GetObjectPool()->insns_;
+
+    auto start = chrono::steady_clock::now();
+    vector<IInsn *> insns;
+    for (int i = 0; i < num_insns; ++i) {
+      insns.push_back(new IInsn(res));
+    }
+    cout << "round " << round << "\n"
+	 << " create: " << Elapsed(start) << "s\n";
+
+    // Releases every other insn like a cleanup phase does.
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < num_insns; i += 2) {
+      pool->Release(insns[i]);
+      delete insns[i];
+    }
+    cout << " release half: " << Elapsed(start) << "s"
+	 << " (" << pool->Size() << " left)\n";
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < num_insns; i += 2) {
+      insns[i] = new IInsn(res);
+    }
+    cout << " create half again: " << Elapsed(start) << "s\n";
+
+    start = chrono::steady_clock::now();
+    delete design;
+    cout << " delete design: " << Elapsed(start) << "s"
+	 << " maxrss=" << MaxRssKB() << "KB\n";
+  }
+  return 0;
+}
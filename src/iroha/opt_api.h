@@ -11,7 +11,26 @@ public:
   virtual ~OptAPI();
   virtual bool ApplyPhase(const string &name) = 0;
   virtual void EnableDebugAnnotation() = 0;
+  // Phases may process tables on num_jobs threads. Default is 1.
+  virtual void SetNumJobs(int num_jobs) = 0;
+  // How the design is validated after each phase.
+  // "incremental" (default): Only modified tables and their modules.
+  // "deferred": Only ids of modified tables. The entire design is
+  //   validated by FinishPhases().
+  // "full": The entire design (for debugging).
+  // Returns false for an unknown mode.
+  virtual bool SetValidationMode(const string &mode) = 0;
+  // Called after the last phase.
+  virtual void FinishPhases() = 0;
   virtual void DumpIntermediateToFiles(const string &fn) = 0;
+  // Records time, memory and object counts of each phase and table.
+  virtual void EnablePhaseStats() = 0;
+  // Measures a step outside of phases (e.g. writer) if enabled.
+  virtual void StartStatsStep(const string &name) = 0;
+  virtual void EndStatsStep() = 0;
+  // Emits the report as a table to the log and as JSON to json_fn
+  // unless it is empty.
+  virtual void WritePhaseStats(const string &json_fn) = 0;
 };
 
 }  // namespace iroha
@@ -437,4 +437,12 @@ void ResourceParams::SetIsPipeline(bool pipeline) {
   values_->SetBoolParam(resource::kPipeline, pipeline);
 }
 
+int ResourceParams::GetPipelineII() {
+  return values_->GetIntParam(resource::kPipelineII, 0);
+}
+
+void ResourceParams::SetPipelineII(int ii) {
+  values_->SetIntParam(resource::kPipelineII, ii);
+}
+
 }  // namespace iroha
@@ -39,6 +39,7 @@ const char kWenSuffix[] = "WEN";
 const char kNotifySuffix[] = "NOTIFY";
 const char kPutSuffix[] = "PUT";
 const char kPipeline[] = "PIPELINE";
+const char kPipelineII[] = "PIPELINE-II";
 const char kLoopUnroll[] = "LOOP-UNROLL";
 }  // namespace resource
 
@@ -123,6 +124,10 @@ public:
   void SetLoopUnroll(int unroll);
   bool GetIsPipeline();
   void SetIsPipeline(bool pipeline);
+  // Initiation interval achieved by the pipeline optimizer. 0 if not
+  // pipelined yet.
+  int GetPipelineII();
+  void SetPipelineII(int ii);
 
 private:
   resource::ResourceParamValueSet *values_;
@@ -5,10 +5,6 @@
 #include <iomanip>
 #include <sstream>
 
-namespace {
-iroha::NumericManager *default_manager;
-}  // namespace
-
 namespace iroha {
 
 Numeric::Numeric() {
@@ -30,8 +26,6 @@ std::string Numeric::Format() const {
 std::string Numeric::Format(const NumericWidth &w, const NumericValue &val) {
   if (w.IsExtraWide()) {
     return FormatArray(w, val.extra_wide_value_->value_);
-  } else if (w.IsWide()) {
-    return FormatArray(w, val.value_);
   } else {
     uint64_t v = val.value_[0];
     std::string s;
@@ -63,9 +57,8 @@ std::string Numeric::FormatArray(const NumericWidth &type,
 
 
 NumericManager *Numeric::DefaultManager() {
-  if (default_manager == nullptr) {
-    default_manager = new NumericManager;
-  }
+  // Initialization of a local static is thread safe.
+  static NumericManager *default_manager = new NumericManager;
   return default_manager;
 }
 
@@ -97,35 +90,19 @@ void Numeric::CopyValueWithWidth(const NumericValue &src_value,
     mgr = DefaultManager();
   }
   mgr->MayPopulateStorage(dst_width, value);
-  if (src_width.IsExtraWide()) {
-    if (dst_width.IsExtraWide()) {
-      for (int i = 0; i < 32; ++i) {
-	value->extra_wide_value_->value_[i] =
-	  src_value.extra_wide_value_->value_[i];
-      }
-    } else {
-      for (int i = 0; i < 8; ++i) {
-	value->value_[i] =  src_value.extra_wide_value_->value_[i];
-      }
-    }
-  } else {
-    if (dst_width.IsExtraWide()) {
-      for (int i = 0; i < 8; ++i) {
-	value->extra_wide_value_->value_[i] = src_value.value_[i];
-      }
-      for (int i = 8; i < 32; ++i) {
-	value->extra_wide_value_->value_[i] = 0;
-      }
+  const uint64_t *sv = GetLimbs(src_width, src_value);
+  uint64_t *dv = GetMutableLimbs(dst_width, value);
+  int src_count = GetLimbCount(src_width);
+  int dst_count = GetLimbCount(dst_width);
+  for (int i = 0; i < dst_count; ++i) {
+    if (i < src_count) {
+      dv[i] = sv[i];
     } else {
-      *value = src_value;
+      dv[i] = 0;
     }
   }
   if (dst_width.GetWidth() > src_width.GetWidth()) {
-    if (dst_width.IsExtraWide()) {
-      FixupArray(src_width.GetWidth(), 32, value->extra_wide_value_->value_);
-    } else {
-      FixupArray(src_width.GetWidth(), 8, value->value_);
-    }
+    FixupArray(src_width.GetWidth(), dst_count, dv);
   }
 }
 
@@ -160,18 +137,14 @@ void Numeric::MayExpandStorage(NumericManager *mgr, Numeric *n) {
   MayPopulateStorage(n->type_, mgr, n->GetMutableArray());
   NumericValue *nv = n->GetMutableArray();
   nv->extra_wide_value_->Clear();
-  for (int i = 0; i < 8; ++i) {
-    nv->extra_wide_value_->value_[i] = savedValue.value_[i];
-  }
+  nv->extra_wide_value_->value_[0] = savedValue.value_[0];
 }
 
 void Numeric::Clear(const NumericWidth &width, NumericValue *value) {
   if (width.IsExtraWide()) {
     value->extra_wide_value_->Clear();
   } else {
-    for (int i = 0; i < 8; ++i) {
-      value->value_[i] = 0;
-    }
+    value->value_[0] = 0;
   }
 }
 
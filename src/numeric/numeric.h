@@ -22,6 +22,28 @@ public:
     }
   }
   void SetValue0(uint64_t value);
+  // Limbs of the value in the inline or the extra wide storage.
+  static const uint64_t *GetLimbs(const NumericWidth &w,
+				  const NumericValue &v) {
+    if (w.IsExtraWide()) {
+      return v.extra_wide_value_->value_;
+    }
+    return v.value_;
+  }
+  static uint64_t *GetMutableLimbs(const NumericWidth &w, NumericValue *v) {
+    if (w.IsExtraWide()) {
+      return v->extra_wide_value_->value_;
+    }
+    return v->value_;
+  }
+  // Number of limbs available in the storage for w.
+  static int GetLimbCount(const NumericWidth &w) {
+    if (w.IsExtraWide()) {
+      int c = ExtraWideValue::GetSizeClass(w.GetValueCount());
+      return ExtraWideValue::GetClassLimbs(c);
+    }
+    return 1;
+  }
   const NumericValue &GetArray() const {
     return value_;
   }
@@ -4,12 +4,25 @@
 // Multiple instances can represent different units of GCs (multiple VMs in).
 
 #include "numeric/numeric_width.h"
-#include "iroha/stl_util.h"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
 
 namespace iroha {
 
+NumericManager::NumericManager() {
+  for (int i = 0; i < ExtraWideValue::kNumSizeClasses; ++i) {
+    alloc_hint_[i] = 0;
+  }
+}
+
 NumericManager::~NumericManager() {
-  STLDeleteValues(&values_);
+  for (int i = 0; i < ExtraWideValue::kNumSizeClasses; ++i) {
+    for (Chunk *c : chunks_[i]) {
+      FreeChunk(c);
+    }
+  }
 }
 
 void NumericManager::MayPopulateStorage(const NumericWidth &w,
@@ -17,33 +30,57 @@ void NumericManager::MayPopulateStorage(const NumericWidth &w,
   if (!w.IsExtraWide()) {
     return;
   }
-  ExtraWideValue *ev = new ExtraWideValue();
+  int size_class = ExtraWideValue::GetSizeClass(w.GetValueCount());
+  std::lock_guard<std::mutex> lock(mu_);
+  ExtraWideValue *ev = Alloc(size_class);
   ev->Clear();
-  ev->owner_ = this;
   v->extra_wide_value_ = ev;
-  values_.insert(ev);
 }
 
 void NumericManager::StartGC() {
-  marked_values_.clear();
+  std::lock_guard<std::mutex> lock(mu_);
+  for (int i = 0; i < ExtraWideValue::kNumSizeClasses; ++i) {
+    for (Chunk *c : chunks_[i]) {
+      memset(c->marked, 0, sizeof(c->marked));
+    }
+  }
 }
 
 void NumericManager::MarkStorage(const Numeric *n) {
-  // This may contain addresses of undefined locations.
-  marked_values_.insert(n->GetArray().extra_wide_value_);
+  if (!n->type_.IsExtraWide()) {
+    return;
+  }
+  // This may contain addresses of undefined locations, so this checks
+  // the address before touching the value.
+  const ExtraWideValue *ev = n->GetArray().extra_wide_value_;
+  std::lock_guard<std::mutex> lock(mu_);
+  Chunk *c = FindChunk(ev);
+  if (c == nullptr) {
+    return;
+  }
+  int idx = ((const char *)ev - c->mem) / c->stride;
+  c->marked[idx / 64] |= (1ULL << (idx % 64));
 }
 
 void NumericManager::DoGC() {
-  std::set<ExtraWideValue *> live;
-  for (auto *v : values_) {
-    if (marked_values_.find(v) == marked_values_.end()) {
-      delete v;
-    } else {
-      live.insert(v);
+  std::lock_guard<std::mutex> lock(mu_);
+  for (int i = 0; i < ExtraWideValue::kNumSizeClasses; ++i) {
+    std::vector<Chunk *> live;
+    for (Chunk *c : chunks_[i]) {
+      uint64_t any = 0;
+      for (int w = 0; w < kBitmapWords; ++w) {
+	c->allocated[w] &= c->marked[w];
+	any |= c->allocated[w];
+      }
+      if (any) {
+	live.push_back(c);
+      } else {
+	FreeChunk(c);
+      }
     }
+    chunks_[i] = live;
+    alloc_hint_[i] = 0;
   }
-  values_ = live;
-  marked_values_.clear();
 }
 
 void NumericManager::CopyValue(const Numeric &src, NumericValue *dst) {
@@ -51,10 +88,92 @@ void NumericManager::CopyValue(const Numeric &src, NumericValue *dst) {
     *dst = src.GetArray();
     return;
   }
-  ExtraWideValue *ev = new ExtraWideValue(*src.GetArray().extra_wide_value_);
+  const ExtraWideValue *sv = src.GetArray().extra_wide_value_;
+  int size_class = ExtraWideValue::GetSizeClass(src.type_.GetValueCount());
+  std::lock_guard<std::mutex> lock(mu_);
+  ExtraWideValue *ev = Alloc(size_class);
+  for (int i = 0; i < ev->size_; ++i) {
+    ev->value_[i] = sv->value_[i];
+  }
   dst->extra_wide_value_ = ev;
-  ev->owner_ = this;
-  values_.insert(ev);
+}
+
+int NumericManager::GetNumValues() {
+  std::lock_guard<std::mutex> lock(mu_);
+  int n = 0;
+  for (int i = 0; i < ExtraWideValue::kNumSizeClasses; ++i) {
+    for (Chunk *c : chunks_[i]) {
+      for (int w = 0; w < kBitmapWords; ++w) {
+	n += __builtin_popcountll(c->allocated[w]);
+      }
+    }
+  }
+  return n;
+}
+
+ExtraWideValue *NumericManager::Alloc(int size_class) {
+  std::vector<Chunk *> &chunks = chunks_[size_class];
+  int &hint = alloc_hint_[size_class];
+  for (; hint < chunks.size(); ++hint) {
+    Chunk *c = chunks[hint];
+    for (int w = 0; w < kBitmapWords; ++w) {
+      uint64_t free_bits = ~c->allocated[w];
+      if (free_bits == 0) {
+	continue;
+      }
+      int b = __builtin_ctzll(free_bits);
+      c->allocated[w] |= (1ULL << b);
+      char *p = c->mem + (w * 64 + b) * c->stride;
+      return (ExtraWideValue *)p;
+    }
+  }
+  Chunk *c = NewChunk(size_class);
+  chunks.push_back(c);
+  c->allocated[0] = 1;
+  return (ExtraWideValue *)c->mem;
+}
+
+NumericManager::Chunk *NumericManager::NewChunk(int size_class) {
+  Chunk *c = new Chunk;
+  int limbs = ExtraWideValue::GetClassLimbs(size_class);
+  c->size_class = size_class;
+  c->stride = offsetof(ExtraWideValue, value_) + limbs * sizeof(uint64_t);
+  c->mem = (char *)::operator new(c->stride * kSlotsPerChunk);
+  memset(c->allocated, 0, sizeof(c->allocated));
+  memset(c->marked, 0, sizeof(c->marked));
+  // Sets the header of each slot. Only the first size_ limbs are valid.
+  for (int i = 0; i < kSlotsPerChunk; ++i) {
+    ExtraWideValue *ev = (ExtraWideValue *)(c->mem + i * c->stride);
+    ev->owner_ = this;
+    ev->size_ = limbs;
+  }
+  chunk_by_addr_[c->mem] = c;
+  return c;
+}
+
+void NumericManager::FreeChunk(Chunk *c) {
+  chunk_by_addr_.erase(c->mem);
+  ::operator delete(c->mem);
+  delete c;
+}
+
+NumericManager::Chunk *NumericManager::FindChunk(const ExtraWideValue *v) {
+  const char *p = (const char *)v;
+  auto it = chunk_by_addr_.upper_bound(p);
+  if (it == chunk_by_addr_.begin()) {
+    return nullptr;
+  }
+  --it;
+  Chunk *c = it->second;
+  int offset = p - c->mem;
+  if (offset >= c->stride * kSlotsPerChunk || (offset % c->stride) != 0) {
+    return nullptr;
+  }
+  int idx = offset / c->stride;
+  if (!(c->allocated[idx / 64] & (1ULL << (idx % 64)))) {
+    return nullptr;
+  }
+  return c;
 }
 
 }  // iroha
@@ -5,12 +5,15 @@
 #include "numeric/numeric.h"
 #include "numeric/numeric_width.h"
 
-#include <set>
+#include <map>
+#include <mutex>
+#include <vector>
 
 namespace iroha {
 
 class NumericManager {
 public:
+  NumericManager();
   ~NumericManager();
 
   void MayPopulateStorage(const NumericWidth &w, NumericValue *v);
@@ -18,10 +21,34 @@ public:
   void MarkStorage(const Numeric *n);
   void DoGC();
   void CopyValue(const Numeric &src, NumericValue *dst);
+  // Number of live extra wide values.
+  int GetNumValues();
 
 private:
-  std::set<ExtraWideValue *> values_;
-  std::set<const ExtraWideValue *> marked_values_;
+  // Values of one size class are allocated in chunks with bitmaps of
+  // allocated and marked slots.
+  static const int kSlotsPerChunk = 256;
+  static const int kBitmapWords = kSlotsPerChunk / 64;
+  struct Chunk {
+    char *mem;
+    int size_class;
+    int stride;
+    uint64_t allocated[kBitmapWords];
+    uint64_t marked[kBitmapWords];
+  };
+
+  ExtraWideValue *Alloc(int size_class);
+  Chunk *NewChunk(int size_class);
+  void FreeChunk(Chunk *c);
+  Chunk *FindChunk(const ExtraWideValue *v);
+
+  // Guards the chunks, since the default manager is shared by threads.
+  std::mutex mu_;
+  std::vector<Chunk *> chunks_[ExtraWideValue::kNumSizeClasses];
+  // Index of the first chunk which may have a free slot.
+  int alloc_hint_[ExtraWideValue::kNumSizeClasses];
+  // Start address to chunk.
+  std::map<const char *, Chunk *> chunk_by_addr_;
 };
 
 }  // iroha
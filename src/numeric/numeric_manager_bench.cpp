@@ -0,0 +1,99 @@
+// Measures allocation and GC of extra wide values in NumericManager.
+//
+// numeric_manager_bench [number of values]
+#include "numeric/numeric.h"
+#include "numeric/numeric_manager.h"
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+double Elapsed(chrono::steady_clock::time_point start) {
+  auto d = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::duration<double> >(d).count();
+}
+
+// Old implementation for comparison: One 2048 bit block per value and
+// sets for mark/sweep.
+struct OldValue {
+  uint64_t value_[32];
+  NumericManager *owner_;
+};
+
+void RunOld(int num_values) {
+  set<OldValue *> values;
+  vector<OldValue *> ptrs;
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < num_values; ++i) {
+    OldValue *v = new OldValue();
+    values.insert(v);
+    ptrs.push_back(v);
+  }
+  double alloc_time = Elapsed(start);
+
+  start = chrono::steady_clock::now();
+  set<const OldValue *> marked;
+  for (int i = 0; i < num_values; i += 2) {
+    marked.insert(ptrs[i]);
+  }
+  set<OldValue *> live;
+  for (auto *v : values) {
+    if (marked.find(v) == marked.end()) {
+      delete v;
+    } else {
+      live.insert(v);
+    }
+  }
+  values = live;
+  double gc_time = Elapsed(start);
+  for (auto *v : values) {
+    delete v;
+  }
+  cout << " old: alloc " << alloc_time << "s, gc " << gc_time << "s\n";
+}
+
+void Run(int num_values, int width) {
+  NumericManager *mgr = Numeric::CreateManager();
+  vector<Numeric> values;
+  values.resize(num_values);
+  auto start = chrono::steady_clock::now();
+  for (Numeric &n : values) {
+    n.type_.SetWidth(width);
+    mgr->MayPopulateStorage(n.type_, n.GetMutableArray());
+  }
+  double alloc_time = Elapsed(start);
+
+  // Keeps every other value.
+  start = chrono::steady_clock::now();
+  mgr->StartGC();
+  for (int i = 0; i < num_values; i += 2) {
+    mgr->MarkStorage(&values[i]);
+  }
+  mgr->DoGC();
+  double gc_time = Elapsed(start);
+  cout << " width=" << width << ": alloc " << alloc_time << "s, gc "
+       << gc_time << "s (" << mgr->GetNumValues() << " live)\n";
+  Numeric::DeleteManager(mgr);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_values = 200000;
+  if (argc > 1) {
+    num_values = atoi(argv[1]);
+  }
+  cout << "values=" << num_values << "\n";
+  RunOld(num_values);
+  for (int w : {128, 1024, 2048, 4096}) {
+    Run(num_values, w);
+  }
+  return 0;
+}
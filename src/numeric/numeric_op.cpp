@@ -5,6 +5,44 @@
 
 namespace iroha {
 
+namespace {
+
+bool IsNegative0(const NumericWidth &w, uint64_t v) {
+  if (!w.IsSigned() || w.GetWidth() == 0) {
+    return false;
+  }
+  return (v >> (w.GetWidth() - 1)) & 1;
+}
+
+void DivMod0(const NumericWidth &w, uint64_t x, uint64_t y,
+	     uint64_t *q, uint64_t *r) {
+  uint64_t mask = w.GetMask();
+  x &= mask;
+  y &= mask;
+  if (y == 0) {
+    *q = 0;
+    *r = 0;
+    return;
+  }
+  // Divides magnitudes and fixes the signs.
+  bool xn = IsNegative0(w, x);
+  bool yn = IsNegative0(w, y);
+  uint64_t mx = xn ? (-x & mask) : x;
+  uint64_t my = yn ? (-y & mask) : y;
+  uint64_t qq = mx / my;
+  uint64_t rr = mx % my;
+  if (xn != yn) {
+    qq = -qq;
+  }
+  if (xn) {
+    rr = -rr;
+  }
+  *q = qq & mask;
+  *r = rr & mask;
+}
+
+}  // namespace
+
 bool Op::IsZero(const NumericWidth &w, const NumericValue &n) {
   if (w.IsWide()) {
     return WideOp::IsZero(w, n);
@@ -32,24 +70,24 @@ void Op::CalcBinOp(BinOp op, const NumericValue &x, const NumericValue &y,
     case BINOP_RSHIFT:
       {
 	int c = y.GetValue0();
-	if (w.IsExtraWide()) {
-	  WideOp::ShiftExtraWide(x, c, (op == BINOP_LSHIFT), res);
-	} else {
-	  WideOp::Shift(x, c, (op == BINOP_LSHIFT), res);
-	}
+	WideOp::Shift(w, x, c, (op == BINOP_LSHIFT), res);
       }
       break;
     case BINOP_AND:
     case BINOP_OR:
     case BINOP_XOR:
       {
-	WideOp::BinBitOp(op, x, y, res);
+	WideOp::BinBitOp(op, w, x, y, res);
       }
       break;
     case BINOP_MUL:
+      WideOp::Mul(w, x, y, res);
+      break;
     case BINOP_DIV:
-      // These are not usable for wide nums.
-      return;
+      WideOp::DivMod(w, x, y, res, nullptr);
+      break;
+    case BINOP_MOD:
+      WideOp::DivMod(w, x, y, nullptr, res);
       break;
     }
     return;
@@ -79,9 +117,104 @@ void Op::CalcBinOp(BinOp op, const NumericValue &x, const NumericValue &y,
     res->SetValue0(x.GetValue0() * y.GetValue0());
     break;
   case BINOP_DIV:
-    res->SetValue0(x.GetValue0() / y.GetValue0());
+  case BINOP_MOD:
+    {
+      // Same as Div() and Mod() including the division by zero.
+      uint64_t q, r;
+      DivMod0(w, x.GetValue0(), y.GetValue0(), &q, &r);
+      res->SetValue0((op == BINOP_DIV) ? q : r);
+    }
+    break;
+  }
+}
+
+void Op::Add(const NumericWidth &w, const NumericValue &x,
+	     const NumericValue &y, NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::Add(w, x, y, a);
+    return;
+  }
+  a->SetValue0((x.GetValue0() + y.GetValue0()) & w.GetMask());
+}
+
+void Op::Sub(const NumericWidth &w, const NumericValue &x,
+	     const NumericValue &y, NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::Sub(w, x, y, a);
+    return;
+  }
+  a->SetValue0((x.GetValue0() - y.GetValue0()) & w.GetMask());
+}
+
+void Op::Minus(const NumericWidth &w, const NumericValue &x,
+	       NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::Minus(w, x, a);
+    return;
+  }
+  a->SetValue0((-x.GetValue0()) & w.GetMask());
+}
+
+void Op::Mul(const NumericWidth &w, const NumericValue &x,
+	     const NumericValue &y, NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::Mul(w, x, y, a);
+    return;
+  }
+  a->SetValue0((x.GetValue0() * y.GetValue0()) & w.GetMask());
+}
+
+void Op::Div(const NumericWidth &w, const NumericValue &x,
+	     const NumericValue &y, NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::DivMod(w, x, y, a, nullptr);
+    return;
+  }
+  uint64_t q, r;
+  DivMod0(w, x.GetValue0(), y.GetValue0(), &q, &r);
+  a->SetValue0(q);
+}
+
+void Op::Mod(const NumericWidth &w, const NumericValue &x,
+	     const NumericValue &y, NumericValue *a) {
+  if (w.IsWide()) {
+    WideOp::DivMod(w, x, y, nullptr, a);
+    return;
+  }
+  uint64_t q, r;
+  DivMod0(w, x.GetValue0(), y.GetValue0(), &q, &r);
+  a->SetValue0(r);
+}
+
+bool Op::Compare(CompareOp op, const NumericWidth &w,
+		 const NumericValue &x, const NumericValue &y) {
+  int c;
+  if (w.IsWide()) {
+    c = WideOp::Compare(w, x, y);
+  } else {
+    uint64_t xv = x.GetValue0() & w.GetMask();
+    uint64_t yv = y.GetValue0() & w.GetMask();
+    bool xn = IsNegative0(w, xv);
+    bool yn = IsNegative0(w, yv);
+    if (xn != yn) {
+      c = xn ? -1 : 1;
+    } else if (xv == yv) {
+      c = 0;
+    } else {
+      c = (xv < yv) ? -1 : 1;
+    }
+  }
+  switch (op) {
+  case COMPARE_LT:
+    return c < 0;
+  case COMPARE_GT:
+    return c > 0;
+  case COMPARE_EQ:
+    return c == 0;
+  default:
     break;
   }
+  return true;
 }
 
 void Op::Minus0(const NumericValue &x, NumericValue *res) {
@@ -90,14 +223,8 @@ void Op::Minus0(const NumericValue &x, NumericValue *res) {
 }
 
 void Op::Clear(NumericWidth &w, NumericValue *val) {
-  if (w.IsWide()) {
-    if (w.IsExtraWide()) {
-      val->extra_wide_value_->Clear();
-    } else {
-      for (int i = 0; i < 8; ++i) {
-	val->value_[i] = 0;
-      }
-    }
+  if (w.IsExtraWide()) {
+    val->extra_wide_value_->Clear();
   } else {
     val->SetValue0(0);
   }
@@ -105,18 +232,8 @@ void Op::Clear(NumericWidth &w, NumericValue *val) {
 
 void Op::Set(const NumericWidth &sw, const NumericValue &src,
 	     const NumericWidth &dw, NumericValue *dst) {
-  const uint64_t *sv;
-  if (sw.IsExtraWide()) {
-    sv = src.extra_wide_value_->value_;
-  } else {
-    sv = src.value_;
-  }
-  uint64_t *dv;
-  if (dw.IsExtraWide()) {
-    dv = dst->extra_wide_value_->value_;
-  } else {
-    dv = dst->value_;
-  }
+  const uint64_t *sv = Numeric::GetLimbs(sw, src);
+  uint64_t *dv = Numeric::GetMutableLimbs(dw, dst);
   int bits = sw.GetWidth();
   if (dw.GetWidth() < bits) {
     bits = dw.GetWidth();
@@ -135,15 +252,8 @@ void Op::Set(const NumericWidth &sw, const NumericValue &src,
 
 bool Op::Eq(const NumericWidth &w, const NumericValue &v1,
 	    const NumericValue &v2) {
-  const uint64_t *s1;
-  const uint64_t *s2;
-  if (w.IsExtraWide()) {
-    s1 = v1.extra_wide_value_->value_;
-    s2 = v2.extra_wide_value_->value_;
-  } else {
-    s1 = v1.value_;
-    s2 = v2.value_;
-  }
+  const uint64_t *s1 = Numeric::GetLimbs(w, v1);
+  const uint64_t *s2 = Numeric::GetLimbs(w, v2);
   int bits = w.GetWidth();
   int a = bits / 64;
   for (int i = 0; i < a; ++i) {
@@ -21,10 +21,12 @@ enum BinOp {
   BINOP_XOR,
   BINOP_MUL,
   BINOP_DIV,
+  BINOP_MOD,
 };
 
 // NOTE:
-// * Arithmetic operations wider than 64bits may not be implemented.
+// * *0 methods are only for values up to 64 bits. Use the methods with
+//   a NumericWidth argument for wider values.
 // * Must not rely on output arg's .type_.
 // * Do not rely on input arg's .type_ as much as possible.
 // TODO: Add width argument to methods
@@ -45,6 +47,25 @@ public:
 		 const NumericValue &v2);
   static void BitInv0(const NumericValue &num, NumericValue *res);
 
+  // Arithmetic for any width. Both inputs and the result have the width
+  // w and the result is truncated to w. Signed if w.IsSigned().
+  // Division truncates toward zero and the remainder has the sign of x.
+  // Division by zero gives 0 for both.
+  static void Add(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Sub(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Minus(const NumericWidth &w, const NumericValue &x,
+		    NumericValue *a);
+  static void Mul(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Div(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Mod(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static bool Compare(enum CompareOp op, const NumericWidth &w,
+		      const NumericValue &x, const NumericValue &y);
+
   static void Clear(NumericWidth &w, NumericValue *val);
   static void Set(const NumericWidth &sw, const NumericValue &src,
 		  const NumericWidth &dw, NumericValue *dst);
@@ -1,5 +1,6 @@
 #include "numeric/numeric.h"
 #include "numeric/numeric_literal.h"
+#include "numeric/numeric_manager.h"
 #include "numeric/numeric_op.h"
 #include "numeric/numeric_value.h"
 #include "numeric/numeric_width.h"
@@ -9,6 +10,8 @@
 
 #include <assert.h>
 #include <iostream>
+#include <random>
+#include <vector>
 
 using namespace iroha;
 using namespace std;
@@ -19,16 +22,154 @@ class Tool {
 public:
   static uint64_t GetValue(const Numeric &n, int idx) {
     ASSERT(n.type_.IsWide());
-    return n.GetArray().value_[idx];
+    return Numeric::GetLimbs(n.type_, n.GetArray())[idx];
   }
 };
 
+// Reference big integer with 32 bit digits to cross check Op.
+class RefInt {
+public:
+  explicit RefInt(int width) : width_(width), d_((width + 31) / 32, 0) {
+  }
+
+  static RefInt FromNumeric(const Numeric &n) {
+    RefInt r(n.type_.GetWidth());
+    const uint64_t *limbs = Numeric::GetLimbs(n.type_, n.GetArray());
+    for (int i = 0; i < r.d_.size(); ++i) {
+      r.d_[i] = limbs[i / 2] >> ((i % 2) * 32);
+    }
+    r.Mask();
+    return r;
+  }
+
+  bool operator==(const RefInt &r) const {
+    return d_ == r.d_;
+  }
+
+  bool IsZero() const {
+    for (uint32_t d : d_) {
+      if (d) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  bool Bit(int b) const {
+    return (d_[b / 32] >> (b % 32)) & 1;
+  }
+
+  RefInt Add(const RefInt &y) const {
+    RefInt r(width_);
+    uint64_t carry = 0;
+    for (int i = 0; i < d_.size(); ++i) {
+      uint64_t s = (uint64_t)d_[i] + y.d_[i] + carry;
+      r.d_[i] = (uint32_t)s;
+      carry = s >> 32;
+    }
+    r.Mask();
+    return r;
+  }
+
+  RefInt Neg() const {
+    RefInt r(width_);
+    RefInt one(width_);
+    one.d_[0] = 1;
+    for (int i = 0; i < d_.size(); ++i) {
+      r.d_[i] = ~d_[i];
+    }
+    r.Mask();
+    return r.Add(one);
+  }
+
+  RefInt Sub(const RefInt &y) const {
+    return Add(y.Neg());
+  }
+
+  RefInt Mul(const RefInt &y) const {
+    int n = d_.size();
+    vector<uint64_t> t(n, 0);
+    for (int i = 0; i < n; ++i) {
+      uint64_t carry = 0;
+      for (int j = 0; i + j < n; ++j) {
+	uint64_t p = (uint64_t)d_[i] * y.d_[j] + t[i + j] + carry;
+	t[i + j] = (uint32_t)p;
+	carry = p >> 32;
+      }
+    }
+    RefInt r(width_);
+    for (int i = 0; i < n; ++i) {
+      r.d_[i] = t[i];
+    }
+    r.Mask();
+    return r;
+  }
+
+  bool IsNegative(bool is_signed) const {
+    return is_signed && Bit(width_ - 1);
+  }
+
+  // Returns -1, 0 or 1.
+  int Compare(const RefInt &y, bool is_signed) const {
+    bool xn = IsNegative(is_signed);
+    bool yn = y.IsNegative(is_signed);
+    if (xn != yn) {
+      return xn ? -1 : 1;
+    }
+    for (int i = d_.size() - 1; i >= 0; --i) {
+      if (d_[i] != y.d_[i]) {
+	return (d_[i] < y.d_[i]) ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  RefInt Abs(bool is_signed) const {
+    return IsNegative(is_signed) ? Neg() : *this;
+  }
+
+private:
+  void Mask() {
+    if (width_ % 32) {
+      d_.back() &= ~((~0U) << (width_ % 32));
+    }
+  }
+
+  int width_;
+  vector<uint32_t> d_;
+};
+
+Numeric MakeWide(const NumericWidth &w, const vector<uint64_t> &limbs) {
+  Numeric n;
+  n.type_ = w;
+  Numeric::MayPopulateStorage(w, nullptr, n.GetMutableArray());
+  Numeric::Clear(w, n.GetMutableArray());
+  uint64_t *v = Numeric::GetMutableLimbs(w, n.GetMutableArray());
+  for (int i = 0; i < w.GetValueCount(); ++i) {
+    v[i] = limbs[i];
+  }
+  Op::FixupValueWidth(w, n.GetMutableArray());
+  return n;
+}
+
+int64_t SignExtend(const NumericWidth &w, uint64_t v) {
+  int width = w.GetWidth();
+  if (!w.IsSigned() || width == 64) {
+    return v;
+  }
+  if ((v >> (width - 1)) & 1) {
+    return v | ((~0ULL) << width);
+  }
+  return v;
+}
+
 }  // namespace
 
 void Shift() {
   TEST_CASE("Shift");
   Numeric n;
   n.type_.SetWidth(512);
+  Numeric::MayPopulateStorage(n.type_, nullptr, n.GetMutableArray());
   Op::Clear(n.type_, n.GetMutableArray());
   n.SetValue0(0xfffffffffffffff0ULL);
   cout << "n=" << n.Format() << "\n";
@@ -37,38 +178,39 @@ void Shift() {
 
   Numeric m;
   m.type_.SetWidth(512);
+  Numeric::MayPopulateStorage(m.type_, nullptr, m.GetMutableArray());
   Op::Clear(m.type_, m.GetMutableArray());
   // Left
   cout << "Left Shift\n";
-  WideOp::Shift(n.GetArray(), 1, true, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 1, true, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(1, Tool::GetValue(m, 1));
 
-  WideOp::Shift(n.GetArray(), 64, true, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 64, true, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(0, Tool::GetValue(m, 0));
   ASSERT_EQ(Tool::GetValue(n, 0), Tool::GetValue(m, 1));
 
-  WideOp::Shift(n.GetArray(), 65, true, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 65, true, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(1, Tool::GetValue(m, 2));
 
-  WideOp::Shift(n.GetArray(), 385, true, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 385, true, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(1, Tool::GetValue(m, 7));
 
   // Right
   cout << "Right Shift\n";
-  n = m;
-  WideOp::Shift(n.GetArray(), 0, false, m.GetMutableArray());
+  Numeric::CopyValue(m, nullptr, &n);
+  WideOp::Shift(n.type_, n.GetArray(), 0, false, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(1, Tool::GetValue(m, 7));
 
-  WideOp::Shift(n.GetArray(), 64, false, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 64, false, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(1, Tool::GetValue(m, 6));
 
-  WideOp::Shift(n.GetArray(), 65, false, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 65, false, m.GetMutableArray());
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(0xfffffffffffffff0ULL, Tool::GetValue(m, 5));
 }
@@ -83,8 +225,8 @@ void Concat() {
   n.type_.SetWidth(63);
   n.SetValue0(0x5555555555555550ULL);
   Numeric r;
-  Op::Concat(m.GetArray(), m.type_, n.GetArray(), n.type_,
-	     r.GetMutableArray(), &r.type_);
+  Op::ConcatWithStorage(m.GetArray(), m.type_, n.GetArray(), n.type_,
+			nullptr, r.GetMutableArray(), &r.type_);
   cout << "r=" << r.Format() << "\n";
   ASSERT(r.type_.GetWidth() == 127);
   ASSERT_EQ(0x5555555555555550ULL, Tool::GetValue(r, 0));
@@ -94,11 +236,12 @@ void Concat() {
 void Fixup() {
   TEST_CASE("Fixup");
   Numeric n;
-  Numeric::Clear(n.type_, n.GetMutableArray());
-  n.type_.SetWidth(68);
   n.SetValue0(0xfffffffffffffff0ULL);
+  n.type_.SetWidth(68);
+  Numeric::MayExpandStorage(nullptr, &n);
   Numeric m;
-  WideOp::Shift(n.GetArray(), 16, true, m.GetMutableArray());
+  Numeric::MayPopulateStorage(n.type_, nullptr, m.GetMutableArray());
+  WideOp::Shift(n.type_, n.GetArray(), 16, true, m.GetMutableArray());
   m.type_ = n.type_;
   cout << "m=" << m.Format() << "\n";
   ASSERT_EQ(65535, Tool::GetValue(m, 1));
@@ -120,6 +263,7 @@ void Basic() {
 
   Numeric w;
   w.type_.SetWidth(512);
+  Numeric::MayPopulateStorage(w.type_, nullptr, w.GetMutableArray());
   Op::Clear(w.type_, w.GetMutableArray());
   cout << "w=" << w.Format() << "\n";
   ASSERT(Op::IsZero(w.type_, w.GetArray()));
@@ -143,8 +287,8 @@ void ExtraWide() {
   ASSERT(nn.GetValue0() == 1);
 
   Numeric m;
-  Op::SelectBits(n.GetArray(), n.type_,
-		 512, 1, m.GetMutableArray(), nullptr);
+  Op::SelectBitsWithStorage(n.GetArray(), n.type_,
+			    512, 1, nullptr, m.GetMutableArray(), &m.type_);
   ASSERT(m.GetValue0() == 1);
 }
 
@@ -173,6 +317,206 @@ void Eq() {
   ASSERT(!Op::Eq(n1.type_, n1.GetArray(), n2.GetArray()));
 }
 
+void GC() {
+  TEST_CASE("GC");
+  NumericManager *mgr = Numeric::CreateManager();
+  vector<Numeric> values;
+  for (int i = 0; i < 1000; ++i) {
+    Numeric n;
+    n.type_.SetWidth(65 + (i % 4) * 1000);
+    mgr->MayPopulateStorage(n.type_, n.GetMutableArray());
+    ASSERT(n.GetArray().extra_wide_value_->size_ >=
+	   n.type_.GetValueCount());
+    n.SetValue0(i);
+    values.push_back(n);
+  }
+  ASSERT_EQ(1000, mgr->GetNumValues());
+  mgr->StartGC();
+  for (int i = 0; i < values.size(); i += 3) {
+    mgr->MarkStorage(&values[i]);
+  }
+  // Non extra wide values and unknown addresses are ignored.
+  Numeric small;
+  mgr->MarkStorage(&small);
+  Numeric bogus;
+  bogus.type_.SetWidth(128);
+  ExtraWideValue ev;
+  bogus.GetMutableArray()->extra_wide_value_ = &ev;
+  mgr->MarkStorage(&bogus);
+  mgr->DoGC();
+  ASSERT_EQ(334, mgr->GetNumValues());
+  for (int i = 0; i < values.size(); i += 3) {
+    ASSERT_EQ(i, values[i].GetValue0());
+  }
+  // Reuses freed slots.
+  Numeric n;
+  n.type_.SetWidth(65);
+  mgr->MayPopulateStorage(n.type_, n.GetMutableArray());
+  ASSERT(n.GetValue0() == 0);
+  ASSERT_EQ(335, mgr->GetNumValues());
+  Numeric::DeleteManager(mgr);
+}
+
+void Arith0() {
+  TEST_CASE("Arith0");
+  // Exhaustive for narrow widths against int64_t arithmetic.
+  for (int width = 1; width <= 8; ++width) {
+    for (bool is_signed : {false, true}) {
+      NumericWidth w(is_signed, width);
+      uint64_t mask = w.GetMask();
+      for (uint64_t x = 0; x <= mask; ++x) {
+	for (uint64_t y = 0; y <= mask; ++y) {
+	  NumericValue xv, yv, a;
+	  xv.SetValue0(x);
+	  yv.SetValue0(y);
+	  int64_t sx = SignExtend(w, x);
+	  int64_t sy = SignExtend(w, y);
+	  Op::Add(w, xv, yv, &a);
+	  ASSERT_EQ((x + y) & mask, a.GetValue0());
+	  Op::Sub(w, xv, yv, &a);
+	  ASSERT_EQ((x - y) & mask, a.GetValue0());
+	  Op::Mul(w, xv, yv, &a);
+	  ASSERT_EQ((x * y) & mask, a.GetValue0());
+	  Op::Minus(w, xv, &a);
+	  ASSERT_EQ((-x) & mask, a.GetValue0());
+	  Op::Div(w, xv, yv, &a);
+	  ASSERT_EQ(y ? (uint64_t)(sx / sy) & mask : 0, a.GetValue0());
+	  Op::Mod(w, xv, yv, &a);
+	  ASSERT_EQ(y ? (uint64_t)(sx % sy) & mask : 0, a.GetValue0());
+	  Op::CalcBinOp(BINOP_DIV, xv, yv, w, &a);
+	  ASSERT_EQ(y ? (uint64_t)(sx / sy) & mask : 0, a.GetValue0());
+	  Op::CalcBinOp(BINOP_MOD, xv, yv, w, &a);
+	  ASSERT_EQ(y ? (uint64_t)(sx % sy) & mask : 0, a.GetValue0());
+	  ASSERT(Op::Compare(COMPARE_LT, w, xv, yv) == (sx < sy));
+	  ASSERT(Op::Compare(COMPARE_GT, w, xv, yv) == (sx > sy));
+	  ASSERT(Op::Compare(COMPARE_EQ, w, xv, yv) == (sx == sy));
+	}
+      }
+    }
+  }
+  // Overflow of the most negative value.
+  NumericWidth w(true, 64);
+  NumericValue x, y, a;
+  x.SetValue0(0x8000000000000000ULL);
+  y.SetValue0(~0ULL);
+  Op::Div(w, x, y, &a);
+  ASSERT_EQ(0x8000000000000000ULL, a.GetValue0());
+  Op::Mod(w, x, y, &a);
+  ASSERT_EQ(0, a.GetValue0());
+}
+
+void WideArith() {
+  TEST_CASE("WideArith");
+  mt19937_64 rng(1);
+  for (int width : {65, 100, 128, 129, 191, 256, 500, 1024, 2047, 4096}) {
+    for (bool is_signed : {false, true}) {
+      NumericWidth w(is_signed, width);
+      int n = w.GetValueCount();
+      // Edge values and random ones.
+      vector<vector<uint64_t> > patterns;
+      patterns.push_back(vector<uint64_t>(n, 0));
+      patterns.push_back(vector<uint64_t>(n, ~0ULL));
+      vector<uint64_t> p(n, 0);
+      p[0] = 1;
+      patterns.push_back(p);
+      p[0] = 7;
+      patterns.push_back(p);
+      p = vector<uint64_t>(n, 0);
+      p[n - 1] = 1ULL << ((width - 1) % 64);
+      patterns.push_back(p);
+      p = vector<uint64_t>(n, ~0ULL);
+      p[n - 1] = ~(1ULL << ((width - 1) % 64));
+      patterns.push_back(p);
+      p = vector<uint64_t>(n, 0);
+      p[n / 2] = ~0ULL;
+      patterns.push_back(p);
+      int num_random = (width > 1000) ? 4 : 12;
+      for (int i = 0; i < num_random; ++i) {
+	for (int j = 0; j < n; ++j) {
+	  p[j] = rng();
+	}
+	// Shorter values for divisions with non trivial quotients.
+	int len = 1 + rng() % n;
+	for (int j = len; j < n; ++j) {
+	  p[j] = 0;
+	}
+	patterns.push_back(p);
+      }
+      vector<Numeric> values;
+      for (auto &pat : patterns) {
+	values.push_back(MakeWide(w, pat));
+      }
+      Numeric a = MakeWide(w, vector<uint64_t>(n, 0));
+      Numeric b = MakeWide(w, vector<uint64_t>(n, 0));
+      for (const Numeric &x : values) {
+	RefInt rx = RefInt::FromNumeric(x);
+	Op::Minus(w, x.GetArray(), a.GetMutableArray());
+	ASSERT(RefInt::FromNumeric(a) == rx.Neg());
+	for (const Numeric &y : values) {
+	  RefInt ry = RefInt::FromNumeric(y);
+	  Op::Add(w, x.GetArray(), y.GetArray(), a.GetMutableArray());
+	  ASSERT(RefInt::FromNumeric(a) == rx.Add(ry));
+	  Op::Sub(w, x.GetArray(), y.GetArray(), a.GetMutableArray());
+	  ASSERT(RefInt::FromNumeric(a) == rx.Sub(ry));
+	  Op::Mul(w, x.GetArray(), y.GetArray(), a.GetMutableArray());
+	  ASSERT(RefInt::FromNumeric(a) == rx.Mul(ry));
+	  int c = rx.Compare(ry, is_signed);
+	  ASSERT(Op::Compare(COMPARE_LT, w, x.GetArray(), y.GetArray()) ==
+		 (c < 0));
+	  ASSERT(Op::Compare(COMPARE_GT, w, x.GetArray(), y.GetArray()) ==
+		 (c > 0));
+	  ASSERT(Op::Compare(COMPARE_EQ, w, x.GetArray(), y.GetArray()) ==
+		 (c == 0));
+	  // x == q * y + r, |r| < |y| and r has the sign of x.
+	  Op::Div(w, x.GetArray(), y.GetArray(), a.GetMutableArray());
+	  Op::Mod(w, x.GetArray(), y.GetArray(), b.GetMutableArray());
+	  RefInt q = RefInt::FromNumeric(a);
+	  RefInt r = RefInt::FromNumeric(b);
+	  if (ry.IsZero()) {
+	    ASSERT(q.IsZero() && r.IsZero());
+	    continue;
+	  }
+	  ASSERT(q.Mul(ry).Add(r) == rx);
+	  ASSERT(r.Abs(is_signed).Compare(ry.Abs(is_signed), false) < 0);
+	  ASSERT(r.IsZero() ||
+		 r.IsNegative(is_signed) == rx.IsNegative(is_signed));
+	}
+      }
+    }
+  }
+}
+
+void WideBitOp() {
+  TEST_CASE("WideBitOp");
+  NumericWidth w(false, 1000);
+  int n = w.GetValueCount();
+  vector<uint64_t> xp, yp;
+  for (int i = 0; i < n; ++i) {
+    xp.push_back(0x0123456789abcdefULL * (i + 1));
+    yp.push_back(0xfedcba9876543210ULL ^ i);
+  }
+  Numeric x = MakeWide(w, xp);
+  Numeric y = MakeWide(w, yp);
+  Numeric a = MakeWide(w, vector<uint64_t>(n, 0));
+  for (BinOp op : {BINOP_AND, BINOP_OR, BINOP_XOR}) {
+    Op::CalcBinOp(op, x.GetArray(), y.GetArray(), w, a.GetMutableArray());
+    const uint64_t *av = Numeric::GetLimbs(w, a.GetArray());
+    const uint64_t *xv = Numeric::GetLimbs(w, x.GetArray());
+    const uint64_t *yv = Numeric::GetLimbs(w, y.GetArray());
+    for (int i = 0; i < n; ++i) {
+      uint64_t e;
+      if (op == BINOP_AND) {
+	e = xv[i] & yv[i];
+      } else if (op == BINOP_OR) {
+	e = xv[i] | yv[i];
+      } else {
+	e = xv[i] ^ yv[i];
+      }
+      ASSERT_EQ(e, av[i]);
+    }
+  }
+}
+
 void Literal() {
   TEST_CASE("Literal");
   NumericLiteral nl;
@@ -208,6 +552,10 @@ int main(int argc, char **argv) {
   Set();
   Eq();
   Literal();
+  GC();
+  Arith0();
+  WideArith();
+  WideBitOp();
 
   return 0;
 }
@@ -2,8 +2,16 @@
 
 namespace iroha {
 
+int ExtraWideValue::GetSizeClass(int limbs) {
+  int c = 0;
+  while (c < kNumSizeClasses - 1 && GetClassLimbs(c) < limbs) {
+    ++c;
+  }
+  return c;
+}
+
 void ExtraWideValue::Clear() {
-  for (int i = 0; i < 32; ++i) {
+  for (int i = 0; i < size_; ++i) {
     value_[i] = 0;
   }
 }
@@ -8,21 +8,40 @@ namespace iroha {
 
 class NumericManager;
 
+// Storage for values wider than 64 bits.
+//
+// A NumericManager allocates only the first GetClassLimbs() limbs of
+// value_ for the size class of the width. Temporary values on the stack
+// have all kMaxLimbs limbs.
 class ExtraWideValue {
 public:
+  // Up to 4096 bits.
+  static const int kMaxLimbs = 64;
+  // 128, 256, 512, 1024, 2048 and 4096 bits.
+  static const int kNumSizeClasses = 6;
+
+  ExtraWideValue() : owner_(nullptr), size_(kMaxLimbs) {}
+
+  static int GetSizeClass(int limbs);
+  static int GetClassLimbs(int size_class) {
+    return 2 << size_class;
+  }
+
+  // Clears size_ limbs.
   void Clear();
 
-  uint64_t value_[32];
   NumericManager *owner_;
+  // Number of limbs available in value_.
+  int size_;
+  uint64_t value_[kMaxLimbs];
 };
 
 class NumericValue {
 public:
   union {
-    // 512 bit storage as default and use extra wide_values_ if the
-    // width is wider than 512.
-    // (We might change 512 to just 64 later)
-    uint64_t value_[8];
+    // Values up to 64 bits are stored inline and wider values use
+    // extra_wide_value_ allocated by a NumericManager.
+    uint64_t value_[1];
     ExtraWideValue *extra_wide_value_;
   };
   // Only for non wide values.
@@ -32,15 +32,7 @@ void NumericWidth::SetWidth(int width) {
   } else {
     value_count_ = 1;
   }
-  is_extra_wide_ = false;
-  if (value_count_ > 1) {
-    if (value_count_ > 8) {
-      is_extra_wide_ = true;
-    }
-    is_wide_ = true;
-  } else {
-    is_wide_ = false;
-  }
+  is_wide_ = (value_count_ > 1);
 }
 
 void NumericWidth::SetIsSigned(bool is_signed) {
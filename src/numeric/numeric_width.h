@@ -33,18 +33,19 @@ public:
   int GetValueCount() const {
     return value_count_;
   }
+  // Wider than 64 bits.
   bool IsWide() const {
     return is_wide_;
   }
+  // Same as IsWide(). The value is stored in an ExtraWideValue.
   bool IsExtraWide() const {
-    return is_extra_wide_;
+    return is_wide_;
   }
   std::string Format() const;
 
 private:
   bool is_signed_;
   bool is_wide_;
-  bool is_extra_wide_;
   int value_count_;
   int width_;
   uint64_t mask_;
@@ -3,18 +3,61 @@
 #include "numeric/numeric.h"
 #include "numeric/numeric_op.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define USE_AVX2_KERNEL 1
+#endif
+
 namespace iroha {
 
-bool WideOp::IsZero(const NumericWidth &w, const NumericValue &val) {
-  const uint64_t *v;
-  int s;
-  if (w.IsExtraWide()) {
-    s = 32;
-    v = val.extra_wide_value_->value_;
-  } else {
-    s = 8;
-    v = val.value_;
+namespace {
+
+const int kMaxLimbs = ExtraWideValue::kMaxLimbs;
+
+template<class F>
+void BitOpLoop(const uint64_t *x, const uint64_t *y, int n, uint64_t *r,
+	       F f) {
+  for (int i = 0; i < n; ++i) {
+    r[i] = f(x[i], y[i]);
+  }
+}
+
+#ifdef USE_AVX2_KERNEL
+bool HasAvx2() {
+  static const bool has_avx2 = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return has_avx2;
+}
+
+// Processes 4 limbs at once and returns the number of processed limbs.
+__attribute__((target("avx2")))
+int BinBitOpAvx2(enum BinOp op, const uint64_t *x, const uint64_t *y, int n,
+		 uint64_t *r) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(x + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(y + i));
+    __m256i c;
+    if (op == BINOP_AND) {
+      c = _mm256_and_si256(a, b);
+    } else if (op == BINOP_OR) {
+      c = _mm256_or_si256(a, b);
+    } else {
+      c = _mm256_xor_si256(a, b);
+    }
+    _mm256_storeu_si256((__m256i *)(r + i), c);
   }
+  return i;
+}
+#endif
+
+}  // namespace
+
+bool WideOp::IsZero(const NumericWidth &w, const NumericValue &val) {
+  const uint64_t *v = Numeric::GetLimbs(w, val);
+  int s = Numeric::GetLimbCount(w);
   for (int i = 0; i < s; ++i) {
     if (v[i] > 0) {
       return false;
@@ -23,26 +66,16 @@ bool WideOp::IsZero(const NumericWidth &w, const NumericValue &val) {
   return true;
 }
 
-void WideOp::Shift(const NumericValue &s, int amount, bool left,
-		   NumericValue *res) {
-  int a64 = amount / 64;
-  uint64_t tv[8];
-  ShiftArray(s.value_, 8, a64, left, tv);
-
-  int a1 = amount % 64;
-  uint64_t *rv = res->value_;
-  ShiftLocal(tv, 8, a1, left, rv);
-}
-
-void WideOp::ShiftExtraWide(const NumericValue &s, int amount, bool left,
-			    NumericValue *res) {
+void WideOp::Shift(const NumericWidth &w, const NumericValue &s,
+		   int amount, bool left, NumericValue *res) {
+  int len = Numeric::GetLimbCount(w);
   int a64 = amount / 64;
-  uint64_t tv[32];
-  ShiftArray(s.extra_wide_value_->value_, 32, a64, left, tv);
+  uint64_t tv[ExtraWideValue::kMaxLimbs];
+  ShiftArray(s.extra_wide_value_->value_, len, a64, left, tv);
 
   int a1 = amount % 64;
   uint64_t *rv = res->extra_wide_value_->value_;
-  ShiftLocal(tv, 32, a1, left, rv);
+  ShiftLocal(tv, len, a1, left, rv);
 }
 
 void WideOp::ShiftArray(const uint64_t *sv, int len, int amount, bool left,
@@ -96,32 +129,35 @@ void WideOp::ShiftLocal(const uint64_t *tv, int len, int amount, bool left,
   }
 }
 
-void WideOp::BinBitOp(enum BinOp op, const NumericValue &x,
-		      const NumericValue &y, NumericValue *res) {
-  uint64_t *rv = res->value_;
-  const uint64_t *xv = x.value_;
-  const uint64_t *yv = y.value_;
+void WideOp::BinBitOp(enum BinOp op, const NumericWidth &w,
+		      const NumericValue &x, const NumericValue &y,
+		      NumericValue *res) {
+  uint64_t *rv = Numeric::GetMutableLimbs(w, res);
+  const uint64_t *xv = Numeric::GetLimbs(w, x);
+  const uint64_t *yv = Numeric::GetLimbs(w, y);
+  int s = w.GetValueCount();
+  if (op != BINOP_AND && op != BINOP_OR && op != BINOP_XOR) {
+    return;
+  }
+  int done = 0;
+#ifdef USE_AVX2_KERNEL
+  if (s >= 4 && HasAvx2()) {
+    done = BinBitOpAvx2(op, xv, yv, s, rv);
+  }
+#endif
+  xv += done;
+  yv += done;
+  rv += done;
+  s -= done;
   switch (op) {
   case BINOP_AND:
-    {
-      for (int i = 0; i < 8; ++i) {
-	rv[i] = xv[i] & yv[i];
-      }
-    }
+    BitOpLoop(xv, yv, s, rv, [](uint64_t a, uint64_t b) { return a & b; });
     break;
   case BINOP_OR:
-    {
-      for (int i = 0; i < 8; ++i) {
-	rv[i] = xv[i] | yv[i];
-      }
-    }
+    BitOpLoop(xv, yv, s, rv, [](uint64_t a, uint64_t b) { return a | b; });
     break;
   case BINOP_XOR:
-    {
-      for (int i = 0; i < 8; ++i) {
-	rv[i] = xv[i] ^ yv[i];
-      }
-    }
+    BitOpLoop(xv, yv, s, rv, [](uint64_t a, uint64_t b) { return a ^ b; });
     break;
   default:
     break;
@@ -130,61 +166,41 @@ void WideOp::BinBitOp(enum BinOp op, const NumericValue &x,
 
 void WideOp::SelectBits(const NumericValue &val, const NumericWidth &w,
 			int h, int l, NumericValue *res) {
-  if (w.IsExtraWide()) {
-    int rw = (h - l + 1);
-    ExtraWideValue tmp;
-    if (rw <= 512) {
-      // Source is extra wide but the result is not. So, use a tmp value
-      // to get the result and shrink it.
-      res->extra_wide_value_ = &tmp;
-    }
-    ShiftExtraWide(val, l, false, res);
-    if (rw <= 512) {
-      for (int i = 0; i < 8; ++i) {
-	res->value_[i] = tmp.value_[i];
-      }
-    }
-  } else {
-    Shift(val, l, false, res);
+  // Uses a tmp value to get the result, since the result may have
+  // smaller storage than the source.
+  ExtraWideValue tmp;
+  tmp.Clear();
+  NumericValue t;
+  t.extra_wide_value_ = &tmp;
+  Shift(w, val, l, false, &t);
+  NumericWidth rw(false, h - l + 1);
+  uint64_t *rv = Numeric::GetMutableLimbs(rw, res);
+  int s = Numeric::GetLimbCount(rw);
+  for (int i = 0; i < s; ++i) {
+    rv[i] = tmp.value_[i];
   }
+  FixupWidth(rw, res);
 }
 
 void WideOp::Concat(const NumericValue &x, const NumericWidth &xw,
 		    const NumericValue &y, const NumericWidth &yw,
 		    NumericValue *a, NumericWidth *aw) {
   // Sets x.
-  NumericValue tmp;
-  ExtraWideValue ev;
   NumericWidth w = NumericWidth(false, xw.GetWidth() + yw.GetWidth());
-  if (w.IsExtraWide()) {
-    tmp.extra_wide_value_ = &ev;
-    NumericValue xc = x;
-    ExtraWideValue xtmp;
-    if (xw.IsExtraWide()) {
-      xc = x;
-    } else {
-      xc.extra_wide_value_ = &xtmp;
-      Op::Set(xw, x, w, &xc);
-    }
-    ShiftExtraWide(xc, yw.GetWidth(), true, &tmp);
-  } else {
-    Shift(x, yw.GetWidth(), true, &tmp);
-  }
+  ExtraWideValue xtmp;
+  xtmp.Clear();
+  NumericValue xc;
+  xc.extra_wide_value_ = &xtmp;
+  Op::Set(xw, x, w, &xc);
+  ExtraWideValue ev;
+  NumericValue tmp;
+  tmp.extra_wide_value_ = &ev;
+  Shift(w, xc, yw.GetWidth(), true, &tmp);
   Numeric::Clear(w, a);
   Op::Set(w, tmp, w, a);
   // Sets y.
-  uint64_t *av;
-  const uint64_t *yv;
-  if (w.IsExtraWide()) {
-    av = a->extra_wide_value_->value_;
-  } else {
-    av = a->value_;
-  }
-  if (yw.IsExtraWide()) {
-    yv = y.extra_wide_value_->value_;
-  } else {
-    yv = y.value_;
-  }
+  uint64_t *av = Numeric::GetMutableLimbs(w, a);
+  const uint64_t *yv = Numeric::GetLimbs(yw, y);
   int m = yw.GetWidth() / 64;
   for (int i = 0; i < m; ++i) {
     av[i] = yv[i];
@@ -202,21 +218,234 @@ void WideOp::Concat(const NumericValue &x, const NumericWidth &xw,
 
 void WideOp::FixupWidth(const NumericWidth &w, NumericValue *val) {
   uint64_t mask = ~0;
-  mask >>= (64 - (w.GetWidth() % 64));
-  int value_count = w.GetValueCount();
-  uint64_t *rv;
-  int s;
-  if (w.IsExtraWide()) {
-    rv = val->extra_wide_value_->value_;
-    s = 32;
-  } else {
-    rv = val->value_;
-    s = 8;
+  if (w.GetWidth() % 64) {
+    mask >>= (64 - (w.GetWidth() % 64));
   }
+  int value_count = w.GetValueCount();
+  uint64_t *rv = Numeric::GetMutableLimbs(w, val);
+  int s = Numeric::GetLimbCount(w);
   for (int i = value_count; i < s; ++i) {
     rv[i] = 0;
   }
   rv[value_count - 1] &= mask;
 }
 
+void WideOp::Add(const NumericWidth &w, const NumericValue &x,
+		 const NumericValue &y, NumericValue *a) {
+  uint64_t xv[kMaxLimbs], yv[kMaxLimbs], av[kMaxLimbs];
+  Load(w, x, xv);
+  Load(w, y, yv);
+  AddArray(xv, yv, 0, w.GetValueCount(), av);
+  Store(w, av, a);
+}
+
+void WideOp::Sub(const NumericWidth &w, const NumericValue &x,
+		 const NumericValue &y, NumericValue *a) {
+  uint64_t xv[kMaxLimbs], yv[kMaxLimbs], av[kMaxLimbs];
+  Load(w, x, xv);
+  Load(w, y, yv);
+  int n = w.GetValueCount();
+  // x + ~y + 1
+  for (int i = 0; i < n; ++i) {
+    yv[i] = ~yv[i];
+  }
+  AddArray(xv, yv, 1, n, av);
+  Store(w, av, a);
+}
+
+void WideOp::Minus(const NumericWidth &w, const NumericValue &x,
+		   NumericValue *a) {
+  uint64_t xv[kMaxLimbs], av[kMaxLimbs];
+  Load(w, x, xv);
+  NegateArray(xv, w.GetValueCount(), av);
+  Store(w, av, a);
+}
+
+void WideOp::Mul(const NumericWidth &w, const NumericValue &x,
+		 const NumericValue &y, NumericValue *a) {
+  // Lower bits of the product don't depend on the signedness.
+  uint64_t xv[kMaxLimbs], yv[kMaxLimbs], av[kMaxLimbs];
+  Load(w, x, xv);
+  Load(w, y, yv);
+  MulArray(xv, yv, w.GetValueCount(), av);
+  Store(w, av, a);
+}
+
+void WideOp::DivMod(const NumericWidth &w, const NumericValue &x,
+		    const NumericValue &y, NumericValue *q, NumericValue *r) {
+  uint64_t xv[kMaxLimbs], yv[kMaxLimbs], qv[kMaxLimbs], rv[kMaxLimbs];
+  Load(w, x, xv);
+  Load(w, y, yv);
+  int n = w.GetValueCount();
+  bool y_zero = true;
+  for (int i = 0; i < n; ++i) {
+    qv[i] = 0;
+    rv[i] = 0;
+    if (yv[i]) {
+      y_zero = false;
+    }
+  }
+  if (!y_zero) {
+    // Divides magnitudes and fixes the signs.
+    bool xn = IsNegative(w, xv);
+    bool yn = IsNegative(w, yv);
+    if (xn) {
+      NegateArray(xv, n, xv);
+      MaskTop(w, xv);
+    }
+    if (yn) {
+      NegateArray(yv, n, yv);
+      MaskTop(w, yv);
+    }
+    DivModArray(xv, yv, n, qv, rv);
+    if (xn != yn) {
+      NegateArray(qv, n, qv);
+    }
+    if (xn) {
+      NegateArray(rv, n, rv);
+    }
+  }
+  if (q != nullptr) {
+    Store(w, qv, q);
+  }
+  if (r != nullptr) {
+    Store(w, rv, r);
+  }
+}
+
+int WideOp::Compare(const NumericWidth &w, const NumericValue &x,
+		    const NumericValue &y) {
+  uint64_t xv[kMaxLimbs], yv[kMaxLimbs];
+  Load(w, x, xv);
+  Load(w, y, yv);
+  bool xn = IsNegative(w, xv);
+  bool yn = IsNegative(w, yv);
+  if (xn != yn) {
+    return xn ? -1 : 1;
+  }
+  // Two's complement values with the same sign are ordered as unsigned.
+  return CompareArray(xv, yv, w.GetValueCount());
+}
+
+void WideOp::Load(const NumericWidth &w, const NumericValue &v,
+		  uint64_t *a) {
+  const uint64_t *sv = Numeric::GetLimbs(w, v);
+  int n = w.GetValueCount();
+  for (int i = 0; i < n; ++i) {
+    a[i] = sv[i];
+  }
+  MaskTop(w, a);
+}
+
+void WideOp::Store(const NumericWidth &w, const uint64_t *a,
+		   NumericValue *v) {
+  uint64_t *rv = Numeric::GetMutableLimbs(w, v);
+  int n = w.GetValueCount();
+  for (int i = 0; i < n; ++i) {
+    rv[i] = a[i];
+  }
+  FixupWidth(w, v);
+}
+
+bool WideOp::IsNegative(const NumericWidth &w, const uint64_t *a) {
+  if (!w.IsSigned()) {
+    return false;
+  }
+  int b = w.GetWidth() - 1;
+  return (a[b / 64] >> (b % 64)) & 1;
+}
+
+void WideOp::MaskTop(const NumericWidth &w, uint64_t *a) {
+  int r = w.GetWidth() % 64;
+  if (r > 0) {
+    a[w.GetValueCount() - 1] &= ~((~0ULL) << r);
+  }
+}
+
+uint64_t WideOp::AddArray(const uint64_t *x, const uint64_t *y,
+			  uint64_t carry, int n, uint64_t *a) {
+  for (int i = 0; i < n; ++i) {
+    uint64_t s = x[i] + y[i];
+    uint64_t c = (s < x[i]);
+    a[i] = s + carry;
+    carry = c | (a[i] < s);
+  }
+  return carry;
+}
+
+void WideOp::NegateArray(const uint64_t *x, int n, uint64_t *a) {
+  // ~x + 1
+  uint64_t carry = 1;
+  for (int i = 0; i < n; ++i) {
+    uint64_t v = ~x[i];
+    a[i] = v + carry;
+    carry = (a[i] < v);
+  }
+}
+
+void WideOp::MulArray(const uint64_t *x, const uint64_t *y, int n,
+		      uint64_t *a) {
+  // Schoolbook multiplication truncated to n limbs.
+  uint64_t t[kMaxLimbs];
+  for (int i = 0; i < n; ++i) {
+    t[i] = 0;
+  }
+  for (int i = 0; i < n; ++i) {
+    if (x[i] == 0) {
+      continue;
+    }
+    uint64_t carry = 0;
+    for (int j = 0; i + j < n; ++j) {
+      unsigned __int128 p = (unsigned __int128)x[i] * y[j];
+      p += t[i + j];
+      p += carry;
+      t[i + j] = (uint64_t)p;
+      carry = (uint64_t)(p >> 64);
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    a[i] = t[i];
+  }
+}
+
+void WideOp::DivModArray(const uint64_t *x, const uint64_t *y, int n,
+			 uint64_t *q, uint64_t *r) {
+  // Restoring division bit by bit from the highest set bit of x.
+  for (int i = 0; i < n; ++i) {
+    q[i] = 0;
+    r[i] = 0;
+  }
+  int top = n * 64 - 1;
+  while (top >= 0 && !((x[top / 64] >> (top % 64)) & 1)) {
+    --top;
+  }
+  uint64_t ny[kMaxLimbs];
+  for (int i = 0; i < n; ++i) {
+    ny[i] = ~y[i];
+  }
+  for (int b = top; b >= 0; --b) {
+    // r = (r << 1) | bit b of x.
+    uint64_t c = (x[b / 64] >> (b % 64)) & 1;
+    for (int i = 0; i < n; ++i) {
+      uint64_t next = r[i] >> 63;
+      r[i] = (r[i] << 1) | c;
+      c = next;
+    }
+    // c is the bit shifted out, so r is larger than y if it is set.
+    if (c || CompareArray(r, y, n) >= 0) {
+      AddArray(r, ny, 1, n, r);
+      q[b / 64] |= (1ULL << (b % 64));
+    }
+  }
+}
+
+int WideOp::CompareArray(const uint64_t *x, const uint64_t *y, int n) {
+  for (int i = n - 1; i >= 0; --i) {
+    if (x[i] != y[i]) {
+      return (x[i] < y[i]) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
 }  // namespace iroha
@@ -10,12 +10,12 @@ namespace iroha {
 class WideOp {
 public:
   static bool IsZero(const NumericWidth &w, const NumericValue &val);
-  static void Shift(const NumericValue &s, int amount, bool left,
-		    NumericValue *res);
-  static void ShiftExtraWide(const NumericValue &s, int amount, bool left,
-			     NumericValue *res);
-  static void BinBitOp(enum BinOp op, const NumericValue &x,
-		       const NumericValue &y, NumericValue *res);
+  // s and res have storage for w.
+  static void Shift(const NumericWidth &w, const NumericValue &s,
+		    int amount, bool left, NumericValue *res);
+  static void BinBitOp(enum BinOp op, const NumericWidth &w,
+		       const NumericValue &x, const NumericValue &y,
+		       NumericValue *res);
   static void SelectBits(const NumericValue &val, const NumericWidth &w,
 			 int h, int l,
 			 NumericValue *res);
@@ -24,7 +24,40 @@ public:
 		     NumericValue *a, NumericWidth *aw);
   static void FixupWidth(const NumericWidth &w, NumericValue *val);
 
+  // See Op::Add() and so on.
+  static void Add(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Sub(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  static void Minus(const NumericWidth &w, const NumericValue &x,
+		    NumericValue *a);
+  static void Mul(const NumericWidth &w, const NumericValue &x,
+		  const NumericValue &y, NumericValue *a);
+  // q or r can be nullptr.
+  static void DivMod(const NumericWidth &w, const NumericValue &x,
+		     const NumericValue &y, NumericValue *q, NumericValue *r);
+  // Returns -1, 0 or 1.
+  static int Compare(const NumericWidth &w, const NumericValue &x,
+		     const NumericValue &y);
+
 private:
+  // Copies limbs of v masked to the width.
+  static void Load(const NumericWidth &w, const NumericValue &v,
+		   uint64_t *a);
+  static void Store(const NumericWidth &w, const uint64_t *a,
+		    NumericValue *v);
+  static bool IsNegative(const NumericWidth &w, const uint64_t *a);
+  static void MaskTop(const NumericWidth &w, uint64_t *a);
+  // Kernels on n limbs.
+  static uint64_t AddArray(const uint64_t *x, const uint64_t *y,
+			   uint64_t carry, int n, uint64_t *a);
+  static void NegateArray(const uint64_t *x, int n, uint64_t *a);
+  static void MulArray(const uint64_t *x, const uint64_t *y, int n,
+		       uint64_t *a);
+  static void DivModArray(const uint64_t *x, const uint64_t *y, int n,
+			  uint64_t *q, uint64_t *r);
+  static int CompareArray(const uint64_t *x, const uint64_t *y, int n);
+
   static void ShiftArray(const uint64_t *sv, int len, int amount, bool left,
 			 uint64_t *tv);
   static void ShiftLocal(const uint64_t *tv, int len, int amount, bool left,
@@ -0,0 +1,138 @@
+#include "opt/analysis_manager.h"
+
+#include "iroha/i_design.h"
+#include "iroha/stl_util.h"
+#include "opt/bb_set.h"
+#include "opt/data_flow.h"
+#include "opt/dominator_tree.h"
+#include "opt/loop/loop_block.h"
+
+namespace iroha {
+namespace opt {
+
+struct AnalysisManager::TableAnalyses {
+  TableAnalyses() : num_states(0) {}
+
+  // Number of states when the analyses were computed to detect obviously
+  // stale ones.
+  int num_states;
+  unique_ptr<BBSet> bset;
+  unique_ptr<BBSet> split_bset;
+  unique_ptr<DataFlow> data_flow;
+  unique_ptr<DominatorTree> dom_tree;
+  // nullptr values for registers which don't form loops.
+  map<IRegister *, loop::LoopBlock *> loops;
+};
+
+AnalysisManager::AnalysisManager(DebugAnnotation *annotation)
+  : annotation_(annotation) {
+}
+
+AnalysisManager::~AnalysisManager() {
+  InvalidateAll(ANALYSIS_NONE);
+  STLDeleteSecondElements(&tables_);
+}
+
+BBSet *AnalysisManager::GetBBSet(ITable *table, bool splitMultiCycle) {
+  TableAnalyses *ta = GetTableAnalyses(table);
+  unique_ptr<BBSet> &bset = splitMultiCycle ? ta->split_bset : ta->bset;
+  if (bset.get() == nullptr) {
+    bset.reset(BBSet::Create(table, splitMultiCycle, annotation_));
+  }
+  return bset.get();
+}
+
+DataFlow *AnalysisManager::GetDataFlow(ITable *table) {
+  TableAnalyses *ta = GetTableAnalyses(table);
+  if (ta->data_flow.get() == nullptr) {
+    ta->data_flow.reset(DataFlow::Create(GetBBSet(table, false),
+					 annotation_));
+  }
+  return ta->data_flow.get();
+}
+
+DominatorTree *AnalysisManager::GetDominatorTree(ITable *table) {
+  TableAnalyses *ta = GetTableAnalyses(table);
+  if (ta->dom_tree.get() == nullptr) {
+    ta->dom_tree.reset(DominatorTree::Create(GetBBSet(table, false),
+					     annotation_));
+  }
+  return ta->dom_tree.get();
+}
+
+loop::LoopBlock *AnalysisManager::GetLoopBlock(ITable *table,
+					       IRegister *reg) {
+  TableAnalyses *ta = GetTableAnalyses(table);
+  auto it = ta->loops.find(reg);
+  if (it != ta->loops.end()) {
+    return it->second;
+  }
+  loop::LoopBlock *lb = new loop::LoopBlock(table, reg);
+  if (!lb->Build()) {
+    delete lb;
+    lb = nullptr;
+  }
+  ta->loops[reg] = lb;
+  return lb;
+}
+
+void AnalysisManager::Invalidate(ITable *table, int preserved) {
+  TableAnalyses *ta = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = tables_.find(table);
+    if (it == tables_.end()) {
+      return;
+    }
+    ta = it->second;
+  }
+  Invalidate(ta, preserved);
+}
+
+void AnalysisManager::InvalidateAll(int preserved) {
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto &p : tables_) {
+    Invalidate(p.second, preserved);
+  }
+}
+
+AnalysisManager::TableAnalyses *
+AnalysisManager::GetTableAnalyses(ITable *table) {
+  TableAnalyses *ta;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    TableAnalyses *&t = tables_[table];
+    if (t == nullptr) {
+      t = new TableAnalyses;
+    }
+    ta = t;
+  }
+  if (ta->num_states != table->states_.size()) {
+    // States were added or removed without invalidation.
+    Invalidate(ta, ANALYSIS_NONE);
+    ta->num_states = table->states_.size();
+  }
+  return ta;
+}
+
+void AnalysisManager::Invalidate(TableAnalyses *ta, int preserved) {
+  if (!(preserved & ANALYSIS_BB_SET)) {
+    // Other analyses refer BBs.
+    preserved &= ~(ANALYSIS_DATA_FLOW | ANALYSIS_DOMINATOR_TREE);
+    ta->bset.reset();
+    ta->split_bset.reset();
+  }
+  if (!(preserved & ANALYSIS_DATA_FLOW)) {
+    ta->data_flow.reset();
+  }
+  if (!(preserved & ANALYSIS_DOMINATOR_TREE)) {
+    ta->dom_tree.reset();
+  }
+  if (!(preserved & ANALYSIS_LOOP)) {
+    STLDeleteSecondElements(&ta->loops);
+    ta->loops.clear();
+  }
+}
+
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,69 @@
+// -*- C++ -*-
+//
+// Caches analyses of each table so that phases and their sub passes can
+// share them instead of recomputing identical results.
+//
+// Optimizer owns the manager and drops the analyses which are not
+// preserved by a phase after it runs. Code modifying a table in the middle
+// of a phase has to call Invalidate() for the table.
+//
+// Analyses of different tables can be requested from different threads.
+//
+#ifndef _opt_analysis_manager_h_
+#define _opt_analysis_manager_h_
+
+#include "opt/common.h"
+
+#include <mutex>
+
+namespace iroha {
+namespace opt {
+
+namespace loop {
+class LoopBlock;
+}  // namespace loop
+
+class AnalysisManager {
+public:
+  // Bits to specify analyses to preserve.
+  enum AnalysisKind {
+    ANALYSIS_NONE = 0,
+    // BBSet and analyses depending on it.
+    ANALYSIS_BB_SET = 1,
+    // Depends on insn outputs.
+    ANALYSIS_DATA_FLOW = 2,
+    ANALYSIS_DOMINATOR_TREE = 4,
+    // Depends on insn operands.
+    ANALYSIS_LOOP = 8,
+    ANALYSIS_ALL = 15,
+  };
+
+  AnalysisManager(DebugAnnotation *annotation);
+  ~AnalysisManager();
+
+  // Objects are owned by the manager and valid until invalidated.
+  BBSet *GetBBSet(ITable *table, bool splitMultiCycle);
+  // Computed on the BBSet without splitting multi cycle states.
+  DataFlow *GetDataFlow(ITable *table);
+  DominatorTree *GetDominatorTree(ITable *table);
+  // nullptr if reg doesn't form a loop.
+  loop::LoopBlock *GetLoopBlock(ITable *table, IRegister *reg);
+
+  // Drops analyses of the table except preserved ones.
+  void Invalidate(ITable *table, int preserved = ANALYSIS_NONE);
+  void InvalidateAll(int preserved);
+
+private:
+  struct TableAnalyses;
+  TableAnalyses *GetTableAnalyses(ITable *table);
+  static void Invalidate(TableAnalyses *ta, int preserved);
+
+  DebugAnnotation *annotation_;
+  std::mutex mu_;
+  map<ITable *, TableAnalyses *> tables_;
+};
+
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_analysis_manager_h_
@@ -0,0 +1,144 @@
+// -*- C++ -*-
+#ifndef _opt_bit_vector_h_
+#define _opt_bit_vector_h_
+
+#include "opt/common.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+
+// Set of non negative integers (e.g. dense numbers of RegDefs) packed
+// in 64 bit words. Only non zero words are kept sorted by their index, so
+// a set with a few members out of a large universe stays small.
+class BitVector {
+public:
+  bool Get(int i) const {
+    auto it = lower_bound(index_.begin(), index_.end(), i / 64);
+    if (it == index_.end() || *it != i / 64) {
+      return false;
+    }
+    return (words_[it - index_.begin()] >> (i % 64)) & 1;
+  }
+
+  void Set(int i) {
+    int w = i / 64;
+    auto it = lower_bound(index_.begin(), index_.end(), w);
+    int pos = it - index_.begin();
+    if (it == index_.end() || *it != w) {
+      index_.insert(it, w);
+      words_.insert(words_.begin() + pos, 0);
+    }
+    words_[pos] |= (1ULL << (i % 64));
+  }
+
+  // Returns true if this is changed.
+  bool UnionWith(const BitVector &v) {
+    if (v.index_.empty()) {
+      return false;
+    }
+    vector<int> index;
+    vector<uint64_t> words;
+    index.reserve(index_.size() + v.index_.size());
+    words.reserve(index_.size() + v.index_.size());
+    bool changed = false;
+    int i = 0, j = 0;
+    while (i < index_.size() || j < v.index_.size()) {
+      if (j == v.index_.size() ||
+	  (i < index_.size() && index_[i] < v.index_[j])) {
+	index.push_back(index_[i]);
+	words.push_back(words_[i]);
+	++i;
+      } else if (i == index_.size() || v.index_[j] < index_[i]) {
+	index.push_back(v.index_[j]);
+	words.push_back(v.words_[j]);
+	changed = true;
+	++j;
+      } else {
+	uint64_t u = words_[i] | v.words_[j];
+	changed |= (u != words_[i]);
+	index.push_back(index_[i]);
+	words.push_back(u);
+	++i;
+	++j;
+      }
+    }
+    if (changed) {
+      index_.swap(index);
+      words_.swap(words);
+    }
+    return changed;
+  }
+
+  // Clears [lo, hi).
+  void ClearRange(int lo, int hi) {
+    if (lo >= hi) {
+      return;
+    }
+    auto begin = lower_bound(index_.begin(), index_.end(), lo / 64);
+    int i = begin - index_.begin();
+    int removed = 0;
+    int dst = i;
+    for (; i < index_.size() && index_[i] * 64 < hi; ++i) {
+      int base = index_[i] * 64;
+      uint64_t mask = ~0ULL;
+      if (lo > base) {
+	mask &= (~0ULL) << (lo - base);
+      }
+      if (hi < base + 64) {
+	mask &= ~((~0ULL) << (hi - base));
+      }
+      uint64_t w = words_[i] & ~mask;
+      if (w == 0) {
+	++removed;
+	continue;
+      }
+      index_[dst] = index_[i];
+      words_[dst] = w;
+      ++dst;
+    }
+    if (removed > 0) {
+      index_.erase(index_.begin() + dst, index_.begin() + i);
+      words_.erase(words_.begin() + dst, words_.begin() + i);
+    }
+  }
+
+  bool operator==(const BitVector &v) const {
+    return index_ == v.index_ && words_ == v.words_;
+  }
+
+  bool operator!=(const BitVector &v) const {
+    return !(*this == v);
+  }
+
+  bool IsEmpty() const {
+    return index_.empty();
+  }
+
+  void Clear() {
+    index_.clear();
+    words_.clear();
+  }
+
+  // Appends members in ascending order.
+  void GetMembers(vector<int> *members) const {
+    for (int k = 0; k < index_.size(); ++k) {
+      uint64_t w = words_[k];
+      while (w) {
+	int b = __builtin_ctzll(w);
+	members->push_back(index_[k] * 64 + b);
+	w &= w - 1;
+      }
+    }
+  }
+
+private:
+  vector<int> index_;
+  vector<uint64_t> words_;
+};
+
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_bit_vector_h_
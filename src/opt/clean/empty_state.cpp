@@ -15,6 +15,10 @@ Phase *CleanEmptyStatePhase::Create() {
   return new CleanEmptyStatePhase();
 }
 
+bool CleanEmptyStatePhase::IsTableLocal() {
+  return true;
+}
+
 bool CleanEmptyStatePhase::ApplyForTable(const string &key, ITable *table) {
   CleanEmptyState shrink(table, annotation_);
   return shrink.Perform();
@@ -16,6 +16,7 @@ public:
   virtual ~CleanEmptyStatePhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
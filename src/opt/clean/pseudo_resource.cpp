@@ -14,6 +14,10 @@ Phase *CleanPseudoResourcePhase::Create() {
   return new CleanPseudoResourcePhase();
 }
 
+bool CleanPseudoResourcePhase::IsTableLocal() {
+  return true;
+}
+
 bool CleanPseudoResourcePhase::ApplyForTable(const string &key, ITable *table) {
   for (IState *st : table->states_) {
     vector<IInsn *> real_insns;
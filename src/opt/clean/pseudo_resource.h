@@ -13,6 +13,7 @@ public:
   virtual ~CleanPseudoResourcePhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
@@ -14,6 +14,10 @@ Phase *CleanUnreachableStatePhase::Create() {
   return new CleanUnreachableStatePhase();
 }
 
+bool CleanUnreachableStatePhase::IsTableLocal() {
+  return true;
+}
+
 bool CleanUnreachableStatePhase::ApplyForTable(const string &key,
 					       ITable *table) {
   set<IState *> reachables;
@@ -16,6 +16,7 @@ public:
   virtual ~CleanUnreachableStatePhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
@@ -1,6 +1,7 @@
 #include "opt/clean/unused_register.h"
 
 #include "iroha/i_design.h"
+#include "opt/analysis_manager.h"
 
 namespace iroha {
 namespace opt {
@@ -13,6 +14,15 @@ Phase *CleanUnusedRegPhase::Create() {
   return new CleanUnusedRegPhase();
 }
 
+bool CleanUnusedRegPhase::IsTableLocal() {
+  return true;
+}
+
+int CleanUnusedRegPhase::GetPreservedAnalyses() {
+  // Removed registers are not used by any insn.
+  return AnalysisManager::ANALYSIS_ALL;
+}
+
 bool CleanUnusedRegPhase::ApplyForTable(const string &key, ITable *table) {
   set<IRegister *> regs;
   for (IState *st : table->states_) {
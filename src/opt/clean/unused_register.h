@@ -13,6 +13,8 @@ public:
   virtual ~CleanUnusedRegPhase();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
@@ -2,6 +2,7 @@
 
 #include "iroha/i_design.h"
 #include "iroha/resource_attr.h"
+#include "opt/analysis_manager.h"
 
 namespace iroha {
 namespace opt {
@@ -14,6 +15,11 @@ Phase *CleanUnusedResourcePhase::Create() {
   return new CleanUnusedResourcePhase();
 }
 
+int CleanUnusedResourcePhase::GetPreservedAnalyses() {
+  // Removed resources are not used by any insn.
+  return AnalysisManager::ANALYSIS_ALL;
+}
+
 bool CleanUnusedResourcePhase::ApplyForDesign(IDesign *design) {
   return ApplyForAllModules("scan", design) &&
     ApplyForAllModules("collect", design);
@@ -13,6 +13,7 @@ public:
   virtual ~CleanUnusedResourcePhase();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
 
 private:
   virtual bool ApplyForDesign(IDesign *design);
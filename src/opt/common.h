@@ -10,6 +10,7 @@
 namespace iroha {
 namespace opt {
 
+class AnalysisManager;
 class BB;
 class BBSet;
 class DataFlow;
@@ -17,6 +18,7 @@ class DebugAnnotation;
 class DominatorTree;
 class DelayInfo;
 class Optimizer;
+class PhaseStats;
 class RegDef;
 
 }  // namespace opt
@@ -1,5 +1,6 @@
 #include "opt/compound.h"
 
+#include "opt/analysis_manager.h"
 #include "opt/optimizer.h"
 
 namespace iroha {
@@ -16,6 +17,11 @@ void CompoundPhase::Init() {
   Optimizer::RegisterPhase("clean", &CompoundPhase::Create);
 }
 
+int CompoundPhase::GetPreservedAnalyses() {
+  // Each sub phase has already invalidated analyses.
+  return AnalysisManager::ANALYSIS_ALL;
+}
+
 bool CompoundPhase::ApplyForDesign(IDesign *design) {
   if (name_ == "clean") {
     return optimizer_->ApplyPhase("clean_unused_resource") &&
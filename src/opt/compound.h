@@ -16,6 +16,7 @@ public:
 
   static void Init();
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
 
 private:
   virtual bool ApplyForDesign(IDesign *design);
@@ -0,0 +1,351 @@
+#include "opt/constant/constant_folder.h"
+
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/insn_operands.h"
+#include "iroha/resource_class.h"
+#include "numeric/numeric_op.h"
+#include "opt/opt_util.h"
+
+namespace iroha {
+namespace opt {
+namespace constant {
+
+static const int kMaxWidth = ExtraWideValue::kMaxLimbs * 64;
+
+// Temporary value of a width with its own storage.
+class FoldValue {
+public:
+  FoldValue(int width) : w_(false, width) {
+    if (w_.IsExtraWide()) {
+      v_.extra_wide_value_ = &ev_;
+    }
+    Numeric::Clear(w_, &v_);
+  }
+
+  // Zero extends or truncates.
+  void SetFrom(const NumericWidth &sw, const NumericValue &src) {
+    Numeric::Clear(w_, &v_);
+    Op::Set(sw, src, w_, &v_);
+  }
+  void SetFrom(const FoldValue &src) {
+    SetFrom(src.w_, src.v_);
+  }
+  bool IsZero() const {
+    return Op::IsZero(w_, v_);
+  }
+
+  NumericWidth w_;
+  NumericValue v_;
+
+private:
+  ExtraWideValue ev_;
+};
+
+// Bool registers have width 0, but the value is 1 bit.
+static int GetWidth(const NumericWidth &w) {
+  if (w.GetWidth() == 0) {
+    return 1;
+  }
+  return w.GetWidth();
+}
+
+static void Load(const Numeric &n, FoldValue *v) {
+  if (n.type_.GetWidth() == 0) {
+    v->SetFrom(NumericWidth(false, 1), n.GetArray());
+  } else {
+    v->SetFrom(n.type_, n.GetArray());
+  }
+}
+
+ConstantFolder::ConstantFolder(ITable *table) : table_(table) {
+}
+
+IRegister *ConstantFolder::Fold(IInsn *insn) {
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  if (resource::IsSelect(*rc)) {
+    if (insn->outputs_.size() != 1 || insn->inputs_.size() != 3 ||
+	!insn->inputs_[0]->IsConst()) {
+      return nullptr;
+    }
+    if (insn->outputs_[0]->value_type_.IsSigned() ||
+	GetWidth(insn->inputs_[0]->value_type_) > kMaxWidth) {
+      return nullptr;
+    }
+    FoldValue cond(GetWidth(insn->inputs_[0]->value_type_));
+    Load(insn->inputs_[0]->GetInitialValue(), &cond);
+    return cond.IsZero() ? insn->inputs_[1] : insn->inputs_[2];
+  }
+  if (resource::IsSet(*rc) || !CanEvaluate(insn)) {
+    return nullptr;
+  }
+  vector<const Numeric *> inputs;
+  for (IRegister *reg : insn->inputs_) {
+    if (!reg->IsConst()) {
+      return nullptr;
+    }
+    inputs.push_back(&reg->GetInitialValue());
+  }
+  Numeric n;
+  n.type_ = insn->outputs_[0]->value_type_;
+  if (n.type_.IsExtraWide()) {
+    Numeric::MayPopulateStorage(n.type_, nullptr, n.GetMutableArray());
+  }
+  if (!Evaluate(insn, inputs, &n)) {
+    return nullptr;
+  }
+  return DesignTool::AllocConstNum(table_, n);
+}
+
+bool ConstantFolder::CanEvaluate(IInsn *insn) {
+  if (!OptUtil::IsSideEffectFree(insn) || insn->outputs_.size() != 1 ||
+      insn->inputs_.empty() ||
+      resource::IsSelect(*insn->GetResource()->GetClass())) {
+    return false;
+  }
+  IRegister *out = insn->outputs_[0];
+  if (out->value_type_.IsSigned() ||
+      GetWidth(out->value_type_) > kMaxWidth) {
+    return false;
+  }
+  for (IRegister *reg : insn->inputs_) {
+    if (reg->value_type_.IsSigned() ||
+	GetWidth(reg->value_type_) > kMaxWidth) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ConstantFolder::Evaluate(IInsn *insn,
+			      const vector<const Numeric *> &inputs,
+			      Numeric *res) {
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  std::unique_ptr<FoldValue> v;
+  if (resource::IsSet(*rc)) {
+    if (inputs.size() == 1) {
+      v.reset(new FoldValue(GetWidth(inputs[0]->type_)));
+      Load(*inputs[0], v.get());
+    }
+  } else if (resource::IsExclusiveBinOp(*rc)) {
+    v.reset(FoldExclusiveBinOp(insn, inputs));
+  } else if (resource::IsLightBinOp(*rc) || resource::IsLightUniOp(*rc)) {
+    v.reset(FoldLightOp(insn, inputs));
+  } else if (resource::IsBitShiftOp(*rc)) {
+    v.reset(FoldShift(insn, inputs));
+  } else if (resource::IsBitSel(*rc)) {
+    v.reset(FoldBitSel(insn, inputs));
+  } else if (resource::IsBitConcat(*rc)) {
+    v.reset(FoldBitConcat(insn, inputs));
+  }
+  if (v.get() == nullptr) {
+    return false;
+  }
+  Numeric::Clear(res->type_, res->GetMutableArray());
+  if (res->type_.GetWidth() == 0) {
+    res->SetValue0(v->IsZero() ? 0 : 1);
+  } else {
+    Op::Set(v->w_, v->v_, res->type_, res->GetMutableArray());
+  }
+  return true;
+}
+
+// Inputs go through the ports of the shared unit. Same as
+//  assign unit_d0 = unit_s0 op unit_s1;
+FoldValue *ConstantFolder::FoldExclusiveBinOp(IInsn *insn,
+					      const vector<const Numeric *> &in) {
+  if (in.size() != 2) {
+    return nullptr;
+  }
+  IResource *res = insn->GetResource();
+  const string &name = res->GetClass()->GetName();
+  bool is_compare = resource::IsNumToBoolExclusiveBinOp(*res->GetClass());
+  vector<int> port_widths;
+  for (int i = 0; i < 2; ++i) {
+    if (res->input_types_.size() == 2) {
+      if (res->input_types_[i].IsSigned()) {
+	return nullptr;
+      }
+      port_widths.push_back(GetWidth(res->input_types_[i]));
+    } else {
+      port_widths.push_back(GetWidth(in[i]->type_));
+    }
+  }
+  int out_width = GetWidth(insn->outputs_[0]->value_type_);
+  if (res->output_types_.size() == 1) {
+    if (res->output_types_[0].IsSigned()) {
+      return nullptr;
+    }
+    out_width = GetWidth(res->output_types_[0]);
+  }
+  int width = max(port_widths[0], port_widths[1]);
+  if (!is_compare) {
+    width = max(width, out_width);
+  }
+  if (width > kMaxWidth) {
+    return nullptr;
+  }
+  vector<std::unique_ptr<FoldValue> > args;
+  for (int i = 0; i < 2; ++i) {
+    FoldValue port(port_widths[i]);
+    Load(*in[i], &port);
+    args.emplace_back(new FoldValue(width));
+    args[i]->SetFrom(port);
+  }
+  const NumericWidth &w = args[0]->w_;
+  const NumericValue &x = args[0]->v_;
+  const NumericValue &y = args[1]->v_;
+  if (is_compare) {
+    bool b;
+    if (name == resource::kGt) {
+      b = Op::Compare(COMPARE_GT, w, x, y);
+    } else if (name == resource::kGte) {
+      b = !Op::Compare(COMPARE_LT, w, x, y);
+    } else if (name == resource::kEq) {
+      b = Op::Compare(COMPARE_EQ, w, x, y);
+    } else {
+      return nullptr;
+    }
+    FoldValue *r = new FoldValue(1);
+    r->v_.SetValue0(b ? 1 : 0);
+    return r;
+  }
+  FoldValue a(width);
+  if (name == resource::kAdd) {
+    Op::Add(w, x, y, &a.v_);
+  } else if (name == resource::kSub) {
+    Op::Sub(w, x, y, &a.v_);
+  } else if (name == resource::kMul) {
+    Op::Mul(w, x, y, &a.v_);
+  } else {
+    return nullptr;
+  }
+  FoldValue *r = new FoldValue(out_width);
+  r->SetFrom(a);
+  return r;
+}
+
+// Same as
+//  assign insn_o = x op y;
+FoldValue *ConstantFolder::FoldLightOp(IInsn *insn,
+				       const vector<const Numeric *> &in) {
+  const string &name = insn->GetResource()->GetClass()->GetName();
+  int num_inputs = (name == resource::kBitInv) ? 1 : 2;
+  if (in.size() != num_inputs) {
+    return nullptr;
+  }
+  int width = GetWidth(insn->outputs_[0]->value_type_);
+  for (const Numeric *n : in) {
+    width = max(width, GetWidth(n->type_));
+  }
+  vector<std::unique_ptr<FoldValue> > args;
+  for (const Numeric *n : in) {
+    args.emplace_back(new FoldValue(width));
+    Load(*n, args.back().get());
+  }
+  FoldValue *r = new FoldValue(width);
+  const NumericWidth &w = r->w_;
+  if (name == resource::kBitInv) {
+    uint64_t *limbs = Numeric::GetMutableLimbs(w, &r->v_);
+    const uint64_t *x = Numeric::GetLimbs(w, args[0]->v_);
+    for (int i = 0; i < w.GetValueCount(); ++i) {
+      limbs[i] = ~x[i];
+    }
+    Op::FixupValueWidth(w, &r->v_);
+    return r;
+  }
+  BinOp op;
+  if (name == resource::kBitAnd) {
+    op = BINOP_AND;
+  } else if (name == resource::kBitOr) {
+    op = BINOP_OR;
+  } else {
+    op = BINOP_XOR;
+  }
+  Op::CalcBinOp(op, args[0]->v_, args[1]->v_, w, &r->v_);
+  return r;
+}
+
+// Same as
+//  assign insn_o = x << amount;
+FoldValue *ConstantFolder::FoldShift(IInsn *insn,
+				     const vector<const Numeric *> &in) {
+  if (in.size() != 2 || in[1]->type_.IsWide()) {
+    return nullptr;
+  }
+  int width = max(GetWidth(in[0]->type_),
+		  GetWidth(insn->outputs_[0]->value_type_));
+  FoldValue *r = new FoldValue(width);
+  uint64_t amount = in[1]->GetValue0();
+  if (amount >= width) {
+    return r;
+  }
+  FoldValue x(width);
+  Load(*in[0], &x);
+  NumericValue a;
+  a.SetValue0(amount);
+  bool is_left = (insn->GetOperand() == operand::kLeft);
+  Op::CalcBinOp(is_left ? BINOP_LSHIFT : BINOP_RSHIFT, x.v_, a, r->w_,
+		&r->v_);
+  Op::FixupValueWidth(r->w_, &r->v_);
+  return r;
+}
+
+// Same as
+//  assign insn_o = x[msb:lsb];
+FoldValue *ConstantFolder::FoldBitSel(IInsn *insn,
+				      const vector<const Numeric *> &in) {
+  if (in.size() != 3 || in[1]->type_.IsWide() || in[2]->type_.IsWide()) {
+    return nullptr;
+  }
+  int width = GetWidth(in[0]->type_);
+  uint64_t msb = in[1]->GetValue0();
+  uint64_t lsb = in[2]->GetValue0();
+  if (msb < lsb || msb >= width) {
+    return nullptr;
+  }
+  FoldValue x(width);
+  Load(*in[0], &x);
+  FoldValue shifted(width);
+  NumericValue a;
+  a.SetValue0(lsb);
+  Op::CalcBinOp(BINOP_RSHIFT, x.v_, a, shifted.w_, &shifted.v_);
+  FoldValue *r = new FoldValue(msb - lsb + 1);
+  r->SetFrom(shifted);
+  return r;
+}
+
+// Same as
+//  assign insn_o = {x, y, ..};
+FoldValue *ConstantFolder::FoldBitConcat(IInsn *insn,
+					 const vector<const Numeric *> &in) {
+  int width = 0;
+  for (const Numeric *n : in) {
+    width += GetWidth(n->type_);
+  }
+  if (width > kMaxWidth) {
+    return nullptr;
+  }
+  FoldValue *r = new FoldValue(width);
+  for (const Numeric *n : in) {
+    int w = GetWidth(n->type_);
+    if (w < width) {
+      FoldValue shifted(width);
+      NumericValue a;
+      a.SetValue0(w);
+      Op::CalcBinOp(BINOP_LSHIFT, r->v_, a, r->w_, &shifted.v_);
+      Op::FixupValueWidth(r->w_, &shifted.v_);
+      r->SetFrom(shifted);
+    }
+    FoldValue x(width);
+    Load(*n, &x);
+    FoldValue ored(width);
+    Op::CalcBinOp(BINOP_OR, r->v_, x.v_, r->w_, &ored.v_);
+    r->SetFrom(ored);
+  }
+  return r;
+}
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
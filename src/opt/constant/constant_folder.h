@@ -0,0 +1,49 @@
+// -*- C++ -*-
+#ifndef _opt_constant_constant_folder_h_
+#define _opt_constant_constant_folder_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+namespace opt {
+namespace constant {
+
+class FoldValue;
+
+// Evaluates an insn with constant inputs in the same way as the generated
+// Verilog. Only unsigned values are handled for now.
+class ConstantFolder {
+public:
+  ConstantFolder(ITable *table);
+
+  // Returns the register to assign to the output of insn instead, or
+  // nullptr if insn can't be folded. This is a new constant except for
+  // select with a constant condition.
+  IRegister *Fold(IInsn *insn);
+  // True if the output of insn is a function of its inputs which
+  // Evaluate() can compute. This doesn't cover select.
+  bool CanEvaluate(IInsn *insn);
+  // Computes the output of insn from the values of its inputs, each typed
+  // as the input register. res->type_ must be the type of the output and
+  // have the storage for it. Returns false e.g. for an out of range
+  // bit-sel.
+  bool Evaluate(IInsn *insn, const vector<const Numeric *> &inputs,
+		Numeric *res);
+
+private:
+  // Each returns a new value or nullptr.
+  FoldValue *FoldExclusiveBinOp(IInsn *insn,
+				const vector<const Numeric *> &in);
+  FoldValue *FoldLightOp(IInsn *insn, const vector<const Numeric *> &in);
+  FoldValue *FoldShift(IInsn *insn, const vector<const Numeric *> &in);
+  FoldValue *FoldBitSel(IInsn *insn, const vector<const Numeric *> &in);
+  FoldValue *FoldBitConcat(IInsn *insn, const vector<const Numeric *> &in);
+
+  ITable *table_;
+};
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_constant_constant_folder_h_
@@ -1,48 +1,154 @@
 #include "opt/constant/constant_propagation.h"
 
+#include "design/def_use_index.h"
 #include "design/design_tool.h"
 #include "iroha/i_design.h"
 #include "iroha/resource_class.h"
+#include "opt/constant/constant_folder.h"
+#include "opt/analysis_manager.h"
+#include "opt/opt_util.h"
 
 namespace iroha {
 namespace opt {
 namespace constant {
 
-ConstantPropagation::~ConstantPropagation() {
-}
-
-Phase *ConstantPropagation::Create() {
-  return new ConstantPropagation();
-}
-
-bool ConstantPropagation::ApplyForTable(const string &key, ITable *table) {
-  IResource *assign = DesignTool::GetOneResource(table, resource::kSet);
-  // Before:
-  //  Rx <(assign)- Rs
-  //  Ry <- Rx
-  // After
-  //  Rx <(assign)- Rs
-  //  Ry <- Rs
+// Before:
+//  Rx <(assign)- Rs
+//  Ry <(assign)- Rx
+//  Rz <- Ry
+// After
+//  Rx <(assign)- Rs
+//  Ry <(assign)- Rs
+//  Rz <- Rs
+static bool PropagateCopies(IResource *assign, DefUseIndex *index) {
   map<IRegister *, IRegister *> dst_to_src;
-  for (IState *st : table->states_) {
-    for (IInsn *insn : st->insns_) {
-      if (insn->GetResource() == assign) {
-	dst_to_src[insn->outputs_[0]] = insn->inputs_[0];
+  for (IInsn *insn : index->GetInsnsByResource(assign)) {
+    IRegister *dst = insn->outputs_[0];
+    IRegister *src = insn->inputs_[0];
+    if (dst == src || index->GetDefs(dst).size() != 1) {
+      continue;
+    }
+    if (!src->IsConst() && index->GetDefs(src).size() > 1) {
+      continue;
+    }
+    // A wire can't be read in other states.
+    if (src->IsStateLocal() && !dst->IsStateLocal()) {
+      continue;
+    }
+    if (OptUtil::ReadsOldValue(src, insn, index)) {
+      continue;
+    }
+    dst_to_src[dst] = src;
+  }
+  // Resolves each chain to its root. Each register has only one source,
+  // so a chain either ends or forms a cycle.
+  map<IRegister *, IRegister *> root;
+  for (auto &p : dst_to_src) {
+    IRegister *r = p.first;
+    set<IRegister *> visited;
+    while (dst_to_src.find(r) != dst_to_src.end() &&
+	   visited.find(r) == visited.end()) {
+      visited.insert(r);
+      auto it = root.find(r);
+      if (it != root.end()) {
+	r = it->second;
+	break;
+      }
+      r = dst_to_src[r];
+    }
+    if (visited.find(r) != visited.end()) {
+      // Cycle.
+      continue;
+    }
+    for (IRegister *v : visited) {
+      root[v] = r;
+    }
+  }
+  // Collects insns first, since replacing inputs modifies the uses.
+  set<IInsn *> users;
+  for (auto &p : root) {
+    for (IInsn *insn : index->GetUses(p.first)) {
+      users.insert(insn);
+    }
+  }
+  bool changed = false;
+  for (IInsn *insn : users) {
+    bool replaced = false;
+    for (int i = 0; i < insn->inputs_.size(); ++i) {
+      auto it = root.find(insn->inputs_[i]);
+      if (it != root.end() && !OptUtil::ReadsOldValue(it->first, insn, index)) {
+	insn->inputs_[i] = it->second;
+	replaced = true;
       }
     }
+    if (replaced) {
+      index->UpdateInsn(insn);
+      changed = true;
+    }
   }
-  // TODO: Transitive assigns Ry <- Rx, Rz <- Ry
+  return changed;
+}
+
+// Before:
+//  Rx <(add)- C1, C2
+// After
+//  Rx <(assign)- C3
+static bool FoldInsns(ITable *table, IResource *assign, DefUseIndex *index,
+		      ConstantFolder *folder) {
+  vector<IInsn *> insns;
   for (IState *st : table->states_) {
     for (IInsn *insn : st->insns_) {
-      for (int i = 0; i < insn->inputs_.size(); ++i) {
-	IRegister *src = insn->inputs_[i];
-	auto it = dst_to_src.find(src);
-	if (it != dst_to_src.end()) {
-	  insn->inputs_[i] = it->second;
-	}
+      if (insn->GetResource() != assign) {
+	insns.push_back(insn);
       }
     }
   }
+  bool changed = false;
+  for (IInsn *insn : insns) {
+    IRegister *reg = folder->Fold(insn);
+    if (reg == nullptr) {
+      continue;
+    }
+    insn->SetResource(assign);
+    insn->SetOperand("");
+    insn->inputs_.clear();
+    insn->inputs_.push_back(reg);
+    index->UpdateInsn(insn);
+    changed = true;
+  }
+  return changed;
+}
+
+ConstantPropagation::~ConstantPropagation() {
+}
+
+Phase *ConstantPropagation::Create() {
+  return new ConstantPropagation();
+}
+
+bool ConstantPropagation::IsTableLocal() {
+  return true;
+}
+
+int ConstantPropagation::GetPreservedAnalyses() {
+  // Only inputs and resources of insns are replaced. States and the
+  // output registers of insns are kept.
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DATA_FLOW |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
+bool ConstantPropagation::ApplyForTable(const string &key, ITable *table) {
+  IResource *assign = DesignTool::GetOneResource(table, resource::kSet);
+  DefUseIndex *index = DefUseIndex::GetOrCreate(table);
+  ConstantFolder folder(table);
+  // Folding creates new assigns and the assigns may make more inputs
+  // constant.
+  bool changed;
+  do {
+    changed = PropagateCopies(assign, index);
+    changed |= FoldInsns(table, assign, index, &folder);
+  } while (changed);
   return true;
 }
 
@@ -9,11 +9,15 @@ namespace opt {
 namespace constant {
 
 // This assumes SSA input and actually propagates non constant regs too.
+// Copy chains are resolved and insns with constant inputs are folded
+// until nothing changes.
 class ConstantPropagation : public Phase {
 public:
   virtual ~ConstantPropagation();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
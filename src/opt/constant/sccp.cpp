@@ -0,0 +1,419 @@
+#include "opt/constant/sccp.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "numeric/numeric.h"
+#include "opt/constant/constant_folder.h"
+#include "opt/opt_util.h"
+
+namespace iroha {
+namespace opt {
+namespace constant {
+
+SCCP::SCCP(ITable *table)
+  : table_(table), index_(nullptr), folder_(new ConstantFolder(table)) {
+}
+
+SCCP::~SCCP() {
+}
+
+void SCCP::Perform() {
+  IState *initial = table_->GetInitialState();
+  if (initial == nullptr) {
+    return;
+  }
+  index_ = DefUseIndex::GetOrCreate(table_);
+  InitValues();
+  MarkExecutable(initial);
+  Propagate();
+  Rewrite();
+}
+
+void SCCP::InitValues() {
+  for (IRegister *reg : table_->registers_) {
+    const IValueType &type = reg->value_type_;
+    if (type.IsSigned() || type.IsWide()) {
+      values_[reg] = Value(LATTICE_BOTTOM, 0);
+    } else if (reg->IsConst()) {
+      values_[reg] = Value(LATTICE_CONST, reg->GetInitialValue().GetValue0());
+    } else if (index_->GetDefs(reg).empty()) {
+      // e.g. an input or a register written by other tables.
+      values_[reg] = Value(LATTICE_BOTTOM, 0);
+    } else if (MayReadInitialValue(reg)) {
+      // Non SSA input can read the register before the defs.
+      if (reg->HasInitialValue()) {
+	values_[reg] = Resize(Value(LATTICE_CONST,
+				    reg->GetInitialValue().GetValue0()), reg);
+      } else {
+	values_[reg] = Value(LATTICE_BOTTOM, 0);
+      }
+    } else {
+      values_[reg] = Value();
+    }
+  }
+}
+
+// Returns true if a use can be reached from the initial state without
+// passing a def. Uses in def states are BOTTOM (see ReadValue()) and phi
+// inputs are read on the edges from the defs (see EvaluatePhi()).
+bool SCCP::MayReadInitialValue(IRegister *reg) {
+  if (reg->IsStateLocal()) {
+    return false;
+  }
+  set<IState *> use_states;
+  for (IInsn *insn : index_->GetUses(reg)) {
+    if (insn->GetResource()->GetClass()->GetName() != resource::kPhi) {
+      use_states.insert(index_->GetState(insn));
+    }
+  }
+  if (use_states.empty()) {
+    return false;
+  }
+  set<IState *> def_states;
+  for (IInsn *insn : index_->GetDefs(reg)) {
+    def_states.insert(index_->GetState(insn));
+  }
+  set<IState *> reached;
+  vector<IState *> work;
+  work.push_back(table_->GetInitialState());
+  reached.insert(work.back());
+  while (!work.empty()) {
+    IState *st = work.back();
+    work.pop_back();
+    if (def_states.find(st) != def_states.end()) {
+      continue;
+    }
+    if (use_states.find(st) != use_states.end()) {
+      return true;
+    }
+    IInsn *tr = DesignUtil::FindTransitionInsn(st);
+    if (tr == nullptr) {
+      continue;
+    }
+    for (IState *next : tr->target_states_) {
+      if (reached.insert(next).second) {
+	work.push_back(next);
+      }
+    }
+  }
+  return false;
+}
+
+void SCCP::Propagate() {
+  while (!state_work_.empty() || !reg_work_.empty()) {
+    if (!state_work_.empty()) {
+      IState *st = state_work_.back();
+      state_work_.pop_back();
+      for (IInsn *insn : st->insns_) {
+	Visit(insn);
+      }
+      continue;
+    }
+    IRegister *reg = reg_work_.back();
+    reg_work_.pop_back();
+    for (IInsn *insn : index_->GetUses(reg)) {
+      if (IsExecutable(index_->GetState(insn))) {
+	Visit(insn);
+      }
+    }
+  }
+}
+
+void SCCP::MarkExecutable(IState *st) {
+  if (executable_.find(st) != executable_.end()) {
+    return;
+  }
+  executable_.insert(st);
+  state_work_.push_back(st);
+}
+
+bool SCCP::IsExecutable(IState *st) {
+  return executable_.find(st) != executable_.end();
+}
+
+void SCCP::Lower(IRegister *reg, const Value &v) {
+  Value &cur = values_[reg];
+  Value m = Meet(cur, v);
+  if (m.kind == cur.kind && m.value == cur.value) {
+    return;
+  }
+  cur = m;
+  reg_work_.push_back(reg);
+}
+
+SCCP::Value SCCP::Meet(const Value &v1, const Value &v2) {
+  if (v1.kind == LATTICE_TOP) {
+    return v2;
+  }
+  if (v2.kind == LATTICE_TOP) {
+    return v1;
+  }
+  if (v1.kind == LATTICE_CONST && v2.kind == LATTICE_CONST &&
+      v1.value == v2.value) {
+    return v1;
+  }
+  return Value(LATTICE_BOTTOM, 0);
+}
+
+SCCP::Value SCCP::GetValue(IRegister *reg) {
+  auto it = values_.find(reg);
+  if (it == values_.end()) {
+    // Registers of other tables.
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  return it->second;
+}
+
+SCCP::Value SCCP::ReadValue(IInsn *insn, IRegister *reg) {
+  if (OptUtil::ReadsOldValue(reg, insn, index_)) {
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  return GetValue(reg);
+}
+
+// Same as the assignment to out.
+SCCP::Value SCCP::Resize(const Value &v, IRegister *out) {
+  if (v.kind != LATTICE_CONST) {
+    return v;
+  }
+  const IValueType &type = out->value_type_;
+  if (type.IsSigned() || type.IsWide()) {
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  if (type.GetWidth() == 0) {
+    return Value(LATTICE_CONST, v.value & 1);
+  }
+  return Value(LATTICE_CONST, v.value & type.GetMask());
+}
+
+bool SCCP::IsDefExecutable(IRegister *reg) {
+  const vector<IInsn *> &defs = index_->GetDefs(reg);
+  if (defs.empty()) {
+    return true;
+  }
+  for (IInsn *def : defs) {
+    if (IsExecutable(index_->GetState(def))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SCCP::Visit(IInsn *insn) {
+  if (!insn->target_states_.empty()) {
+    VisitTransition(insn);
+  }
+  if (insn->outputs_.empty()) {
+    return;
+  }
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  Value v;
+  if (insn->outputs_.size() != 1 || !insn->target_states_.empty()) {
+    v = Value(LATTICE_BOTTOM, 0);
+  } else if (rc->GetName() == resource::kPhi) {
+    v = EvaluatePhi(insn);
+  } else if (resource::IsSelect(*rc)) {
+    v = EvaluateSelect(insn);
+  } else {
+    v = EvaluateInsn(insn);
+  }
+  for (IRegister *reg : insn->outputs_) {
+    Lower(reg, v);
+  }
+}
+
+void SCCP::VisitTransition(IInsn *insn) {
+  const vector<IState *> &targets = insn->target_states_;
+  if (resource::IsTransition(*insn->GetResource()->GetClass()) &&
+      targets.size() == 2 && insn->inputs_.size() > 0) {
+    Value cond = ReadValue(insn, insn->inputs_[0]);
+    if (cond.kind == LATTICE_TOP) {
+      return;
+    }
+    if (cond.kind == LATTICE_CONST) {
+      MarkExecutable(targets[(cond.value != 0) ? 1 : 0]);
+      return;
+    }
+  }
+  for (IState *st : targets) {
+    MarkExecutable(st);
+  }
+}
+
+// Only the inputs defined in executable states can reach here.
+SCCP::Value SCCP::EvaluatePhi(IInsn *insn) {
+  Value v;
+  for (IRegister *reg : insn->inputs_) {
+    if (IsDefExecutable(reg)) {
+      v = Meet(v, GetValue(reg));
+    }
+  }
+  return Resize(v, insn->outputs_[0]);
+}
+
+// inputs: cond, false value, true value.
+SCCP::Value SCCP::EvaluateSelect(IInsn *insn) {
+  if (insn->inputs_.size() != 3) {
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  IRegister *out = insn->outputs_[0];
+  Value cond = ReadValue(insn, insn->inputs_[0]);
+  if (cond.kind == LATTICE_CONST) {
+    IRegister *reg = insn->inputs_[(cond.value != 0) ? 2 : 1];
+    return Resize(ReadValue(insn, reg), out);
+  }
+  if (cond.kind == LATTICE_TOP) {
+    return cond;
+  }
+  return Meet(Resize(ReadValue(insn, insn->inputs_[1]), out),
+	      Resize(ReadValue(insn, insn->inputs_[2]), out));
+}
+
+SCCP::Value SCCP::EvaluateInsn(IInsn *insn) {
+  IRegister *out = insn->outputs_[0];
+  if (!folder_->CanEvaluate(insn) || out->value_type_.IsWide()) {
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  vector<Numeric> nums;
+  for (IRegister *reg : insn->inputs_) {
+    Value v = ReadValue(insn, reg);
+    if (v.kind != LATTICE_CONST) {
+      // TOP waits for the input.
+      return Value(v.kind, 0);
+    }
+    Numeric n;
+    n.type_ = reg->value_type_;
+    n.SetValue0(v.value);
+    nums.push_back(n);
+  }
+  vector<const Numeric *> inputs;
+  for (Numeric &n : nums) {
+    inputs.push_back(&n);
+  }
+  Numeric res;
+  res.type_ = out->value_type_;
+  if (!folder_->Evaluate(insn, inputs, &res)) {
+    return Value(LATTICE_BOTTOM, 0);
+  }
+  return Value(LATTICE_CONST, res.GetValue0());
+}
+
+void SCCP::Rewrite() {
+  IResource *assign = DesignTool::GetOneResource(table_, resource::kSet);
+  for (IState *st : table_->states_) {
+    if (!IsExecutable(st)) {
+      continue;
+    }
+    // FoldBranch() and PrunePhi() don't add or remove insns.
+    for (IInsn *insn : st->insns_) {
+      if (!insn->target_states_.empty()) {
+	FoldBranch(insn);
+      }
+      IResourceClass *rc = insn->GetResource()->GetClass();
+      if (rc->GetName() == resource::kPhi) {
+	PrunePhi(insn);
+      } else {
+	ReplaceInputs(insn);
+      }
+    }
+  }
+  // Before:
+  //  Rx <(add)- Ry, Rz
+  // After
+  //  Rx <(assign)- C
+  for (IState *st : table_->states_) {
+    if (!IsExecutable(st)) {
+      continue;
+    }
+    for (IInsn *insn : st->insns_) {
+      if (insn->outputs_.size() != 1 || !insn->target_states_.empty() ||
+	  !insn->depending_insns_.empty()) {
+	continue;
+      }
+      IResourceClass *rc = insn->GetResource()->GetClass();
+      if (rc->GetName() != resource::kPhi && !resource::IsSelect(*rc) &&
+	  !folder_->CanEvaluate(insn)) {
+	continue;
+      }
+      IRegister *out = insn->outputs_[0];
+      if (GetValue(out).kind != LATTICE_CONST || out->IsConst()) {
+	continue;
+      }
+      if (insn->GetResource() == assign && insn->inputs_.size() == 1 &&
+	  insn->inputs_[0]->IsConst()) {
+	continue;
+      }
+      insn->SetResource(assign);
+      insn->SetOperand("");
+      insn->inputs_.clear();
+      insn->inputs_.push_back(GetConstReg(out));
+      index_->UpdateInsn(insn);
+    }
+  }
+}
+
+void SCCP::FoldBranch(IInsn *insn) {
+  if (!resource::IsTransition(*insn->GetResource()->GetClass()) ||
+      insn->target_states_.size() != 2 || insn->inputs_.empty()) {
+    return;
+  }
+  Value cond = ReadValue(insn, insn->inputs_[0]);
+  if (cond.kind != LATTICE_CONST) {
+    return;
+  }
+  IState *target = insn->target_states_[(cond.value != 0) ? 1 : 0];
+  insn->target_states_.clear();
+  insn->target_states_.push_back(target);
+  insn->inputs_.clear();
+  index_->UpdateInsn(insn);
+}
+
+// Removes inputs which can't reach, so that phi_cleaner doesn't look for
+// them in dead states.
+void SCCP::PrunePhi(IInsn *insn) {
+  vector<IRegister *> inputs;
+  for (IRegister *reg : insn->inputs_) {
+    if (IsDefExecutable(reg)) {
+      inputs.push_back(reg);
+    }
+  }
+  if (inputs.size() == insn->inputs_.size() || inputs.empty()) {
+    return;
+  }
+  insn->inputs_ = inputs;
+  index_->UpdateInsn(insn);
+}
+
+void SCCP::ReplaceInputs(IInsn *insn) {
+  bool replaced = false;
+  for (int i = 0; i < insn->inputs_.size(); ++i) {
+    IRegister *reg = insn->inputs_[i];
+    if (reg->IsConst() || ReadValue(insn, reg).kind != LATTICE_CONST) {
+      continue;
+    }
+    insn->inputs_[i] = GetConstReg(reg);
+    replaced = true;
+  }
+  if (replaced) {
+    index_->UpdateInsn(insn);
+  }
+}
+
+IRegister *SCCP::GetConstReg(IRegister *reg) {
+  auto it = const_regs_.find(reg);
+  if (it != const_regs_.end()) {
+    return it->second;
+  }
+  IRegister *c = DesignTool::AllocConstNum(table_,
+					   reg->value_type_.GetWidth(),
+					   GetValue(reg).value);
+  const_regs_[reg] = c;
+  return c;
+}
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,83 @@
+// -*- C++ -*-
+//
+// Sparse conditional constant propagation (Wegman and Zadeck).
+//
+// Register values and executable states are computed together, so a
+// branch on a constant condition doesn't make the other side executable
+// and phis ignore inputs defined in non executable states. This works best
+// on SSA input (phis from opt/ssa) and handles unsigned values up to 64 bits.
+// A register which can be read before its defs starts from its initial value.
+//
+#ifndef _opt_constant_sccp_h_
+#define _opt_constant_sccp_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace constant {
+
+class ConstantFolder;
+
+class SCCP {
+public:
+  SCCP(ITable *table);
+  ~SCCP();
+
+  // Folds constant branches and removes phi inputs from dead states.
+  // Dead states are left to clean_unreachable_state.
+  void Perform();
+
+private:
+  enum LatticeKind {
+    LATTICE_TOP,
+    LATTICE_CONST,
+    LATTICE_BOTTOM,
+  };
+  struct Value {
+    Value() : kind(LATTICE_TOP), value(0) {}
+    Value(LatticeKind k, uint64_t v) : kind(k), value(v) {}
+
+    LatticeKind kind;
+    uint64_t value;
+  };
+
+  void InitValues();
+  bool MayReadInitialValue(IRegister *reg);
+  void Propagate();
+  void MarkExecutable(IState *st);
+  bool IsExecutable(IState *st);
+  void Lower(IRegister *reg, const Value &v);
+  Value Meet(const Value &v1, const Value &v2);
+  Value GetValue(IRegister *reg);
+  Value ReadValue(IInsn *insn, IRegister *reg);
+  Value Resize(const Value &v, IRegister *out);
+  bool IsDefExecutable(IRegister *reg);
+  void Visit(IInsn *insn);
+  void VisitTransition(IInsn *insn);
+  Value EvaluatePhi(IInsn *insn);
+  Value EvaluateSelect(IInsn *insn);
+  Value EvaluateInsn(IInsn *insn);
+  void Rewrite();
+  void FoldBranch(IInsn *insn);
+  void PrunePhi(IInsn *insn);
+  void ReplaceInputs(IInsn *insn);
+  IRegister *GetConstReg(IRegister *reg);
+
+  ITable *table_;
+  DefUseIndex *index_;
+  std::unique_ptr<ConstantFolder> folder_;
+  map<IRegister *, Value> values_;
+  set<IState *> executable_;
+  vector<IState *> state_work_;
+  vector<IRegister *> reg_work_;
+  map<IRegister *, IRegister *> const_regs_;
+};
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_constant_sccp_h_
@@ -0,0 +1,36 @@
+#include "opt/constant/sccp_phase.h"
+
+#include "opt/constant/sccp.h"
+#include "opt/optimizer.h"
+
+namespace iroha {
+namespace opt {
+namespace constant {
+
+SCCPPhase::~SCCPPhase() {
+}
+
+Phase *SCCPPhase::Create() {
+  return new SCCPPhase();
+}
+
+bool SCCPPhase::IsTableLocal() {
+  return true;
+}
+
+bool SCCPPhase::ApplyForDesign(IDesign *design) {
+  if (!Phase::ApplyForDesign(design)) {
+    return false;
+  }
+  return optimizer_->ApplyPhase("clean_unreachable_state");
+}
+
+bool SCCPPhase::ApplyForTable(const string &key, ITable *table) {
+  SCCP sccp(table);
+  sccp.Perform();
+  return true;
+}
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
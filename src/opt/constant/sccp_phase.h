@@ -0,0 +1,29 @@
+// -*- C++ -*-
+#ifndef _opt_constant_sccp_phase_h_
+#define _opt_constant_sccp_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace constant {
+
+// Runs SCCP on each table and then clean_unreachable_state to remove the
+// states behind folded branches.
+class SCCPPhase : public Phase {
+public:
+  virtual ~SCCPPhase();
+
+  static Phase *Create();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForDesign(IDesign *design);
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace constant
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_constant_sccp_phase_h_
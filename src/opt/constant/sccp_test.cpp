@@ -0,0 +1,78 @@
+// Checks that SCCP folds only the branches whose conditions are constant.
+#include "opt/constant/sccp.h"
+
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "iroha/test_util.h"
+#include "opt/opt_test_util.h"
+
+using namespace iroha;
+using namespace std;
+using opt::OptTestUtil;
+
+namespace {
+
+void AddSet(IState *st, IRegister *src, IRegister *dst) {
+  IResource *set = DesignTool::GetOneResource(st->GetTable(), resource::kSet);
+  OptTestUtil::AddInsn(st, set, {src}, dst);
+}
+
+IInsn *AddBranch(IState *st, IRegister *cond, IState *f, IState *t) {
+  IInsn *tr = DesignUtil::GetTransitionInsn(st);
+  tr->inputs_.push_back(cond);
+  tr->target_states_.push_back(f);
+  tr->target_states_.push_back(t);
+  return tr;
+}
+
+}  // namespace
+
+void FoldBranch() {
+  TEST_CASE("FoldBranch");
+  IDesign design;
+  vector<IState *> st;
+  ITable *tab = OptTestUtil::NewTable(&design, 4, false, &st);
+  IRegister *flag = DesignTool::AllocRegister(tab, "flag", 0);
+  DesignTool::SetRegisterInitialValue(0, flag);
+  // S0: flag <- 1 -> S1
+  // S1: if flag then S3 else S2
+  AddSet(st[0], DesignTool::AllocConstNum(tab, 0, 1), flag);
+  DesignTool::AddNextState(st[0], st[1]);
+  IInsn *tr = AddBranch(st[1], flag, st[2], st[3]);
+
+  opt::constant::SCCP sccp(tab);
+  sccp.Perform();
+  ASSERT_EQ(1, tr->target_states_.size());
+  ASSERT(tr->target_states_[0] == st[3]);
+}
+
+void ReadBeforeDef() {
+  TEST_CASE("ReadBeforeDef");
+  IDesign design;
+  vector<IState *> st;
+  ITable *tab = OptTestUtil::NewTable(&design, 5, false, &st);
+  IRegister *c = DesignTool::AllocRegister(tab, "c", 0);
+  IRegister *flag = DesignTool::AllocRegister(tab, "flag", 0);
+  DesignTool::SetRegisterInitialValue(0, flag);
+  // S0: if c then S1 else S2
+  // S1: flag <- 1 -> S2
+  // S2: if flag then S4 else S3
+  AddBranch(st[0], c, st[2], st[1]);
+  AddSet(st[1], DesignTool::AllocConstNum(tab, 0, 1), flag);
+  DesignTool::AddNextState(st[1], st[2]);
+  IInsn *tr = AddBranch(st[2], flag, st[3], st[4]);
+
+  opt::constant::SCCP sccp(tab);
+  sccp.Perform();
+  // S2 can see the initial value of flag.
+  ASSERT_EQ(2, tr->target_states_.size());
+}
+
+int main(int argc, char **argv) {
+  FoldBranch();
+  ReadBeforeDef();
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Measures DataFlow::Create (reaching definitions) on a large table.
+//
+// data_flow_bench [number of states]
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "opt/bb_set.h"
+#include "opt/data_flow.h"
+#include "opt/debug_annotation.h"
+
+#include <chrono>
+#include <memory>
+#include <stdlib.h>
+
+using namespace iroha;
+using namespace iroha::opt;
+using namespace std;
+
+namespace {
+
+double Elapsed(chrono::steady_clock::time_point start) {
+  auto d = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::duration<double> >(d).count();
+}
+
+// Builds a loop of diamonds. Each state assigns one of 199 registers.
+ITable *BuildTable(IDesign *design, int num_states) {
+  IModule *mod = new IModule(design, "m");
+  design->modules_.push_back(mod);
+  ITable *tab = new ITable(mod);
+  mod->tables_.push_back(tab);
+  IResource *add = DesignTool::GetBinOpResource(tab, resource::kAdd, 32);
+  IResource *assign = DesignTool::GetOneResource(tab, resource::kSet);
+  vector<IRegister *> regs;
+  for (int i = 0; i < 199; ++i) {
+    regs.push_back(DesignTool::AllocRegister(tab, "r", 32));
+  }
+  IRegister *cond = DesignTool::AllocRegister(tab, "c", 0);
+  for (int i = 0; i < num_states; ++i) {
+    IState *st = new IState(tab);
+    tab->states_.push_back(st);
+    IInsn *insn;
+    if (i % 3 == 0) {
+      insn = new IInsn(add);
+      insn->inputs_.push_back(regs[(i + 7) % regs.size()]);
+      insn->inputs_.push_back(regs[(i + 13) % regs.size()]);
+    } else {
+      insn = new IInsn(assign);
+      insn->inputs_.push_back(regs[(i + 1) % regs.size()]);
+    }
+    insn->outputs_.push_back(regs[i % regs.size()]);
+    st->insns_.push_back(insn);
+  }
+  tab->SetInitialState(tab->states_[0]);
+  // s0 -> (s1 | s2) -> s3 -> next s0.
+  for (int i = 0; i < num_states; ++i) {
+    IState *st = tab->states_[i];
+    IState *next = tab->states_[(i + 1) % num_states];
+    if (i % 4 == 0 && i + 3 < num_states) {
+      IInsn *tr = DesignTool::AddNextState(st, next);
+      tr->inputs_.push_back(cond);
+      DesignTool::AddNextState(st, tab->states_[i + 2]);
+    } else if (i % 4 == 1) {
+      DesignTool::AddNextState(st, tab->states_[i + 2]);
+    } else {
+      DesignTool::AddNextState(st, next);
+    }
+  }
+  return tab;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int num_states = 50000;
+  if (argc > 1) {
+    num_states = atoi(argv[1]);
+  }
+  IDesign design;
+  ITable *tab = BuildTable(&design, num_states);
+  DebugAnnotation annotation;
+  unique_ptr<BBSet> bbs(BBSet::Create(tab, false, &annotation));
+  auto start = chrono::steady_clock::now();
+  unique_ptr<DataFlow> df(DataFlow::Create(bbs.get(), &annotation));
+  double t = Elapsed(start);
+  cout << "states=" << num_states << " bbs=" << bbs->bbs_.size()
+       << " defs=" << df->all_defs_.size()
+       << " reaches=" << df->reaches_.size()
+       << ": " << t << "s\n";
+  return 0;
+}
@@ -13,17 +13,19 @@ DataFlowCollector::DataFlowCollector(BBSet *bbs, DebugAnnotation *annotation)
 }
 
 DataFlow *DataFlowCollector::Create() {
-  for (auto *bb : bbs_->bbs_) {
-    BBInfo *info = new BBInfo;
-    info->bb_ = bb;
-    bb_info_[bb] = info;
+  bb_info_.resize(bbs_->bbs_.size());
+  for (int i = 0; i < bbs_->bbs_.size(); ++i) {
+    BB *bb = bbs_->bbs_[i];
+    bb_info_[i].bb_ = bb;
+    bb_index_[bb] = i;
   }
   df_ = new DataFlow;
-  for (auto p : bb_info_) {
-    CollectDefs(p.second);
+  for (BBInfo &info : bb_info_) {
+    CollectDefs(&info);
   }
-  for (auto p : bb_info_) {
-    CollectKills(p.second);
+  NumberDefs();
+  for (BBInfo &info : bb_info_) {
+    CollectKills(&info);
   }
   CollectReaches();
   CopyReaches();
@@ -34,9 +36,12 @@ DataFlow *DataFlowCollector::Create() {
 }
 
 void DataFlowCollector::Annotate(ostream &os) {
-  for (auto p : bb_info_) {
-    os << "bb:" << p.first->bb_id_ << "<br>\n";
-    for (auto *reg_def : p.second->reaches_) {
+  for (BBInfo &info : bb_info_) {
+    os << "bb:" << info.bb_->bb_id_ << "<br>\n";
+    vector<int> members;
+    info.in_.GetMembers(&members);
+    for (int n : members) {
+      RegDef *reg_def = defs_[n];
       os << " def: insn:" << reg_def->insn->GetId()
 	 << " reg: " << reg_def->reg->GetName() << "<br>\n";
     }
@@ -65,62 +70,115 @@ void DataFlowCollector::CollectDefs(BBInfo *info) {
   }
 }
 
-void DataFlowCollector::CollectKills(BBInfo *info) {
+void DataFlowCollector::NumberDefs() {
+  // Groups defs of each register in the order of their first appearance.
+  vector<IRegister *> regs;
+  unordered_map<IRegister *, vector<RegDef *> > reg_defs;
   for (RegDef *reg_def : df_->all_defs_) {
-    if (info->bb_ == reg_def->bb) {
-      continue;
+    vector<RegDef *> &defs = reg_defs[reg_def->reg];
+    if (defs.empty()) {
+      regs.push_back(reg_def->reg);
     }
-    if (info->last_defs_.find(reg_def->reg) == info->last_defs_.end()) {
-      continue;
+    defs.push_back(reg_def);
+  }
+  for (IRegister *reg : regs) {
+    int first = defs_.size();
+    for (RegDef *reg_def : reg_defs[reg]) {
+      def_num_[reg_def] = defs_.size();
+      defs_.push_back(reg_def);
     }
-    info->kills_.push_back(reg_def);
+    reg_ranges_[reg] = make_pair(first, (int)defs_.size());
+  }
+}
+
+void DataFlowCollector::CollectKills(BBInfo *info) {
+  // Defs in other BBs of registers defined in this BB. Defs in this BB
+  // which are not the last can't reach the BB's exit, so this kills all
+  // the defs of the registers and gen_ adds the last ones.
+  for (auto &p : info->last_defs_) {
+    info->kill_ranges_.push_back(reg_ranges_[p.first]);
+    info->gen_.Set(def_num_[p.second]);
   }
 }
 
 void DataFlowCollector::CollectReaches() {
+  // REACH(B) = U (DEF(P) + (REACH(P) - KILL(P))) for each predecessor P.
+  vector<int> order;
+  SortBBs(&order);
+  vector<bool> dirty(bb_info_.size(), true);
   bool changed;
   do {
     changed = false;
-    for (auto p : bb_info_) {
-      BBInfo *info = p.second;
-      set<RegDef *> temp;
-      for (BB *prev_bb : info->bb_->prev_bbs_) {
-	BBInfo *prev_bb_info = bb_info_[prev_bb];
-	CollectPropagates(prev_bb_info, &temp);
+    for (int idx : order) {
+      if (!dirty[idx]) {
+	continue;
+      }
+      dirty[idx] = false;
+      BBInfo &info = bb_info_[idx];
+      for (BB *prev_bb : info.bb_->prev_bbs_) {
+	info.in_.UnionWith(bb_info_[bb_index_[prev_bb]].out_);
+      }
+      BitVector out = info.in_;
+      for (auto &r : info.kill_ranges_) {
+	out.ClearRange(r.first, r.second);
       }
-      if (temp.size() > info->reaches_.size()) {
+      out.UnionWith(info.gen_);
+      if (out != info.out_) {
+	info.out_ = out;
+	for (BB *next_bb : info.bb_->next_bbs_) {
+	  dirty[bb_index_[next_bb]] = true;
+	}
 	changed = true;
-	info->reaches_ = temp;
       }
     }
   } while (changed);
 }
 
-void DataFlowCollector::CopyReaches() {
-  for (auto p : bb_info_) {
-    BBInfo *info = p.second;
-    for (RegDef *reg_def : info->reaches_) {
-      df_->reaches_.insert(make_pair(info->bb_, reg_def));
+void DataFlowCollector::SortBBs(vector<int> *order) {
+  // Reverse post order from the initial BB, then unreachable BBs.
+  vector<bool> visited(bb_info_.size(), false);
+  vector<int> post_order;
+  if (bbs_->initial_bb_ != nullptr) {
+    // (index, position in the sorted successors)
+    vector<pair<int, int> > stack;
+    vector<vector<BB *> > succs(bb_info_.size());
+    int initial = bb_index_[bbs_->initial_bb_];
+    visited[initial] = true;
+    BBSet::SortBBs(bbs_->initial_bb_->next_bbs_, &succs[initial]);
+    stack.push_back(make_pair(initial, 0));
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      int idx = top.first;
+      if (top.second == succs[idx].size()) {
+	post_order.push_back(idx);
+	stack.pop_back();
+	continue;
+      }
+      BB *next_bb = succs[idx][top.second];
+      ++top.second;
+      int next = bb_index_[next_bb];
+      if (!visited[next]) {
+	visited[next] = true;
+	BBSet::SortBBs(next_bb->next_bbs_, &succs[next]);
+	stack.push_back(make_pair(next, 0));
+      }
+    }
+  }
+  order->assign(post_order.rbegin(), post_order.rend());
+  for (int i = 0; i < bb_info_.size(); ++i) {
+    if (!visited[i]) {
+      order->push_back(i);
     }
   }
 }
 
-void DataFlowCollector::CollectPropagates(BBInfo *prev_bb_info,
-					  set<RegDef *> *prop) {
-  // DEF(P)
-  for (auto e : prev_bb_info->last_defs_) {
-    prop->insert(e.second);
-  }
-  // REACH(P) - KILL(P)
-  set<RegDef *> defs;
-  for (RegDef *r : prev_bb_info->reaches_) {
-    defs.insert(r);
-  }
-  for (RegDef *k : prev_bb_info->kills_) {
-    defs.erase(k);
-  }
-  for (RegDef *r : defs) {
-    prop->insert(r);
+void DataFlowCollector::CopyReaches() {
+  for (BBInfo &info : bb_info_) {
+    vector<int> members;
+    info.in_.GetMembers(&members);
+    for (int n : members) {
+      df_->reaches_.insert(make_pair(info.bb_, defs_[n]));
+    }
   }
 }
 
@@ -2,11 +2,19 @@
 #ifndef _opt_data_flow_collector_h_
 #define _opt_data_flow_collector_h_
 
+#include "opt/bit_vector.h"
 #include "opt/common.h"
 
+#include <unordered_map>
+
 namespace iroha {
 namespace opt {
 
+// Computes reaching definitions.
+//
+// RegDefs are numbered densely and grouped by their registers, so the
+// kill set of a BB is a list of number ranges. In/out sets are
+// BitVectors updated in reverse post order until nothing changes.
 class DataFlowCollector {
 public:
   DataFlowCollector(BBSet *bbs, DebugAnnotation *annotation);
@@ -17,16 +25,27 @@ private:
   public:
     BB *bb_;
     map<IRegister *, RegDef *> last_defs_;
-    vector<RegDef *> kills_;
-    set<RegDef *> reaches_;
+    // Numbers of last_defs_.
+    BitVector gen_;
+    // [first, last) numbers of RegDefs for each register defined in the BB.
+    vector<pair<int, int> > kill_ranges_;
+    BitVector in_;
+    BitVector out_;
   };
   void CollectDefs(BBInfo *info);
+  void NumberDefs();
   void CollectKills(BBInfo *info);
   void CollectReaches();
-  void CollectPropagates(BBInfo *prev_bb_info, set<RegDef *> *prop);
+  void SortBBs(vector<int> *order);
   void CopyReaches();
   void Annotate(ostream &os);
-  map<BB *, BBInfo *> bb_info_;
+  vector<BBInfo> bb_info_;
+  unordered_map<BB *, int> bb_index_;
+  // RegDef for each dense number.
+  vector<RegDef *> defs_;
+  unordered_map<RegDef *, int> def_num_;
+  // Range of the numbers for each register.
+  unordered_map<IRegister *, pair<int, int> > reg_ranges_;
   BBSet *bbs_;
   DataFlow *df_;
   DebugAnnotation *annotation_;
@@ -15,5 +15,27 @@ void DominatorTree::GetFrontier(BB *bb, vector<BB *> *s) {
   *s = frontiers_[bb];
 }
 
+BB *DominatorTree::GetIdom(BB *bb) const {
+  auto it = idoms_.find(bb);
+  if (it == idoms_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void DominatorTree::GetChildren(BB *bb, vector<BB *> *children) {
+  *children = children_[bb];
+}
+
+bool DominatorTree::Dominates(BB *a, BB *b) const {
+  auto ia = tree_order_.find(a);
+  auto ib = tree_order_.find(b);
+  if (ia == tree_order_.end() || ib == tree_order_.end()) {
+    return false;
+  }
+  return ia->second.first <= ib->second.first &&
+    ib->second.second <= ia->second.second;
+}
+
 }  // namespace opt
 }  // namespace iroha
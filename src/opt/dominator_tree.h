@@ -12,8 +12,18 @@ public:
   static DominatorTree *Create(BBSet *bset,
 			       DebugAnnotation *an);
   void GetFrontier(BB *bb, vector<BB *> *s);
+  // Immediate dominator of bb. nullptr for the initial BB.
+  BB *GetIdom(BB *bb) const;
+  // BBs immediately dominated by bb in bb_id_ order.
+  void GetChildren(BB *bb, vector<BB *> *children);
+  // True if a dominates b. A BB dominates itself.
+  bool Dominates(BB *a, BB *b) const;
 
   map<BB *, vector<BB *> > frontiers_;
+  map<BB *, BB *> idoms_;
+  map<BB *, vector<BB *> > children_;
+  // Pre and post order numbers of each BB in the tree.
+  map<BB *, pair<int, int> > tree_order_;
 };
 
 }  // namespace opt
@@ -1,6 +1,5 @@
 #include "opt/dominator_tree_builder.h"
 
-#include "iroha/stl_util.h"
 #include "iroha/logging.h"
 #include "opt/dominator_tree.h"
 #include "opt/bb_set.h"
@@ -14,91 +13,164 @@ DominatorTreeBuilder::DominatorTreeBuilder(BBSet *bset,
 }
 
 DominatorTreeBuilder::~DominatorTreeBuilder() {
-  STLDeleteSecondElements(&dom_info_);
 }
 
 DominatorTree *DominatorTreeBuilder::Create() {
-  for (BB *bb : bset_->bbs_) {
-    dom_info_[bb] = new DominatorInfo(bb);
+  DominatorTree *dt = new DominatorTree();
+  if (bset_->initial_bb_ == nullptr) {
+    return dt;
   }
+  NumberBBs();
   CalculateDominator();
   CalculateFrontier();
-  DominatorTree *dt = new DominatorTree();
-  for (auto it : dom_info_) {
-    set<BB *> frontiers;
-    for (auto *di : it.second->frontiers_) {
-      frontiers.insert(di->bb_);
-    }
-    BBSet::SortBBs(frontiers, &dt->frontiers_[it.first]);
-  }
+  BuildTree(dt);
   return dt;
 }
 
-void DominatorTreeBuilder::CalculateDominator() {
-  for (auto it : dom_info_) {
-    DominatorInfo *di = it.second;
-    BB *bb = it.first;
-    // Sets initial dominator values.
-    if (bb == bset_->initial_bb_) {
-      di->dominators_.insert(di);
-    } else {
-      for (auto jt : dom_info_) {
-	di->dominators_.insert(jt.second);
-      }
+void DominatorTreeBuilder::NumberBBs() {
+  // Iterative DFS from the initial BB visiting successors in bb_id_ order.
+  map<BB *, vector<BB *> > succs;
+  set<BB *> visited;
+  vector<pair<BB *, int> > stack;
+  vector<BB *> post_order;
+  visited.insert(bset_->initial_bb_);
+  BBSet::SortBBs(bset_->initial_bb_->next_bbs_, &succs[bset_->initial_bb_]);
+  stack.push_back(make_pair(bset_->initial_bb_, 0));
+  while (!stack.empty()) {
+    BB *bb = stack.back().first;
+    vector<BB *> &next_bbs = succs[bb];
+    int pos = stack.back().second;
+    if (pos == next_bbs.size()) {
+      post_order.push_back(bb);
+      stack.pop_back();
+      continue;
     }
-    // Sets pred blocks' info.
-    for (BB *next_bb : di->bb_->next_bbs_) {
-      auto *next_di = dom_info_[next_bb];
-      next_di->pred_.insert(di);
+    ++stack.back().second;
+    BB *next_bb = next_bbs[pos];
+    if (visited.find(next_bb) == visited.end()) {
+      visited.insert(next_bb);
+      BBSet::SortBBs(next_bb->next_bbs_, &succs[next_bb]);
+      stack.push_back(make_pair(next_bb, 0));
     }
   }
+  rpo_.assign(post_order.rbegin(), post_order.rend());
+  for (int i = 0; i < rpo_.size(); ++i) {
+    rpo_num_[rpo_[i]] = i;
+  }
+  preds_.resize(rpo_.size());
+  for (int i = 0; i < rpo_.size(); ++i) {
+    vector<BB *> prev_bbs;
+    BBSet::SortBBs(rpo_[i]->prev_bbs_, &prev_bbs);
+    for (BB *prev_bb : prev_bbs) {
+      auto it = rpo_num_.find(prev_bb);
+      if (it != rpo_num_.end()) {
+	preds_[i].push_back(it->second);
+      }
+    }
+  }
+}
+
+void DominatorTreeBuilder::CalculateDominator() {
+  // The initial BB has number 0 and -1 means not yet known.
+  idom_.assign(rpo_.size(), -1);
+  idom_[0] = 0;
   bool changed;
   do {
     changed = false;
-    for (auto it : dom_info_) {
-      if (it.first == bset_->initial_bb_) {
-        continue;
-      }
-      // U(all pred blocks) + itself.
-      DominatorInfo *di = it.second;
-      CHECK(di->pred_.size() > 0);
-      set<DominatorInfo *> cur = (*(di->pred_.begin()))->dominators_;
-      for (DominatorInfo *pred_di : di->pred_) {
-        set<DominatorInfo *> tmp;
-        Union(cur, pred_di->dominators_, &tmp);
-        cur = tmp;
+    for (int b = 1; b < rpo_.size(); ++b) {
+      int new_idom = -1;
+      for (int p : preds_[b]) {
+	if (idom_[p] < 0) {
+	  continue;
+	}
+	if (new_idom < 0) {
+	  new_idom = p;
+	} else {
+	  new_idom = Intersect(p, new_idom);
+	}
       }
-      cur.insert(di);
-      // update
-      if (cur != di->dominators_) {
-        changed = true;
-        di->dominators_ = cur;
+      CHECK(new_idom >= 0);
+      if (idom_[b] != new_idom) {
+	idom_[b] = new_idom;
+	changed = true;
       }
     }
   } while (changed);
 }
 
-void DominatorTreeBuilder::Union(set<DominatorInfo *> &s1,
-				 set<DominatorInfo *> &s2,
-				 set<DominatorInfo *> *d) {
-  for (auto *di1 : s1) {
-    if (s2.find(di1) != s2.end()) {
-      d->insert(di1);
+int DominatorTreeBuilder::Intersect(int b1, int b2) {
+  while (b1 != b2) {
+    while (b1 > b2) {
+      b1 = idom_[b1];
+    }
+    while (b2 > b1) {
+      b2 = idom_[b2];
     }
   }
+  return b1;
 }
 
 void DominatorTreeBuilder::CalculateFrontier() {
-  for (auto it : dom_info_) {
-    DominatorInfo *cur_di = it.second;
-    for (BB *bb : cur_di->bb_->next_bbs_) {
-     DominatorInfo *next_di = dom_info_[bb];
-     for (DominatorInfo *di : cur_di->dominators_) {
-       if (next_di->dominators_.find(di) == next_di->dominators_.end()) {
-         di->frontiers_.insert(next_di);
-       }
-     }
-   }
+  frontiers_.resize(rpo_.size());
+  for (int b = 0; b < rpo_.size(); ++b) {
+    // The initial BB is also entered from outside of the table, so it is
+    // a join point if it has any predecessor.
+    if (preds_[b].size() < 2 && !(b == 0 && preds_[b].size() == 1)) {
+      continue;
+    }
+    // The initial BB doesn't have its idom, so walks up to the root.
+    int stop = (b == 0) ? -1 : idom_[b];
+    for (int p : preds_[b]) {
+      int runner = p;
+      while (runner != stop) {
+	frontiers_[runner].insert(b);
+	if (runner == 0) {
+	  break;
+	}
+	runner = idom_[runner];
+      }
+    }
+  }
+}
+
+void DominatorTreeBuilder::BuildTree(DominatorTree *dt) {
+  for (int b = 0; b < rpo_.size(); ++b) {
+    BB *bb = rpo_[b];
+    set<BB *> frontiers;
+    for (int f : frontiers_[b]) {
+      frontiers.insert(rpo_[f]);
+    }
+    BBSet::SortBBs(frontiers, &dt->frontiers_[bb]);
+    if (b == 0) {
+      dt->idoms_[bb] = nullptr;
+    } else {
+      dt->idoms_[bb] = rpo_[idom_[b]];
+    }
+  }
+  vector<set<BB *> > children(rpo_.size());
+  for (int b = 1; b < rpo_.size(); ++b) {
+    children[idom_[b]].insert(rpo_[b]);
+  }
+  for (int b = 0; b < rpo_.size(); ++b) {
+    BBSet::SortBBs(children[b], &dt->children_[rpo_[b]]);
+  }
+  // Numbers the tree for Dominates().
+  int n = 0;
+  vector<pair<BB *, int> > stack;
+  stack.push_back(make_pair(rpo_[0], 0));
+  dt->tree_order_[rpo_[0]].first = n++;
+  while (!stack.empty()) {
+    BB *bb = stack.back().first;
+    vector<BB *> &c = dt->children_[bb];
+    int pos = stack.back().second;
+    if (pos == c.size()) {
+      dt->tree_order_[bb].second = n++;
+      stack.pop_back();
+      continue;
+    }
+    ++stack.back().second;
+    dt->tree_order_[c[pos]].first = n++;
+    stack.push_back(make_pair(c[pos], 0));
   }
 }
 
@@ -7,6 +7,10 @@
 namespace iroha {
 namespace opt {
 
+// Computes immediate dominators by the Cooper-Harvey-Kennedy algorithm
+// ("A Simple, Fast Dominance Algorithm") over BBs numbered in reverse
+// post order, then dominance frontiers by walking up from predecessors
+// of each join BB.
 class DominatorTreeBuilder {
 public:
   DominatorTreeBuilder(BBSet *bset,
@@ -16,25 +20,21 @@ public:
   DominatorTree *Create();
 
 private:
-  class DominatorInfo {
-  public:
-    DominatorInfo(BB *bb) : bb_(bb) {
-    }
-    BB *bb_;
-    set<DominatorInfo *> dominators_;
-    set<DominatorInfo *> frontiers_;
-    set<DominatorInfo *> pred_;
-  };
+  void NumberBBs();
   void CalculateDominator();
-  void Union(set<DominatorInfo *> &s1,
-             set<DominatorInfo *> &s2,
-             set<DominatorInfo *> *d);
+  int Intersect(int b1, int b2);
   void CalculateFrontier();
+  void BuildTree(DominatorTree *dt);
 
-  ITable *table_;
   BBSet *bset_;
   DebugAnnotation *annotation_;
-  map<BB *, DominatorInfo *> dom_info_;
+  // BBs reachable from the initial BB in reverse post order.
+  vector<BB *> rpo_;
+  map<BB *, int> rpo_num_;
+  // Indexed by the RPO number.
+  vector<vector<int> > preds_;
+  vector<int> idom_;
+  vector<set<int> > frontiers_;
 };
 
 }  // namespace opt
@@ -0,0 +1,285 @@
+#include "opt/gvn/gvn.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
+#include "opt/bb_set.h"
+#include "opt/debug_annotation.h"
+#include "opt/dominator_tree.h"
+#include "opt/opt_util.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace iroha {
+namespace opt {
+namespace gvn {
+
+GVN::GVN(ITable *table, AnalysisManager *analysis,
+	 DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    bset_(nullptr), dom_tree_(nullptr), index_(nullptr), assign_(nullptr),
+    num_replaced_(0) {
+}
+
+void GVN::Perform() {
+  if (table_->GetInitialState() == nullptr) {
+    return;
+  }
+  BBSet *bset = analysis_->GetBBSet(table_, false);
+  if (bset->initial_bb_ == nullptr) {
+    return;
+  }
+  DominatorTree *dom_tree = analysis_->GetDominatorTree(table_);
+  bset_ = bset;
+  dom_tree_ = dom_tree;
+  index_ = DefUseIndex::GetOrCreate(table_);
+  assign_ = DesignTool::GetOneResource(table_, resource::kSet);
+  // Pre order walk. Expressions added in a BB are available in the BBs
+  // dominated by it and removed when the walk leaves the BB.
+  struct Frame {
+    BB *bb;
+    vector<BB *> children;
+    int next;
+    vector<Expr> added;
+  };
+  vector<Frame> stack;
+  stack.push_back(Frame());
+  stack.back().bb = bset->initial_bb_;
+  stack.back().next = 0;
+  ProcessBB(bset->initial_bb_, &stack.back().added);
+  dom_tree->GetChildren(bset->initial_bb_, &stack.back().children);
+  while (!stack.empty()) {
+    Frame &f = stack.back();
+    if (f.next < f.children.size()) {
+      BB *child = f.children[f.next++];
+      stack.push_back(Frame());
+      Frame &c = stack.back();
+      c.bb = child;
+      c.next = 0;
+      ProcessBB(child, &c.added);
+      dom_tree->GetChildren(child, &c.children);
+      continue;
+    }
+    for (const Expr &e : f.added) {
+      available_.erase(e);
+    }
+    stack.pop_back();
+  }
+  if (annotation_->IsEnabled() && num_replaced_ > 0) {
+    annotation_->Table(table_) << "GVN replaced " << num_replaced_
+			       << " insns\n";
+  }
+}
+
+void GVN::ProcessBB(BB *bb, vector<Expr> *added) {
+  for (IState *st : bb->states_) {
+    // Copies the list, since ProcessInsn() may remove the insn.
+    vector<IInsn *> insns = st->insns_;
+    for (IInsn *insn : insns) {
+      ProcessInsn(st, insn, added);
+    }
+  }
+}
+
+// Before:
+//  S1: Rx <(add)- Ra, Rb
+//  S2: Ry <(add)- Ra, Rb
+// After:
+//  S1: Rx <(add)- Ra, Rb
+//  S2: Ry <(assign)- Rx
+//
+// If both are registers in the same state, uses of Ry read Rx and the
+// insn is removed.
+void GVN::ProcessInsn(IState *st, IInsn *insn, vector<Expr> *added) {
+  if (!IsCandidate(st, insn)) {
+    return;
+  }
+  Expr expr;
+  BuildExpr(insn, &expr);
+  auto it = available_.find(expr);
+  if (it == available_.end()) {
+    Available av;
+    av.insn = insn;
+    av.st = st;
+    available_[expr] = av;
+    added->push_back(expr);
+    return;
+  }
+  IRegister *src = it->second.insn->outputs_[0];
+  IRegister *dst = insn->outputs_[0];
+  if (src->IsStateLocal() == (it->second.st == st)) {
+    insn->SetResource(assign_);
+    insn->SetOperand("");
+    insn->inputs_.clear();
+    insn->inputs_.push_back(src);
+    index_->UpdateInsn(insn);
+  } else if (it->second.st == st && !dst->IsStateLocal()) {
+    if (!ReplaceUses(st, dst, src)) {
+      return;
+    }
+    DesignTool::EraseInsn(st, insn);
+  } else {
+    return;
+  }
+  value_numbers_[dst] = GetValueNumber(src);
+  ++num_replaced_;
+}
+
+bool GVN::ReplaceUses(IState *st, IRegister *reg, IRegister *src) {
+  // Copies the uses, since replacing inputs modifies them.
+  vector<IInsn *> uses = index_->GetUses(reg);
+  for (IInsn *insn : uses) {
+    if (index_->GetState(insn) == st) {
+      // Reads the old value.
+      return false;
+    }
+  }
+  for (IInsn *insn : uses) {
+    for (int i = 0; i < insn->inputs_.size(); ++i) {
+      if (insn->inputs_[i] == reg) {
+	insn->inputs_[i] = src;
+      }
+    }
+    index_->UpdateInsn(insn);
+  }
+  return true;
+}
+
+bool GVN::IsCandidate(IState *st, IInsn *insn) {
+  // Assignments are left to copy propagation.
+  if (!OptUtil::IsSideEffectFree(insn) || insn->outputs_.size() != 1 ||
+      insn->inputs_.empty() ||
+      resource::IsSet(*insn->GetResource()->GetClass())) {
+    return false;
+  }
+  IRegister *out = insn->outputs_[0];
+  if (out->IsConst() || index_->GetDefs(out).size() != 1) {
+    return false;
+  }
+  // An input written in this state has the old value here, so the same
+  // register can have different values in the states.
+  for (IRegister *reg : insn->inputs_) {
+    if (OptUtil::ReadsOldValue(reg, insn, index_)) {
+      return false;
+    }
+  }
+  // The value of each input has to be the same in the states dominated by
+  // this state. e.g. for non SSA input
+  //  S1: Rx <- Ra + Rb
+  //  S2: Ra <- 5
+  //  S3: Ry <- Ra + Rb
+  // Ra of S3 isn't the same as Ra of S1, since S2 writes it.
+  for (IRegister *reg : insn->inputs_) {
+    if (reg->IsConst()) {
+      continue;
+    }
+    const vector<IInsn *> &defs = index_->GetDefs(reg);
+    if (defs.empty()) {
+      // Keeps the initial value or written by other tables.
+      continue;
+    }
+    if (defs.size() != 1) {
+      return false;
+    }
+    IState *def_st = index_->GetState(defs[0]);
+    if (reg->IsStateLocal()) {
+      if (def_st != st) {
+	return false;
+      }
+    } else if (!StrictlyDominates(def_st, st)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GVN::StrictlyDominates(IState *a, IState *b) {
+  if (a == b) {
+    return false;
+  }
+  auto ia = bset_->state_to_bb_.find(a);
+  auto ib = bset_->state_to_bb_.find(b);
+  if (ia == bset_->state_to_bb_.end() || ib == bset_->state_to_bb_.end()) {
+    return false;
+  }
+  BB *bb = ia->second;
+  if (bb != ib->second) {
+    return dom_tree_->Dominates(bb, ib->second);
+  }
+  for (IState *st : bb->states_) {
+    if (st == a) {
+      return true;
+    }
+    if (st == b) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool GVN::IsCommutative(IInsn *insn) {
+  IResource *res = insn->GetResource();
+  const string &name = res->GetClass()->GetName();
+  if (name == resource::kBitAnd || name == resource::kBitOr ||
+      name == resource::kBitXor) {
+    return true;
+  }
+  if (name == resource::kAdd || name == resource::kMul ||
+      name == resource::kEq) {
+    // Inputs are truncated to each port.
+    return res->input_types_.size() != 2 ||
+      (res->input_types_[0].GetWidth() == res->input_types_[1].GetWidth() &&
+       res->input_types_[0].IsSigned() == res->input_types_[1].IsSigned());
+  }
+  return false;
+}
+
+void GVN::BuildExpr(IInsn *insn, Expr *expr) {
+  IResource *res = insn->GetResource();
+  ostringstream os;
+  os << res->GetClass()->GetName() << " " << insn->GetOperand();
+  if (resource::IsExclusiveBinOp(*res->GetClass())) {
+    os << " (";
+    for (IValueType &t : res->input_types_) {
+      os << t.Format() << " ";
+    }
+    os << ") (";
+    for (IValueType &t : res->output_types_) {
+      os << t.Format() << " ";
+    }
+    os << ")";
+  }
+  os << " " << insn->outputs_[0]->value_type_.Format();
+  expr->op = os.str();
+  for (IRegister *reg : insn->inputs_) {
+    expr->inputs.push_back(GetValueNumber(reg));
+  }
+  if (IsCommutative(insn)) {
+    std::sort(expr->inputs.begin(), expr->inputs.end());
+  }
+}
+
+IRegister *GVN::GetValueNumber(IRegister *reg) {
+  if (reg->IsConst()) {
+    const Numeric &n = reg->GetInitialValue();
+    string key = n.type_.Format() + " " + n.Format();
+    auto it = const_numbers_.find(key);
+    if (it != const_numbers_.end()) {
+      return it->second;
+    }
+    const_numbers_[key] = reg;
+    return reg;
+  }
+  auto it = value_numbers_.find(reg);
+  if (it != value_numbers_.end()) {
+    return it->second;
+  }
+  return reg;
+}
+
+}  // namespace gvn
+}  // namespace opt
+}  // namespace iroha
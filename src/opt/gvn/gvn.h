@@ -0,0 +1,76 @@
+// -*- C++ -*-
+//
+// Dominator based value numbering.
+//
+// Walks the dominator tree with a scoped table of available expressions.
+// An insn computing the same expression as a dominating insn becomes an
+// assign from the dominating result, or is removed if both results are
+// registers written in the same state. Expressions are keyed by the
+// resource class, operand, port and output types and value numbers of
+// the inputs. Works best on SSA input, since an input must have one def
+// dominating the insn (or no def).
+//
+#ifndef _opt_gvn_gvn_h_
+#define _opt_gvn_gvn_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace gvn {
+
+class GVN {
+public:
+  GVN(ITable *table, AnalysisManager *analysis,
+      DebugAnnotation *annotation);
+
+  void Perform();
+
+private:
+  struct Expr {
+    string op;
+    vector<IRegister *> inputs;
+
+    bool operator<(const Expr &e) const {
+      if (op != e.op) {
+	return op < e.op;
+      }
+      return inputs < e.inputs;
+    }
+  };
+  struct Available {
+    IInsn *insn;
+    IState *st;
+  };
+
+  void ProcessBB(BB *bb, vector<Expr> *added);
+  void ProcessInsn(IState *st, IInsn *insn, vector<Expr> *added);
+  bool IsCandidate(IState *st, IInsn *insn);
+  bool StrictlyDominates(IState *a, IState *b);
+  bool IsCommutative(IInsn *insn);
+  void BuildExpr(IInsn *insn, Expr *expr);
+  bool ReplaceUses(IState *st, IRegister *reg, IRegister *src);
+  IRegister *GetValueNumber(IRegister *reg);
+
+  ITable *table_;
+  AnalysisManager *analysis_;
+  DebugAnnotation *annotation_;
+  BBSet *bset_;
+  DominatorTree *dom_tree_;
+  DefUseIndex *index_;
+  IResource *assign_;
+  map<Expr, Available> available_;
+  // Output of a replaced insn to the dominating result.
+  map<IRegister *, IRegister *> value_numbers_;
+  // Constant value to the first register with the value.
+  map<string, IRegister *> const_numbers_;
+  int num_replaced_;
+};
+
+}  // namespace gvn
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_gvn_gvn_h_
@@ -0,0 +1,36 @@
+#include "opt/gvn/gvn_phase.h"
+
+#include "opt/analysis_manager.h"
+#include "opt/gvn/gvn.h"
+#include "opt/optimizer.h"
+
+namespace iroha {
+namespace opt {
+namespace gvn {
+
+GVNPhase::~GVNPhase() {
+}
+
+Phase *GVNPhase::Create() {
+  return new GVNPhase();
+}
+
+bool GVNPhase::IsTableLocal() {
+  return true;
+}
+
+int GVNPhase::GetPreservedAnalyses() {
+  // States and transitions are not modified.
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
+bool GVNPhase::ApplyForTable(const string &key, ITable *table) {
+  GVN gvn(table, optimizer_->GetAnalysisManager(), annotation_);
+  gvn.Perform();
+  return true;
+}
+
+}  // namespace gvn
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,27 @@
+// -*- C++ -*-
+#ifndef _opt_gvn_gvn_phase_h_
+#define _opt_gvn_gvn_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace gvn {
+
+class GVNPhase : public Phase {
+public:
+  virtual ~GVNPhase();
+
+  static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace gvn
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_gvn_gvn_phase_h_
@@ -0,0 +1,77 @@
+// Checks that GVN replaces only the expressions with the same input values.
+#include "opt/gvn/gvn.h"
+
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "iroha/test_util.h"
+#include "opt/analysis_manager.h"
+#include "opt/debug_annotation.h"
+#include "opt/opt_test_util.h"
+
+using namespace iroha;
+using namespace std;
+using opt::OptTestUtil;
+
+namespace {
+
+void PerformGVN(ITable *tab) {
+  opt::DebugAnnotation annotation;
+  opt::AnalysisManager analysis(&annotation);
+  opt::gvn::GVN gvn(tab, &analysis, &annotation);
+  gvn.Perform();
+}
+
+}  // namespace
+
+void Replace() {
+  TEST_CASE("Replace");
+  IDesign design;
+  vector<IState *> st;
+  ITable *tab = OptTestUtil::NewTable(&design, 2, true, &st);
+  IResource *add = DesignTool::GetBinOpResource(tab, resource::kAdd, 32);
+  IRegister *a = DesignTool::AllocRegister(tab, "a", 32);
+  IRegister *b = DesignTool::AllocRegister(tab, "b", 32);
+  IRegister *x = DesignTool::AllocRegister(tab, "x", 32);
+  IRegister *y = DesignTool::AllocRegister(tab, "y", 32);
+  // S0: x <- a + b
+  // S1: y <- b + a
+  OptTestUtil::AddInsn(st[0], add, {a, b}, x);
+  IInsn *insn = OptTestUtil::AddInsn(st[1], add, {b, a}, y);
+
+  PerformGVN(tab);
+  ASSERT(resource::IsSet(*insn->GetResource()->GetClass()));
+  ASSERT_EQ(1, insn->inputs_.size());
+  ASSERT(insn->inputs_[0] == x);
+}
+
+void NonSSA() {
+  TEST_CASE("NonSSA");
+  IDesign design;
+  vector<IState *> st;
+  ITable *tab = OptTestUtil::NewTable(&design, 3, true, &st);
+  IResource *add = DesignTool::GetBinOpResource(tab, resource::kAdd, 32);
+  IResource *set = DesignTool::GetOneResource(tab, resource::kSet);
+  IRegister *a = DesignTool::AllocRegister(tab, "a", 32);
+  IRegister *b = DesignTool::AllocRegister(tab, "b", 32);
+  IRegister *x = DesignTool::AllocRegister(tab, "x", 32);
+  IRegister *y = DesignTool::AllocRegister(tab, "y", 32);
+  // S0: x <- a + b
+  // S1: a <- 5
+  // S2: y <- a + b
+  OptTestUtil::AddInsn(st[0], add, {a, b}, x);
+  OptTestUtil::AddInsn(st[1], set, {DesignTool::AllocConstNum(tab, 32, 5)},
+		       a);
+  IInsn *insn = OptTestUtil::AddInsn(st[2], add, {a, b}, y);
+
+  PerformGVN(tab);
+  ASSERT(insn->GetResource() == add);
+  ASSERT_EQ(2, insn->inputs_.size());
+}
+
+int main(int argc, char **argv) {
+  Replace();
+  NonSSA();
+
+  return 0;
+}
@@ -0,0 +1,258 @@
+#include "opt/ifconv/if_conversion.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_attr.h"
+#include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
+#include "opt/bb_set.h"
+#include "opt/debug_annotation.h"
+#include "opt/opt_util.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+namespace ifconv {
+
+// Insns in a side except the transition.
+static const int kMaxSideInsns = 4;
+
+IfConversion::IfConversion(ITable *table, AnalysisManager *analysis,
+			   DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    num_converted_(0) {
+}
+
+void IfConversion::Perform() {
+  if (table_->GetInitialState() == nullptr) {
+    return;
+  }
+  // A merged state can become a side of an outer branch.
+  while (ConvertBranches()) {
+    analysis_->Invalidate(table_);
+  }
+  if (num_converted_ > 0) {
+    // Insns were moved between states directly.
+    DefUseIndex::Drop(table_);
+  }
+  if (annotation_->IsEnabled() && num_converted_ > 0) {
+    annotation_->Table(table_) << "If-converted " << num_converted_
+			       << " branches\n";
+  }
+}
+
+bool IfConversion::ConvertBranches() {
+  preds_.clear();
+  touched_.clear();
+  OptUtil::CollectTransitionPreds(table_, &preds_);
+  BBSet *bset = analysis_->GetBBSet(table_, false);
+  bool converted = false;
+  for (BB *bb : bset->bbs_) {
+    if (bb->next_bbs_.size() == 2 && ConvertBranch(bb->states_.back())) {
+      converted = true;
+    }
+  }
+  return converted;
+}
+
+bool IfConversion::ConvertBranch(IState *st) {
+  if (touched_.find(st) != touched_.end() ||
+      ResourceAttr::NumMultiCycleInsn(st) > 0) {
+    return false;
+  }
+  IInsn *tr = DesignUtil::FindTransitionInsn(st);
+  if (tr == nullptr || tr->target_states_.size() != 2 ||
+      tr->inputs_.size() != 1) {
+    return false;
+  }
+  IState *f = tr->target_states_[0];
+  IState *t = tr->target_states_[1];
+  if (f == t) {
+    return false;
+  }
+  IState *f_join = GetSideJoin(st, f);
+  IState *t_join = GetSideJoin(st, t);
+  // Sides for the false and true conditions. nullptr if it goes to the join
+  // directly.
+  vector<IState *> sides;
+  IState *join;
+  if (f_join != nullptr && f_join == t_join) {
+    sides = {f, t};
+    join = f_join;
+  } else if (f_join == t) {
+    sides = {f, nullptr};
+    join = t;
+  } else if (t_join == f) {
+    sides = {nullptr, t};
+    join = f;
+  } else {
+    return false;
+  }
+  if (touched_.find(join) != touched_.end() || !CanMerge(st, sides)) {
+    return false;
+  }
+  Merge(st, tr, sides, join);
+  return true;
+}
+
+// Returns the next state if the side can be merged into st.
+IState *IfConversion::GetSideJoin(IState *st, IState *side) {
+  if (side == st || side == table_->GetInitialState() ||
+      touched_.find(side) != touched_.end() || preds_[side].size() != 1) {
+    return nullptr;
+  }
+  IInsn *tr = DesignUtil::FindTransitionInsn(side);
+  if (tr == nullptr || tr->target_states_.size() != 1 ||
+      !tr->inputs_.empty() || tr->target_states_[0] == side) {
+    return nullptr;
+  }
+  return tr->target_states_[0];
+}
+
+bool IfConversion::CanMerge(IState *st, const vector<IState *> &sides) {
+  set<IRegister *> st_outputs;
+  for (IInsn *insn : st->insns_) {
+    st_outputs.insert(insn->outputs_.begin(), insn->outputs_.end());
+  }
+  for (IState *side : sides) {
+    if (side == nullptr) {
+      continue;
+    }
+    if (side->insns_.size() > kMaxSideInsns + 1) {
+      return false;
+    }
+    set<IRegister *> side_wires;
+    for (IInsn *insn : side->insns_) {
+      if (!insn->target_states_.empty()) {
+	continue;
+      }
+      if (!OptUtil::IsSideEffectFree(insn)) {
+	return false;
+      }
+      for (IRegister *reg : insn->outputs_) {
+	if (reg->IsConst() || st_outputs.find(reg) != st_outputs.end()) {
+	  return false;
+	}
+	if (reg->IsStateLocal()) {
+	  side_wires.insert(reg);
+	}
+      }
+    }
+    // Reads in the side see the values after st.
+    for (IInsn *insn : side->insns_) {
+      for (IRegister *reg : insn->inputs_) {
+	if (reg->IsStateLocal() && side_wires.find(reg) == side_wires.end()) {
+	  return false;
+	}
+	if (st_outputs.find(reg) != st_outputs.end()) {
+	  return false;
+	}
+      }
+    }
+  }
+  return true;
+}
+
+void IfConversion::Merge(IState *st, IInsn *tr,
+			 const vector<IState *> &sides, IState *join) {
+  set<IResource *> used;
+  for (IInsn *insn : st->insns_) {
+    used.insert(insn->GetResource());
+  }
+  map<IRegister *, IRegister *> values[2];
+  vector<IRegister *> outputs;
+  static const char *kSuffix[] = {"_f", "_t"};
+  for (int i = 0; i < 2; ++i) {
+    if (sides[i] != nullptr) {
+      MergeSide(st, tr, sides[i], kSuffix[i], &used, &values[i], &outputs);
+    }
+  }
+  IRegister *cond = tr->inputs_[0];
+  IResource *sel = DesignTool::GetOneResource(table_, resource::kSelect);
+  for (IRegister *reg : outputs) {
+    IInsn *sel_insn = new IInsn(sel);
+    sel_insn->inputs_.push_back(cond);
+    for (int i = 0; i < 2; ++i) {
+      auto it = values[i].find(reg);
+      // Keeps the current value if the side doesn't write it.
+      sel_insn->inputs_.push_back(it == values[i].end() ? reg : it->second);
+    }
+    sel_insn->outputs_.push_back(reg);
+    st->insns_.insert(std::find(st->insns_.begin(), st->insns_.end(), tr),
+		      sel_insn);
+  }
+  tr->inputs_.clear();
+  tr->target_states_.clear();
+  tr->target_states_.push_back(join);
+  vector<IState *> states;
+  for (IState *s : table_->states_) {
+    if (std::find(sides.begin(), sides.end(), s) == sides.end()) {
+      states.push_back(s);
+    }
+  }
+  table_->states_ = states;
+  touched_.insert(st);
+  touched_.insert(join);
+  ++num_converted_;
+}
+
+void IfConversion::MergeSide(IState *st, IInsn *tr, IState *side,
+			     const string &suffix, set<IResource *> *used,
+			     map<IRegister *, IRegister *> *values,
+			     vector<IRegister *> *outputs) {
+  touched_.insert(side);
+  // Renames all the outputs, so the sides don't write the same wire.
+  map<IRegister *, IRegister *> wires;
+  for (IInsn *insn : side->insns_) {
+    for (IRegister *reg : insn->outputs_) {
+      IRegister *wire = AllocWire(reg, suffix);
+      if (reg->IsStateLocal()) {
+	wires[reg] = wire;
+      } else {
+	(*values)[reg] = wire;
+	if (std::find(outputs->begin(), outputs->end(), reg) ==
+	    outputs->end()) {
+	  outputs->push_back(reg);
+	}
+      }
+    }
+  }
+  for (IInsn *insn : side->insns_) {
+    if (!insn->target_states_.empty()) {
+      continue;
+    }
+    for (IRegister *&reg : insn->inputs_) {
+      auto it = wires.find(reg);
+      if (it != wires.end()) {
+	reg = it->second;
+      }
+    }
+    for (IRegister *&reg : insn->outputs_) {
+      auto it = wires.find(reg);
+      reg = (it != wires.end()) ? it->second : (*values)[reg];
+    }
+    IResource *res = insn->GetResource();
+    // An exclusive resource can be used once in a state.
+    if (resource::IsExclusiveBinOp(*res->GetClass()) &&
+	!used->insert(res).second) {
+      insn->SetResource(DesignTool::CopySimpleResource(res));
+    }
+    st->insns_.insert(std::find(st->insns_.begin(), st->insns_.end(), tr),
+		      insn);
+  }
+}
+
+IRegister *IfConversion::AllocWire(IRegister *reg, const string &suffix) {
+  IRegister *wire = DesignTool::AllocRegister(table_, reg->GetName() + suffix,
+					      reg->value_type_.GetWidth());
+  wire->value_type_ = reg->value_type_;
+  wire->SetStateLocal(true);
+  return wire;
+}
+
+}  // namespace ifconv
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,62 @@
+// -*- C++ -*-
+//
+// If-conversion of short branches.
+//
+// A state branching to one state side (triangle) or two (diamond) joining
+// at the next state absorbs the sides. Insns of the sides are computed
+// speculatively into new wires, and selects by the branch condition write
+// the registers the sides wrote.
+//
+// Before:
+//  S1: Rc <- .., if Rc then S3 else S2
+//  S2: Rx <- Ra + Rb, -> S4
+//  S3: Rx <- Ra - Rb, -> S4
+// After:
+//  S1: Rc <- .., Wf <- Ra + Rb, Wt <- Ra - Rb, Rx <- select(Rc, Wf, Wt)
+//      -> S4
+//
+// A side can have only a few insns without side effects. The branching
+// state must not write the registers the sides read or write.
+//
+#ifndef _opt_ifconv_if_conversion_h_
+#define _opt_ifconv_if_conversion_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+namespace opt {
+namespace ifconv {
+
+class IfConversion {
+public:
+  IfConversion(ITable *table, AnalysisManager *analysis,
+	       DebugAnnotation *annotation);
+
+  void Perform();
+
+private:
+  bool ConvertBranches();
+  bool ConvertBranch(IState *st);
+  IState *GetSideJoin(IState *st, IState *side);
+  bool CanMerge(IState *st, const vector<IState *> &sides);
+  void Merge(IState *st, IInsn *tr, const vector<IState *> &sides,
+	     IState *join);
+  void MergeSide(IState *st, IInsn *tr, IState *side, const string &suffix,
+		 set<IResource *> *used, map<IRegister *, IRegister *> *values,
+		 vector<IRegister *> *outputs);
+  IRegister *AllocWire(IRegister *reg, const string &suffix);
+
+  ITable *table_;
+  AnalysisManager *analysis_;
+  DebugAnnotation *annotation_;
+  map<IState *, set<IState *> > preds_;
+  // States modified in the current pass.
+  set<IState *> touched_;
+  int num_converted_;
+};
+
+}  // namespace ifconv
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_ifconv_if_conversion_h_
@@ -0,0 +1,29 @@
+#include "opt/ifconv/if_conversion_phase.h"
+
+#include "opt/ifconv/if_conversion.h"
+#include "opt/optimizer.h"
+
+namespace iroha {
+namespace opt {
+namespace ifconv {
+
+IfConversionPhase::~IfConversionPhase() {
+}
+
+Phase *IfConversionPhase::Create() {
+  return new IfConversionPhase();
+}
+
+bool IfConversionPhase::IsTableLocal() {
+  return true;
+}
+
+bool IfConversionPhase::ApplyForTable(const string &key, ITable *table) {
+  IfConversion conv(table, optimizer_->GetAnalysisManager(), annotation_);
+  conv.Perform();
+  return true;
+}
+
+}  // namespace ifconv
+}  // namespace opt
+}  // namespace iroha
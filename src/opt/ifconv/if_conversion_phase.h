@@ -0,0 +1,26 @@
+// -*- C++ -*-
+#ifndef _opt_ifconv_if_conversion_phase_h_
+#define _opt_ifconv_if_conversion_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace ifconv {
+
+class IfConversionPhase : public Phase {
+public:
+  virtual ~IfConversionPhase();
+
+  static Phase *Create();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace ifconv
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_ifconv_if_conversion_phase_h_
@@ -0,0 +1,264 @@
+#include "opt/loop/licm.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
+#include "opt/bb_set.h"
+#include "opt/data_flow.h"
+#include "opt/debug_annotation.h"
+#include "opt/loop/loop_block.h"
+#include "opt/opt_util.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+namespace loop {
+
+LICM::LICM(ITable *table, AnalysisManager *analysis,
+	   DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    index_(nullptr), num_hoisted_(0) {
+}
+
+void LICM::Perform() {
+  index_ = DefUseIndex::GetOrCreate(table_);
+  OptUtil::CollectTransitionPreds(table_, &preds_);
+  // Index registers compared as NUM > index like LoopBlock does.
+  vector<pair<int, IRegister *> > loops;
+  set<IRegister *> seen;
+  for (IState *st : table_->states_) {
+    for (IInsn *insn : st->insns_) {
+      if (!resource::IsGt(*insn->GetResource()->GetClass()) ||
+	  insn->inputs_.size() != 2) {
+	continue;
+      }
+      IRegister *reg = insn->inputs_[1];
+      if (reg->IsConst() || !seen.insert(reg).second) {
+	continue;
+      }
+      LoopBlock *lb = analysis_->GetLoopBlock(table_, reg);
+      if (lb != nullptr) {
+	loops.push_back(make_pair(lb->GetStates().size(), reg));
+      }
+    }
+  }
+  // Inner loops first.
+  std::stable_sort(loops.begin(), loops.end(),
+		   [](const pair<int, IRegister *> &p1,
+		      const pair<int, IRegister *> &p2) {
+		     return p1.first < p2.first;
+		   });
+  for (auto &p : loops) {
+    if (HoistLoop(p.second)) {
+      // Data flow and loops depend on the places of insns.
+      analysis_->Invalidate(table_, AnalysisManager::ANALYSIS_BB_SET);
+    }
+  }
+  if (annotation_->IsEnabled() && num_hoisted_ > 0) {
+    annotation_->Table(table_) << "LICM hoisted " << num_hoisted_
+			       << " insns\n";
+  }
+}
+
+// Before:
+//  S1: Ri <- 0
+//  S2: Rc <(gt)- 10, Ri
+//  S3: if Rc then S4 else S6
+//  S4: Rx <(mul)- Ra, Rb
+//      ..
+//  S5: Ri <- Ri + 1, -> S2
+// After:
+//  S1: Ri <- 0
+//      Rx <(mul)- Ra, Rb
+//  S2: ..
+//  S4: ..
+bool LICM::HoistLoop(IRegister *reg) {
+  LoopBlock *lb = analysis_->GetLoopBlock(table_, reg);
+  if (lb == nullptr) {
+    return false;
+  }
+  set<IState *> loop_states(lb->GetStates().begin(), lb->GetStates().end());
+  IState *entry_st = lb->GetEntryAssignState();
+  if (loop_states.find(entry_st) != loop_states.end()) {
+    return false;
+  }
+  IState *header = FindHeader(loop_states);
+  if (header == nullptr || !HasBackEdge(header, loop_states)) {
+    return false;
+  }
+  // States where a new value of an input is visible to the loop but not
+  // to the entry assign state.
+  set<IState *> region = loop_states;
+  if (!CollectEntryStates(entry_st, header, &region)) {
+    return false;
+  }
+  DataFlow *data_flow = analysis_->GetDataFlow(table_);
+  set<IRegister *> defined;
+  for (RegDef *def : data_flow->all_defs_) {
+    if (region.find(def->st) != region.end()) {
+      defined.insert(def->reg);
+    }
+  }
+  int num_hoisted = 0;
+  for (IState *st : lb->GetStates()) {
+    // Copies the list, since insns are moved out.
+    vector<IInsn *> insns = st->insns_;
+    for (IInsn *insn : insns) {
+      if (!IsCandidate(insn) || !IsInvariant(insn, defined) ||
+	  !CanMoveOutput(st, insn, header, loop_states) ||
+	  !CanUseResource(insn, entry_st)) {
+	continue;
+      }
+      DesignTool::MoveInsn(insn, st, entry_st);
+      ++num_hoisted;
+    }
+  }
+  num_hoisted_ += num_hoisted;
+  return num_hoisted > 0;
+}
+
+// The only loop state entered from outside of the loop.
+IState *LICM::FindHeader(const set<IState *> &loop_states) {
+  IState *header = nullptr;
+  for (IState *st : loop_states) {
+    for (IState *pred : preds_[st]) {
+      if (loop_states.find(pred) != loop_states.end()) {
+	continue;
+      }
+      if (header != nullptr && header != st) {
+	return nullptr;
+      }
+      header = st;
+    }
+  }
+  return header;
+}
+
+// Collects the states from the entry assign state to the header. They
+// should be the only way to enter the loop.
+bool LICM::CollectEntryStates(IState *entry_st, IState *header,
+			      set<IState *> *states) {
+  states->insert(entry_st);
+  IState *prev = entry_st;
+  for (int i = 0; i < table_->states_.size(); ++i) {
+    IState *st = OptUtil::GetOneNextState(prev);
+    if (st == nullptr) {
+      return false;
+    }
+    if (st == header) {
+      for (IState *pred : preds_[header]) {
+	if (pred != prev && states->find(pred) == states->end()) {
+	  return false;
+	}
+      }
+      return true;
+    }
+    if (states->find(st) != states->end() || preds_[st].size() != 1) {
+      return false;
+    }
+    states->insert(st);
+    prev = st;
+  }
+  return false;
+}
+
+bool LICM::HasBackEdge(IState *header, const set<IState *> &loop_states) {
+  BBSet *bset = analysis_->GetBBSet(table_, false);
+  BB *header_bb = bset->state_to_bb_[header];
+  if (header_bb == nullptr || header_bb->states_[0] != header) {
+    return false;
+  }
+  for (BB *bb : header_bb->prev_bbs_) {
+    if (loop_states.find(bb->states_.back()) != loop_states.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LICM::IsCandidate(IInsn *insn) {
+  if (!OptUtil::IsSideEffectFree(insn) || insn->outputs_.size() != 1 ||
+      insn->inputs_.empty()) {
+    return false;
+  }
+  IRegister *out = insn->outputs_[0];
+  return !out->IsConst() && !out->IsStateLocal();
+}
+
+bool LICM::IsInvariant(IInsn *insn, const set<IRegister *> &defined) {
+  for (IRegister *reg : insn->inputs_) {
+    if (reg->IsConst()) {
+      continue;
+    }
+    if (reg->IsStateLocal() || defined.find(reg) != defined.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The output can be written earlier if nothing reads the old value.
+bool LICM::CanMoveOutput(IState *st, IInsn *insn, IState *header,
+			 const set<IState *> &loop_states) {
+  IRegister *out = insn->outputs_[0];
+  if (index_->GetDefs(out).size() != 1) {
+    return false;
+  }
+  // States reachable in an iteration before the insn.
+  set<IState *> before;
+  CollectReachable(header, st, loop_states, &before);
+  for (IInsn *use : index_->GetUses(out)) {
+    IState *use_st = index_->GetState(use);
+    // Uses after the loop may be reached without running the insn.
+    if (use_st == st || loop_states.find(use_st) == loop_states.end() ||
+	before.find(use_st) != before.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// An exclusive resource can be used once in a state.
+bool LICM::CanUseResource(IInsn *insn, IState *entry_st) {
+  IResource *res = insn->GetResource();
+  if (!resource::IsExclusiveBinOp(*res->GetClass())) {
+    return true;
+  }
+  for (IInsn *other : index_->GetInsnsByResource(res)) {
+    if (index_->GetState(other) == entry_st) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LICM::CollectReachable(IState *header, IState *st,
+			    const set<IState *> &loop_states,
+			    set<IState *> *reachable) {
+  if (header == st) {
+    return;
+  }
+  vector<IState *> work;
+  work.push_back(header);
+  reachable->insert(header);
+  while (!work.empty()) {
+    IState *cur = work.back();
+    work.pop_back();
+    for (IInsn *insn : cur->insns_) {
+      for (IState *next : insn->target_states_) {
+	if (next == st || loop_states.find(next) == loop_states.end() ||
+	    !reachable->insert(next).second) {
+	  continue;
+	}
+	work.push_back(next);
+      }
+    }
+  }
+}
+
+}  // namespace loop
+}  // namespace opt
+}  // namespace iroha
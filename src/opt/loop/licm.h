@@ -0,0 +1,58 @@
+// -*- C++ -*-
+//
+// Loop invariant code motion.
+//
+// Finds counted loops by LoopBlock and checks that the loop is entered
+// only from its entry assign state and has a back edge in the BBSet.
+// Then an insn in the loop is moved to the entry assign state if none of
+// its inputs is defined in the loop (according to DataFlow) or between
+// the entry assign state and the loop, and its output is a register
+// read only in the loop after the insn. Inner loops are processed first,
+// so an insn hoisted to an inner loop's entry can be hoisted again.
+//
+#ifndef _opt_loop_licm_h_
+#define _opt_loop_licm_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace loop {
+
+class LICM {
+public:
+  LICM(ITable *table, AnalysisManager *analysis,
+       DebugAnnotation *annotation);
+
+  void Perform();
+
+private:
+  bool HoistLoop(IRegister *reg);
+  IState *FindHeader(const set<IState *> &loop_states);
+  bool CollectEntryStates(IState *entry_st, IState *header,
+			  set<IState *> *states);
+  bool HasBackEdge(IState *header, const set<IState *> &loop_states);
+  bool IsCandidate(IInsn *insn);
+  bool IsInvariant(IInsn *insn, const set<IRegister *> &defined);
+  bool CanMoveOutput(IState *st, IInsn *insn, IState *header,
+		     const set<IState *> &loop_states);
+  bool CanUseResource(IInsn *insn, IState *entry_st);
+  void CollectReachable(IState *header, IState *st,
+			const set<IState *> &loop_states,
+			set<IState *> *reachable);
+
+  ITable *table_;
+  AnalysisManager *analysis_;
+  DebugAnnotation *annotation_;
+  DefUseIndex *index_;
+  map<IState *, set<IState *> > preds_;
+  int num_hoisted_;
+};
+
+}  // namespace loop
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_loop_licm_h_
@@ -0,0 +1,36 @@
+#include "opt/loop/licm_phase.h"
+
+#include "opt/analysis_manager.h"
+#include "opt/loop/licm.h"
+#include "opt/optimizer.h"
+
+namespace iroha {
+namespace opt {
+namespace loop {
+
+LICMPhase::~LICMPhase() {
+}
+
+Phase *LICMPhase::Create() {
+  return new LICMPhase();
+}
+
+bool LICMPhase::IsTableLocal() {
+  return true;
+}
+
+int LICMPhase::GetPreservedAnalyses() {
+  // States and transitions are not modified.
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
+bool LICMPhase::ApplyForTable(const string &key, ITable *table) {
+  LICM licm(table, optimizer_->GetAnalysisManager(), annotation_);
+  licm.Perform();
+  return true;
+}
+
+}  // namespace loop
+}  // namespace opt
+}  // namespace iroha
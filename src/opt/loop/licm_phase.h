@@ -0,0 +1,27 @@
+// -*- C++ -*-
+#ifndef _opt_loop_licm_phase_h_
+#define _opt_loop_licm_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace loop {
+
+class LICMPhase : public Phase {
+public:
+  virtual ~LICMPhase();
+
+  static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace loop
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_loop_licm_phase_h_
@@ -46,8 +46,13 @@ bool LoopBlock::Build() {
   if (compare_insn_ == nullptr) {
     return false;
   }
-  loop_count_ = compare_insn_->inputs_[0]->GetInitialValue().GetValue0();
+  if (HasConstantCount()) {
+    loop_count_ = compare_insn_->inputs_[0]->GetInitialValue().GetValue0();
+  }
   IState *tr_st = FindTransition(compare_st_, compare_insn_);
+  if (tr_st == nullptr) {
+    return false;
+  }
   branch_insn_ = DesignUtil::FindTransitionInsn(tr_st);
   exit_st_ = branch_insn_->target_states_[0];
   if (exit_st_ == nullptr) {
@@ -61,6 +66,10 @@ int LoopBlock::GetLoopCount() {
   return loop_count_;
 }
 
+bool LoopBlock::HasConstantCount() {
+  return compare_insn_->inputs_[0]->IsConst();
+}
+
 vector<IState *> &LoopBlock::GetStates() {
   return states_;
 }
@@ -89,9 +98,12 @@ IInsn *LoopBlock::CompareResult(IInsn *insn) {
   if (!resource::IsGt(*rc)) {
     return nullptr;
   }
-  // CONST >GT> counter
-  if (insn->inputs_[0]->IsConst() &&
-      insn->inputs_[1] == reg_) {
+  // CONST >GT> counter or REG >GT> counter
+  IRegister *num = insn->inputs_[0];
+  if (insn->inputs_[1] != reg_ || num == reg_) {
+    return nullptr;
+  }
+  if (num->IsConst() || num->IsNormal()) {
     return insn;
   }
   return nullptr;
@@ -11,6 +11,7 @@ namespace loop {
 // Loop states *.
 //   (Sa) Sets initial value
 // * (Sb) num > count then ->Sc else -> Se
+//        (num is a constant or a register)
 // * (Sc..) ..
 // * (Sd) count += 1, ->Sb
 //   (Se) ..
@@ -20,7 +21,9 @@ public:
 
   bool Build();
 
+  // Valid only if the count is a constant.
   int GetLoopCount();
+  bool HasConstantCount();
   vector<IState *> &GetStates();
   IState *GetEntryAssignState();
   IState *GetExitState();
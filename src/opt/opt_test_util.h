@@ -0,0 +1,47 @@
+// -*- C++ -*-
+#ifndef _opt_opt_test_util_h_
+#define _opt_opt_test_util_h_
+
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+
+namespace iroha {
+namespace opt {
+
+// Builds small tables for the tests of opt phases.
+class OptTestUtil {
+public:
+  // Adds a module with a table of num_states states to design. The first
+  // state is the initial state, and each state goes to the next one if
+  // chain is true.
+  static ITable *NewTable(IDesign *design, int num_states, bool chain,
+			  vector<IState *> *states) {
+    IModule *mod = new IModule(design, "m");
+    design->modules_.push_back(mod);
+    ITable *tab = new ITable(mod);
+    mod->tables_.push_back(tab);
+    for (int i = 0; i < num_states; ++i) {
+      IState *st = new IState(tab);
+      tab->states_.push_back(st);
+      states->push_back(st);
+    }
+    tab->SetInitialState(states->at(0));
+    for (int i = 0; chain && i + 1 < num_states; ++i) {
+      DesignTool::AddNextState(states->at(i), states->at(i + 1));
+    }
+    return tab;
+  }
+  static IInsn *AddInsn(IState *st, IResource *res,
+			const vector<IRegister *> &inputs, IRegister *out) {
+    IInsn *insn = new IInsn(res);
+    insn->inputs_ = inputs;
+    insn->outputs_.push_back(out);
+    st->insns_.push_back(insn);
+    return insn;
+  }
+};
+
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_opt_test_util_h_
@@ -1,8 +1,10 @@
 #include "opt/opt_util.h"
 
+#include "design/def_use_index.h"
 #include "design/design_util.h"
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
+#include "iroha/resource_class.h"
 
 namespace iroha {
 namespace opt {
@@ -74,6 +76,20 @@ void OptUtil::CollectTransitionTargets(ITable *tab,
   }
 }
 
+void OptUtil::CollectTransitionPreds(ITable *tab,
+				     map<IState *, set<IState *> > *preds) {
+  IResource *tr = DesignUtil::FindTransitionResource(tab);
+  for (auto st : tab->states_) {
+    IInsn *tr_insn = DesignUtil::FindInsnByResource(st, tr);
+    if (tr_insn == nullptr) {
+      continue;
+    }
+    for (auto t : tr_insn->target_states_) {
+      (*preds)[t].insert(st);
+    }
+  }
+}
+
 IState *OptUtil::GetOneNextState(IState *cur) {
   ITable *tab = cur->GetTable();
   IResource *tr = DesignUtil::FindTransitionResource(tab);
@@ -88,5 +104,30 @@ IState *OptUtil::GetOneNextState(IState *cur) {
   return tr_insn->target_states_[0];
 }
 
+bool OptUtil::ReadsOldValue(IRegister *reg, IInsn *insn, DefUseIndex *index) {
+  if (reg->IsStateLocal()) {
+    return false;
+  }
+  IState *st = index->GetState(insn);
+  for (IInsn *def : index->GetDefs(reg)) {
+    if (index->GetState(def) == st) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool OptUtil::IsSideEffectFree(IInsn *insn) {
+  if (insn->outputs_.empty() || !insn->target_states_.empty() ||
+      !insn->depending_insns_.empty()) {
+    return false;
+  }
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  return (resource::IsSet(*rc) || resource::IsExclusiveBinOp(*rc) ||
+	  resource::IsLightBinOp(*rc) || resource::IsLightUniOp(*rc) ||
+	  resource::IsBitShiftOp(*rc) || resource::IsBitSel(*rc) ||
+	  resource::IsBitConcat(*rc) || resource::IsSelect(*rc));
+}
+
 }  // namespace opt
 }  // namespace iroha
@@ -8,6 +8,8 @@
 #include <set>
 
 namespace iroha {
+class DefUseIndex;
+
 namespace opt {
 
 class TransitionInfo {
@@ -27,11 +29,17 @@ public:
 						set<IState *> *reachable);
   static void CollectTransitionInfo(ITable *tab,
 				    map<IState *, TransitionInfo> *transition_info);
-  static IState *GetOneNextState(IState *cur);
-
-private:
   static void CollectTransitionTargets(ITable *tab,
 				       map<IState *, set<IState *> > *targets);
+  static void CollectTransitionPreds(ITable *tab,
+				     map<IState *, set<IState *> > *preds);
+  static IState *GetOneNextState(IState *cur);
+  // reg is written in the state of insn, so insn reads the value before
+  // the update.
+  static bool ReadsOldValue(IRegister *reg, IInsn *insn, DefUseIndex *index);
+  // insn computes its outputs only from its inputs (assignments, operators,
+  // bit operations and selects), so it can be moved, copied or removed.
+  static bool IsSideEffectFree(IInsn *insn);
 };
 
 }  // namespace opt
@@ -1,8 +1,10 @@
 #include "opt/optimizer.h"
 
+#include "design/def_use_index.h"
 #include "design/validator.h"
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
+#include "opt/analysis_manager.h"
 #include "opt/array_elimination.h"
 #include "opt/array_split_rdata.h"
 #include "opt/clean/empty_state.h"
@@ -12,25 +14,37 @@
 #include "opt/clean/unused_register.h"
 #include "opt/clean/unused_resource.h"
 #include "opt/constant/constant_propagation.h"
+#include "opt/constant/sccp_phase.h"
 #include "opt/compound.h"
 #include "opt/debug_annotation.h"
+#include "opt/gvn/gvn_phase.h"
+#include "opt/ifconv/if_conversion_phase.h"
+#include "opt/loop/licm_phase.h"
 #include "opt/phase.h"
+#include "opt/phase_stats.h"
 #include "opt/pipeline/pipeline_phase.h"
 #include "opt/sched/sched_phase.h"
 #include "opt/ssa/ssa.h"
+#include "opt/strength/strength_reduction_phase.h"
 #include "opt/study.h"
 #include "opt/unroll/unroll_phase.h"
+#include "opt/width/narrow_width_phase.h"
 #include "platform/platform.h"
 #include "platform/platform_db.h"
 
+#include <fstream>
+
 namespace iroha {
 namespace opt {
 
 map<string, function<Phase *()> > Optimizer::phases_;
+std::mutex Optimizer::phases_mu_;
 
-Optimizer::Optimizer(IDesign *design) : design_(design) {
+Optimizer::Optimizer(IDesign *design)
+  : design_(design), num_jobs_(1), validation_mode_(VALIDATE_INCREMENTAL) {
   design_->SetDebugAnnotation(new DebugAnnotation);
   platform_db_.reset(platform::Platform::CreatePlatformDB(design));
+  analysis_.reset(new AnalysisManager(design_->GetDebugAnnotation()));
 }
 
 Optimizer::~Optimizer() {
@@ -51,6 +65,13 @@ void Optimizer::Init() {
 		&clean::CleanPseudoResourcePhase::Create);
   RegisterPhase("constant_propagation",
 		&constant::ConstantPropagation::Create);
+  RegisterPhase("sccp", &constant::SCCPPhase::Create);
+  RegisterPhase("gvn", &gvn::GVNPhase::Create);
+  RegisterPhase("narrow_width", &width::NarrowWidthPhase::Create);
+  RegisterPhase("strength_reduction",
+		&strength::StrengthReductionPhase::Create);
+  RegisterPhase("licm", &loop::LICMPhase::Create);
+  RegisterPhase("if_conversion", &ifconv::IfConversionPhase::Create);
   RegisterPhase("ssa_convert", &ssa::SSAConverterPhase::Create);
   RegisterPhase("phi_cleaner", &ssa::PhiCleanerPhase::Create);
   RegisterPhase("alloc_resource", &sched::SchedPhase::Create);
@@ -62,6 +83,7 @@ void Optimizer::Init() {
 }
 
 vector<string> Optimizer::GetPhaseNames() {
+  std::lock_guard<std::mutex> lock(phases_mu_);
   vector<string> names;
   for (auto it : phases_) {
     names.push_back(it.first);
@@ -71,38 +93,158 @@ vector<string> Optimizer::GetPhaseNames() {
 
 void Optimizer::RegisterPhase(const string &name,
 			      function<Phase *()> factory) {
+  std::lock_guard<std::mutex> lock(phases_mu_);
   phases_[name] = factory;
 }
 
 bool Optimizer::ApplyPhase(const string &name) {
-  auto it = phases_.find(name);
-  if (it == phases_.end()) {
+  function<Phase *()> factory;
+  {
+    std::lock_guard<std::mutex> lock(phases_mu_);
+    auto it = phases_.find(name);
+    if (it != phases_.end()) {
+      factory = it->second;
+    }
+  }
+  if (!factory) {
     LOG(USER) << "Unknown optimization phase: " << name;
     return false;
   }
-  auto factory = it->second;
   unique_ptr<Phase> phase(factory());
   phase->SetName(name);
   phase->SetOptimizer(this);
   auto *annotation = design_->GetDebugAnnotation();
   phase->SetAnnotation(annotation);
   annotation->StartPhase(name);
+  PhaseStats::Sample start;
+  if (stats_.get() != nullptr) {
+    phase->SetStatsId(stats_->StartPhase(name, design_));
+    PhaseStats::TakeSample(false, &start);
+  }
   bool isOk = phase->Apply(design_);
+  // Phases may modify insns without updating the indexes.
+  DefUseIndex::DropAll(design_);
   if (isOk) {
-    Validator::Validate(design_);
+    analysis_->InvalidateAll(phase->GetPreservedAnalyses());
+  } else {
+    analysis_->InvalidateAll(AnalysisManager::ANALYSIS_NONE);
+  }
+  double validate_start = 0;
+  if (stats_.get() != nullptr) {
+    PhaseStats::Sample s;
+    PhaseStats::TakeSample(false, &s);
+    validate_start = s.wall;
+  }
+  if (isOk) {
+    ValidateAfterPhase();
+  }
+  if (stats_.get() != nullptr) {
+    PhaseStats::Sample s;
+    PhaseStats::TakeSample(false, &s);
+    stats_->EndPhase(phase->GetStatsId(), design_, start,
+		     s.wall - validate_start);
   }
   return isOk;
 }
 
+void Optimizer::ValidateAfterPhase() {
+  if (validation_mode_ == VALIDATE_FULL) {
+    Validator::Validate(design_);
+    return;
+  }
+  set<IModule *> modules;
+  Validator::ValidateModified(design_, &modules);
+  if (validation_mode_ == VALIDATE_DEFERRED) {
+    return;
+  }
+  for (IModule *mod : modules) {
+    Validator::ValidateRegName(mod);
+  }
+}
+
+bool Optimizer::SetValidationMode(const string &mode) {
+  if (mode == "incremental") {
+    validation_mode_ = VALIDATE_INCREMENTAL;
+  } else if (mode == "deferred") {
+    validation_mode_ = VALIDATE_DEFERRED;
+  } else if (mode == "full") {
+    validation_mode_ = VALIDATE_FULL;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void Optimizer::FinishPhases() {
+  if (validation_mode_ == VALIDATE_DEFERRED) {
+    Validator::Validate(design_);
+  }
+}
+
 void Optimizer::EnableDebugAnnotation() {
   DebugAnnotation *an = design_->GetDebugAnnotation();
   an->Enable();
 }
 
+void Optimizer::SetNumJobs(int num_jobs) {
+  num_jobs_ = num_jobs;
+}
+
+int Optimizer::GetNumJobs() {
+  return num_jobs_;
+}
+
+void Optimizer::EnablePhaseStats() {
+  stats_.reset(new PhaseStats);
+}
+
+PhaseStats *Optimizer::GetPhaseStats() {
+  return stats_.get();
+}
+
+void Optimizer::StartStatsStep(const string &name) {
+  if (stats_.get() == nullptr) {
+    return;
+  }
+  stats_step_ = name;
+  PhaseStats::TakeSample(false, &stats_step_start_);
+}
+
+void Optimizer::EndStatsStep() {
+  if (stats_.get() == nullptr) {
+    return;
+  }
+  stats_->AddStep(stats_step_, stats_step_start_);
+}
+
+void Optimizer::WritePhaseStats(const string &json_fn) {
+  if (stats_.get() == nullptr) {
+    return;
+  }
+  ostream *os = Logger::GetOutput();
+  if (os == nullptr) {
+    os = &cerr;
+  }
+  stats_->WriteText(*os);
+  if (json_fn.empty()) {
+    return;
+  }
+  ofstream ofs(json_fn);
+  if (!ofs) {
+    LOG(USER) << "Failed to open: " << json_fn;
+    return;
+  }
+  stats_->WriteJson(ofs);
+}
+
 platform::PlatformDB *Optimizer::GetPlatformDB() {
   return platform_db_.get();
 }
 
+AnalysisManager *Optimizer::GetAnalysisManager() {
+  return analysis_.get();
+}
+
 void Optimizer::DumpIntermediateToFiles(const string &fn) {
   if (fn.empty()) {
     return;
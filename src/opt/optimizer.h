@@ -4,9 +4,11 @@
 
 #include "iroha/opt_api.h"
 #include "opt/phase.h"
+#include "opt/phase_stats.h"
 
 #include <functional>
 #include <map>
+#include <mutex>
 
 namespace iroha {
 namespace opt {
@@ -23,15 +25,42 @@ public:
 
   virtual bool ApplyPhase(const string &name) override;
   virtual void EnableDebugAnnotation() override;
+  virtual void SetNumJobs(int num_jobs) override;
+  virtual bool SetValidationMode(const string &mode) override;
+  virtual void FinishPhases() override;
   virtual void DumpIntermediateToFiles(const string &fn) override;
+  virtual void EnablePhaseStats() override;
+  virtual void StartStatsStep(const string &name) override;
+  virtual void EndStatsStep() override;
+  virtual void WritePhaseStats(const string &json_fn) override;
 
   platform::PlatformDB *GetPlatformDB();
+  AnalysisManager *GetAnalysisManager();
+  int GetNumJobs();
+  // nullptr unless enabled.
+  PhaseStats *GetPhaseStats();
 
 protected:
+  enum ValidationMode {
+    VALIDATE_INCREMENTAL,
+    VALIDATE_DEFERRED,
+    VALIDATE_FULL,
+  };
+
+  void ValidateAfterPhase();
+
   IDesign *design_;
   std::unique_ptr<platform::PlatformDB> platform_db_;
+  std::unique_ptr<AnalysisManager> analysis_;
+  int num_jobs_;
+  ValidationMode validation_mode_;
+  std::unique_ptr<PhaseStats> stats_;
+  string stats_step_;
+  PhaseStats::Sample stats_step_start_;
 
+  // Registered once by Init(), but looked up from multiple threads.
   static map<string, function<Phase *()> > phases_;
+  static std::mutex phases_mu_;
 };
 
 }  // namespace opt
@@ -1,12 +1,20 @@
 #include "opt/phase.h"
 
 #include "iroha/i_design.h"
+#include "iroha/logging.h"
+#include "opt/analysis_manager.h"
 #include "opt/debug_annotation.h"
+#include "opt/optimizer.h"
+#include "opt/phase_stats.h"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
 
 namespace iroha {
 namespace opt {
 
-Phase::Phase() : optimizer_(nullptr), annotation_(nullptr) {
+Phase::Phase() : optimizer_(nullptr), annotation_(nullptr), stats_id_(-1) {
 }
 
 Phase::~Phase() {
@@ -29,11 +37,32 @@ bool Phase::Apply(IDesign *design) {
   return ApplyForDesign(design);
 }
 
+void Phase::SetStatsId(int id) {
+  stats_id_ = id;
+}
+
+int Phase::GetStatsId() {
+  return stats_id_;
+}
+
+int Phase::GetPreservedAnalyses() {
+  return AnalysisManager::ANALYSIS_NONE;
+}
+
+bool Phase::IsTableLocal() {
+  return false;
+}
+
 bool Phase::ApplyForDesign(IDesign *design) {
   return ApplyForAllModules("", design);
 }
 
 bool Phase::ApplyForAllModules(const string &key, IDesign *design) {
+  int num_jobs = (optimizer_ != nullptr) ? optimizer_->GetNumJobs() : 1;
+  // Annotations are written in the order of tables.
+  if (num_jobs > 1 && IsTableLocal() && !annotation_->IsEnabled()) {
+    return ApplyForAllTablesInParallel(key, design, num_jobs);
+  }
   bool all_ok = true;
   for (auto *mod : design->modules_) {
     all_ok &= ApplyForModule(key, mod);
@@ -41,14 +70,73 @@ bool Phase::ApplyForAllModules(const string &key, IDesign *design) {
   return all_ok;
 }
 
+bool Phase::ApplyForAllTablesInParallel(const string &key, IDesign *design,
+				       int num_jobs) {
+  vector<ITable *> tables;
+  for (IModule *mod : design->modules_) {
+    for (ITable *tab : mod->tables_) {
+      tables.push_back(tab);
+    }
+  }
+  // Each thread takes the next table when it finishes one, so a large
+  // table doesn't block others. Messages are buffered per table and
+  // emitted in the order of tables.
+  struct Task {
+    ostringstream log;
+    bool ok;
+  };
+  vector<Task> tasks(tables.size());
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    int i;
+    while ((i = next++) < (int)tables.size()) {
+      Logger::SetOutput(&tasks[i].log);
+      tasks[i].ok = ApplyForOneTable(key, tables[i]);
+      Logger::SetOutput(nullptr);
+    }
+  };
+  vector<std::thread> threads;
+  for (int i = 0; i < num_jobs && i < (int)tables.size(); ++i) {
+    threads.push_back(std::thread(worker));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  ostream *os = Logger::GetOutput();
+  if (os == nullptr) {
+    os = &cerr;
+  }
+  bool all_ok = true;
+  for (Task &task : tasks) {
+    *os << task.log.str();
+    all_ok &= task.ok;
+  }
+  return all_ok;
+}
+
 bool Phase::ApplyForModule(const string &key, IModule *module) {
   bool all_ok = true;
   for (auto *table : module->tables_) {
-    all_ok &= ApplyForTable(key, table);
+    all_ok &= ApplyForOneTable(key, table);
   }
   return all_ok;
 }
 
+bool Phase::ApplyForOneTable(const string &key, ITable *table) {
+  PhaseStats *stats = nullptr;
+  if (optimizer_ != nullptr && stats_id_ >= 0) {
+    stats = optimizer_->GetPhaseStats();
+  }
+  if (stats == nullptr) {
+    return ApplyForTable(key, table);
+  }
+  PhaseStats::Sample start;
+  PhaseStats::TakeSample(true, &start);
+  bool ok = ApplyForTable(key, table);
+  stats->AddTable(stats_id_, table, start);
+  return ok;
+}
+
 bool Phase::ApplyForTable(const string &key, ITable *table) {
   return true;
 }
@@ -16,8 +16,18 @@ public:
   void SetName(const string &name);
   void SetOptimizer(Optimizer *opt);
   void SetAnnotation(DebugAnnotation *annotation);
+  // Set if PhaseStats is enabled.
+  void SetStatsId(int id);
+  int GetStatsId();
 
   bool Apply(IDesign *design);
+  // Bits of AnalysisManager::AnalysisKind kept valid by this phase.
+  // Default implementation preserves nothing.
+  virtual int GetPreservedAnalyses();
+  // True if ApplyForTable() only modifies objects owned by the table, so
+  // tables can be processed on multiple threads (-opt-jobs).
+  // Default implementation returns false.
+  virtual bool IsTableLocal();
 
 protected:
   // Default implementation just traverses modules and tables.
@@ -28,12 +38,17 @@ protected:
   virtual bool ApplyForTable(const string &key, ITable *table);
 
   bool ApplyForAllModules(const string &key, IDesign *design);
+  bool ApplyForAllTablesInParallel(const string &key, IDesign *design,
+				   int num_jobs);
+  // Calls ApplyForTable() and records the stats.
+  bool ApplyForOneTable(const string &key, ITable *table);
   void OutputPhaseHeader(const string &msg);
 
   Optimizer *optimizer_;
   // Optimizers can assume this is not null.
   DebugAnnotation *annotation_;
   string name_;
+  int stats_id_;
 };
 
 }  // namespace opt
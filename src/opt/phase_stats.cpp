@@ -0,0 +1,264 @@
+#include "opt/phase_stats.h"
+
+#include "iroha/i_design.h"
+
+#include <iomanip>
+#include <sys/resource.h>
+#include <time.h>
+
+namespace iroha {
+namespace opt {
+
+namespace {
+
+double Now(clockid_t clock) {
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+long MaxRssKB() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+string JsonString(const string &s) {
+  string r = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      r += '\\';
+    }
+    r += c;
+  }
+  return r + "\"";
+}
+
+string CountDiff(int before, int after) {
+  return Util::Itoa(before) + "->" + Util::Itoa(after);
+}
+
+void WriteJsonCounts(const string &key, const PhaseStats::Counts &c,
+		     ostream &os) {
+  os << JsonString(key) << ": {\"states\": " << c.states
+     << ", \"insns\": " << c.insns << ", \"registers\": " << c.registers
+     << "}";
+}
+
+}  // namespace
+
+void PhaseStats::TakeSample(bool thread_cpu, Sample *s) {
+  s->wall = Now(CLOCK_MONOTONIC);
+  s->cpu = Now(thread_cpu ? CLOCK_THREAD_CPUTIME_ID :
+	       CLOCK_PROCESS_CPUTIME_ID);
+  s->rss = MaxRssKB();
+}
+
+void PhaseStats::CountTable(const ITable *table, Counts *counts) {
+  counts->states += table->states_.size();
+  for (IState *st : table->states_) {
+    counts->insns += st->insns_.size();
+  }
+  counts->registers += table->registers_.size();
+}
+
+void PhaseStats::CountDesign(const IDesign *design, Counts *counts) {
+  for (IModule *mod : design->modules_) {
+    for (ITable *tab : mod->tables_) {
+      CountTable(tab, counts);
+    }
+  }
+}
+
+int PhaseStats::StartPhase(const string &name, const IDesign *design) {
+  std::lock_guard<std::mutex> lock(mu_);
+  int id = entries_.size();
+  Entry e;
+  e.name = name;
+  e.has_counts = true;
+  vector<Entry> &tables = table_entries_[id];
+  for (IModule *mod : design->modules_) {
+    for (ITable *tab : mod->tables_) {
+      Entry t;
+      t.name = name;
+      t.module = mod->GetName();
+      t.table_id = tab->GetId();
+      t.has_counts = true;
+      CountTable(tab, &t.before);
+      CountTable(tab, &e.before);
+      table_index_[make_pair(id, tab)] = tables.size();
+      tables.push_back(t);
+    }
+  }
+  entries_.push_back(e);
+  return id;
+}
+
+void PhaseStats::EndPhase(int id, const IDesign *design, const Sample &start,
+			  double validate_ms) {
+  std::lock_guard<std::mutex> lock(mu_);
+  Entry &e = entries_[id];
+  Measure(start, false, &e);
+  e.validate_ms = validate_ms;
+  CountDesign(design, &e.after);
+}
+
+void PhaseStats::AddTable(int id, const ITable *table, const Sample &start) {
+  Entry measured;
+  Measure(start, true, &measured);
+  Counts after;
+  CountTable(table, &after);
+  std::lock_guard<std::mutex> lock(mu_);
+  vector<Entry> &tables = table_entries_[id];
+  auto key = make_pair(id, table);
+  auto it = table_index_.find(key);
+  if (it == table_index_.end()) {
+    // Created during the phase.
+    Entry t;
+    t.name = entries_[id].name;
+    t.module = table->GetModule()->GetName();
+    t.table_id = table->GetId();
+    t.has_counts = true;
+    it = table_index_.insert(make_pair(key, (int)tables.size())).first;
+    tables.push_back(t);
+  }
+  Entry &t = tables[it->second];
+  t.visited = true;
+  t.wall_ms += measured.wall_ms;
+  t.cpu_ms += measured.cpu_ms;
+  t.rss_delta_kb += measured.rss_delta_kb;
+  t.after = after;
+}
+
+void PhaseStats::AddStep(const string &name, const Sample &start) {
+  Entry e;
+  e.name = name;
+  Measure(start, false, &e);
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.push_back(e);
+}
+
+void PhaseStats::Measure(const Sample &start, bool thread_cpu, Entry *e) {
+  Sample now;
+  TakeSample(thread_cpu, &now);
+  e->wall_ms = now.wall - start.wall;
+  e->cpu_ms = now.cpu - start.cpu;
+  e->rss_delta_kb = now.rss - start.rss;
+}
+
+void PhaseStats::WriteText(ostream &os) {
+  std::lock_guard<std::mutex> lock(mu_);
+  os << std::left << std::setw(28) << "phase/table"
+     << std::right << std::setw(11) << "wall(ms)"
+     << std::setw(11) << "cpu(ms)"
+     << std::setw(10) << "rss(KB)"
+     << std::setw(11) << "valid(ms)"
+     << "  " << std::left << std::setw(14) << "states"
+     << std::setw(16) << "insns"
+     << "registers\n";
+  for (int id = 0; id < entries_.size(); ++id) {
+    WriteTextEntry(entries_[id], os);
+    for (const Entry &t : table_entries_[id]) {
+      if (t.visited) {
+	WriteTextEntry(t, os);
+      }
+    }
+  }
+}
+
+void PhaseStats::WriteTextEntry(const Entry &e, ostream &os) {
+  string name = e.name;
+  if (!e.module.empty()) {
+    name = "  " + e.module + ":" + Util::Itoa(e.table_id);
+  }
+  std::streamsize prec = os.precision();
+  os << std::left << std::setw(28) << name << std::right << std::fixed
+     << std::setprecision(3)
+     << std::setw(11) << e.wall_ms
+     << std::setw(11) << e.cpu_ms
+     << std::setw(10) << e.rss_delta_kb;
+  if (e.module.empty() && e.has_counts) {
+    os << std::setw(11) << e.validate_ms;
+  } else {
+    os << std::setw(11) << "-";
+  }
+  if (e.has_counts) {
+    os << "  " << std::left
+       << std::setw(14) << CountDiff(e.before.states, e.after.states)
+       << std::setw(16) << CountDiff(e.before.insns, e.after.insns)
+       << CountDiff(e.before.registers, e.after.registers);
+  }
+  os << "\n";
+  os.unsetf(std::ios::floatfield);
+  os.precision(prec);
+}
+
+void PhaseStats::WriteJson(ostream &os) {
+  std::lock_guard<std::mutex> lock(mu_);
+  os << "{\n  \"phases\": [";
+  bool first = true;
+  for (int id = 0; id < entries_.size(); ++id) {
+    const Entry &e = entries_[id];
+    if (!e.has_counts) {
+      continue;
+    }
+    os << (first ? "\n" : ",\n") << "    ";
+    first = false;
+    WriteJsonEntry(e, "    ", os);
+    os << ", \"tables\": [";
+    bool first_table = true;
+    for (const Entry &t : table_entries_[id]) {
+      if (!t.visited) {
+	continue;
+      }
+      os << (first_table ? "\n" : ",\n") << "      ";
+      first_table = false;
+      WriteJsonEntry(t, "      ", os);
+      os << "}";
+    }
+    os << "]}";
+  }
+  os << "\n  ],\n  \"steps\": [";
+  first = true;
+  for (const Entry &e : entries_) {
+    if (e.has_counts) {
+      continue;
+    }
+    os << (first ? "\n" : ",\n") << "    ";
+    first = false;
+    WriteJsonEntry(e, "    ", os);
+    os << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+// Writes fields of e without the closing brace.
+void PhaseStats::WriteJsonEntry(const Entry &e, const string &indent,
+				ostream &os) {
+  os << "{";
+  if (e.module.empty()) {
+    os << "\"name\": " << JsonString(e.name);
+  } else {
+    os << "\"module\": " << JsonString(e.module)
+       << ", \"table\": " << e.table_id;
+  }
+  std::streamsize prec = os.precision();
+  os << std::fixed << std::setprecision(3)
+     << ", \"wall_ms\": " << e.wall_ms
+     << ", \"cpu_ms\": " << e.cpu_ms
+     << ", \"rss_delta_kb\": " << e.rss_delta_kb;
+  if (e.module.empty() && e.has_counts) {
+    os << ", \"validate_ms\": " << e.validate_ms;
+  }
+  os.unsetf(std::ios::floatfield);
+  os.precision(prec);
+  if (e.has_counts) {
+    os << ",\n" << indent << " ";
+    WriteJsonCounts("before", e.before, os);
+    os << ", ";
+    WriteJsonCounts("after", e.after, os);
+  }
+}
+
+}  // namespace opt
+}  // namespace iroha
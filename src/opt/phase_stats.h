@@ -0,0 +1,89 @@
+// -*- C++ -*-
+//
+// Collects time, memory and object counts of each phase and table
+// (--phase-stats).
+//
+// Peak RSS is per process, so the delta of a table also includes other
+// tables processed at the same time with -opt-jobs.
+//
+#ifndef _opt_phase_stats_h_
+#define _opt_phase_stats_h_
+
+#include "opt/common.h"
+
+#include <mutex>
+
+namespace iroha {
+namespace opt {
+
+class PhaseStats {
+public:
+  struct Counts {
+    Counts() : states(0), insns(0), registers(0) {}
+    int states;
+    int insns;
+    int registers;
+  };
+
+  // Snapshot at the start of a measurement.
+  struct Sample {
+    double wall;
+    double cpu;
+    long rss;
+  };
+
+  // thread_cpu to measure the CPU time of the calling thread instead of
+  // the whole process.
+  static void TakeSample(bool thread_cpu, Sample *s);
+  static void CountTable(const ITable *table, Counts *counts);
+  static void CountDesign(const IDesign *design, Counts *counts);
+
+  // Returns an id to pass to other methods. Takes object counts of each
+  // table before the phase.
+  int StartPhase(const string &name, const IDesign *design);
+  void EndPhase(int id, const IDesign *design, const Sample &start,
+		double validate_ms);
+  // Called after ApplyForTable(). Accumulates if the table is processed
+  // multiple times in a phase. Can be called from multiple threads.
+  void AddTable(int id, const ITable *table, const Sample &start);
+  // Steps outside of the optimizer (e.g. writer).
+  void AddStep(const string &name, const Sample &start);
+
+  void WriteText(ostream &os);
+  void WriteJson(ostream &os);
+
+private:
+  struct Entry {
+    Entry() : table_id(-1), visited(false), wall_ms(0), cpu_ms(0),
+	      rss_delta_kb(0), validate_ms(0), has_counts(false) {}
+    string name;
+    // Empty for the entire design.
+    string module;
+    int table_id;
+    bool visited;
+    double wall_ms;
+    double cpu_ms;
+    long rss_delta_kb;
+    double validate_ms;
+    bool has_counts;
+    Counts before;
+    Counts after;
+  };
+
+  static void Measure(const Sample &start, bool thread_cpu, Entry *e);
+  static void WriteTextEntry(const Entry &e, ostream &os);
+  static void WriteJsonEntry(const Entry &e, const string &indent,
+			     ostream &os);
+
+  std::mutex mu_;
+  // Phases in the order of the start and steps.
+  vector<Entry> entries_;
+  // Tables of each phase id in the order of the design.
+  map<int, vector<Entry> > table_entries_;
+  map<pair<int, const ITable *>, int> table_index_;
+};
+
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_phase_stats_h_
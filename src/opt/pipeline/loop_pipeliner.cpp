@@ -0,0 +1,549 @@
+#include "opt/pipeline/loop_pipeliner.h"
+
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "opt/debug_annotation.h"
+#include "opt/delay_info.h"
+#include "opt/loop/loop_block.h"
+#include "opt/sched/resource_entry.h"
+#include "opt/sched/virtual_resource.h"
+#include "opt/sched/virtual_resource_set.h"
+
+namespace iroha {
+namespace opt {
+namespace pipeline {
+
+LoopPipeliner::LoopPipeliner(ITable *tab, loop::LoopBlock *lb,
+			     IRegister *index, DelayInfo *delay_info,
+			     DebugAnnotation *annotation)
+  : tab_(tab), lb_(lb), index_(index), delay_info_(delay_info),
+    annotation_(annotation), assign_(nullptr), entry_st_(nullptr),
+    entry_tr_(nullptr), trip_count_(0), ii_(0), mii_(0), num_stages_(0) {
+}
+
+bool LoopPipeliner::Pipeline() {
+  if (!CollectStates() || !CheckEntry() || !CheckCondition() ||
+      !CollectOps()) {
+    return false;
+  }
+  BuildEdges();
+  ModuloScheduler sched(&ops_, edges_, res_limits_,
+			delay_info_->GetMaxDelay());
+  if (!sched.Schedule(body_states_.size())) {
+    return false;
+  }
+  ii_ = sched.GetII();
+  mii_ = sched.GetMII();
+  num_stages_ = sched.GetNumStages();
+  if (trip_count_ < num_stages_) {
+    return false;
+  }
+  assign_ = DesignTool::GetOneResource(tab_, resource::kSet);
+  SetupOperands();
+  Generate();
+  return true;
+}
+
+int LoopPipeliner::GetII() {
+  return ii_;
+}
+
+bool LoopPipeliner::CollectStates() {
+  IState *compare_st = lb_->GetCompareState();
+  IInsn *compare_insn = lb_->GetCompareInsn();
+  IInsn *branch_insn = lb_->GetBranchInsn();
+  int num_states = tab_->states_.size();
+  // Header: Only the compare and the branch are allowed.
+  IState *st = compare_st;
+  while (true) {
+    if (loop_states_.find(st) != loop_states_.end() ||
+	header_states_.size() > num_states) {
+      return false;
+    }
+    header_states_.push_back(st);
+    loop_states_.insert(st);
+    IInsn *tr = DesignUtil::FindTransitionInsn(st);
+    for (IInsn *insn : st->insns_) {
+      if (insn != compare_insn && insn != tr) {
+	return false;
+      }
+    }
+    if (tr == branch_insn) {
+      break;
+    }
+    if (tr == nullptr || tr->target_states_.size() != 1 ||
+	!tr->inputs_.empty()) {
+      return false;
+    }
+    st = tr->target_states_[0];
+  }
+  // Body: A straight chain back to the compare state.
+  st = branch_insn->target_states_[1];
+  while (st != compare_st) {
+    if (loop_states_.find(st) != loop_states_.end()) {
+      return false;
+    }
+    body_states_.push_back(st);
+    loop_states_.insert(st);
+    IInsn *tr = DesignUtil::FindTransitionInsn(st);
+    if (tr == nullptr || tr->target_states_.size() != 1 ||
+	!tr->inputs_.empty()) {
+      return false;
+    }
+    st = tr->target_states_[0];
+  }
+  if (body_states_.empty() ||
+      loop_states_.size() != lb_->GetStates().size() ||
+      loop_states_.find(lb_->GetExitState()) != loop_states_.end() ||
+      loop_states_.find(tab_->GetInitialState()) != loop_states_.end()) {
+    return false;
+  }
+  // Only one transition from outside and it should go to the compare.
+  for (IState *os : tab_->states_) {
+    if (loop_states_.find(os) != loop_states_.end()) {
+      continue;
+    }
+    for (IInsn *insn : os->insns_) {
+      for (IState *target : insn->target_states_) {
+	if (loop_states_.find(target) == loop_states_.end()) {
+	  continue;
+	}
+	if (target != compare_st || entry_tr_ != nullptr) {
+	  return false;
+	}
+	entry_st_ = os;
+	entry_tr_ = insn;
+      }
+    }
+  }
+  return (entry_tr_ != nullptr);
+}
+
+bool LoopPipeliner::CheckEntry() {
+  if (!lb_->HasConstantCount() || index_->value_type_.IsSigned() ||
+      index_->value_type_.IsWide()) {
+    return false;
+  }
+  // Walks from the initial assignment to the loop.
+  IState *st = lb_->GetEntryAssignState();
+  IInsn *init_insn = nullptr;
+  int num_states = tab_->states_.size();
+  for (int i = 0; i < num_states; ++i) {
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *oreg : insn->outputs_) {
+	if (oreg != index_) {
+	  continue;
+	}
+	if (init_insn != nullptr || st != lb_->GetEntryAssignState() ||
+	    insn->inputs_.size() != 1 || !insn->inputs_[0]->IsConst()) {
+	  return false;
+	}
+	init_insn = insn;
+      }
+    }
+    if (st == entry_st_) {
+      break;
+    }
+    IInsn *tr = DesignUtil::FindTransitionInsn(st);
+    if (tr == nullptr || tr->target_states_.size() != 1) {
+      return false;
+    }
+    st = tr->target_states_[0];
+  }
+  if (st != entry_st_ || init_insn == nullptr ||
+      entry_tr_->target_states_.size() != 1) {
+    return false;
+  }
+  uint64_t init = init_insn->inputs_[0]->GetInitialValue().GetValue0();
+  uint64_t count = lb_->GetLoopCount();
+  int width = index_->value_type_.GetWidth();
+  if (width >= 63 || (count >> width) != 0 || count <= init) {
+    return false;
+  }
+  trip_count_ = count - init;
+  return true;
+}
+
+bool LoopPipeliner::CheckCondition() {
+  // The condition register will be stale after the transformation.
+  IInsn *compare_insn = lb_->GetCompareInsn();
+  IInsn *branch_insn = lb_->GetBranchInsn();
+  IRegister *cond = compare_insn->outputs_[0];
+  if (!cond->IsNormal()) {
+    return false;
+  }
+  for (IState *st : tab_->states_) {
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *reg : insn->inputs_) {
+	if (reg == cond && insn != branch_insn) {
+	  return false;
+	}
+      }
+      for (IRegister *reg : insn->outputs_) {
+	if (reg == cond && insn != compare_insn) {
+	  return false;
+	}
+      }
+    }
+  }
+  return true;
+}
+
+bool LoopPipeliner::CollectOps() {
+  sched::VirtualResourceSet vrs(tab_);
+  for (int pos = 0; pos < body_states_.size(); ++pos) {
+    IState *st = body_states_[pos];
+    set<IRegister *> outputs;
+    for (IInsn *insn : st->insns_) {
+      IResourceClass *rc = insn->GetResource()->GetClass();
+      if (resource::IsTransition(*rc)) {
+	continue;
+      }
+      if (!IsPipelinableInsn(insn)) {
+	return false;
+      }
+      IRegister *oreg = insn->outputs_[0];
+      if (outputs.find(oreg) != outputs.end()) {
+	return false;
+      }
+      outputs.insert(oreg);
+      if (oreg == index_ && !IsIncrement(insn)) {
+	return false;
+      }
+      ModuloOp op;
+      op.insn_ = insn;
+      op.pos_ = pos;
+      op.delay_ = delay_info_->GetInsnDelay(insn);
+      if (rc->IsExclusive()) {
+	vrs.GetFromInsn(insn);
+      }
+      writers_[oreg].push_back(ops_.size());
+      ops_.push_back(op);
+    }
+  }
+  if (writers_[index_].size() != 1) {
+    return false;
+  }
+  vrs.BuildDefaultBinding();
+  map<sched::ResourceEntry *, int> res_index;
+  for (ModuloOp &op : ops_) {
+    if (!op.insn_->GetResource()->GetClass()->IsExclusive()) {
+      continue;
+    }
+    sched::ResourceEntry *re = vrs.GetFromInsn(op.insn_)->GetResourceEntry();
+    auto it = res_index.find(re);
+    if (it == res_index.end()) {
+      res_index[re] = res_limits_.size();
+      res_limits_.push_back(re->GetNumReplicas());
+    }
+    op.res_index_ = res_index[re];
+  }
+  return true;
+}
+
+bool LoopPipeliner::IsPipelinableInsn(IInsn *insn) {
+  // Memory, channels and external accesses are not handled yet.
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  if (!(resource::IsSet(*rc) || resource::IsSelect(*rc) ||
+	resource::IsExclusiveBinOp(*rc) || resource::IsLightBinOp(*rc) ||
+	resource::IsLightUniOp(*rc) || resource::IsBitShiftOp(*rc) ||
+	resource::IsBitSel(*rc) || resource::IsBitConcat(*rc))) {
+    return false;
+  }
+  if (insn->outputs_.size() != 1 || !insn->outputs_[0]->IsNormal() ||
+      !insn->depending_insns_.empty()) {
+    return false;
+  }
+  for (IRegister *reg : insn->inputs_) {
+    if (reg->IsStateLocal()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopPipeliner::IsIncrement(IInsn *insn) {
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  if (rc->GetName() != resource::kAdd || insn->inputs_.size() != 2) {
+    return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    IRegister *one = insn->inputs_[1 - i];
+    if (insn->inputs_[i] == index_ && one->IsConst() &&
+	one->GetInitialValue().GetValue0() == 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LoopPipeliner::BuildEdges() {
+  for (int b = 0; b < ops_.size(); ++b) {
+    int pos = ops_[b].pos_;
+    for (IRegister *reg : ops_[b].insn_->inputs_) {
+      auto it = writers_.find(reg);
+      if (it == writers_.end()) {
+	continue;
+      }
+      vector<int> &ws = it->second;
+      int src = -1;
+      for (int w : ws) {
+	if (ops_[w].pos_ < pos) {
+	  src = w;
+	} else {
+	  // Should read before the write.
+	  edges_.push_back(ModuloEdge(b, w, DEP_ANTI, 0));
+	}
+      }
+      if (src >= 0) {
+	edges_.push_back(ModuloEdge(src, b, DEP_FLOW, 0));
+      } else {
+	edges_.push_back(ModuloEdge(ws.back(), b, DEP_FLOW, 1));
+      }
+    }
+  }
+  for (auto &p : writers_) {
+    vector<int> &ws = p.second;
+    for (int i = 0; i + 1 < ws.size(); ++i) {
+      edges_.push_back(ModuloEdge(ws[i], ws[i + 1], DEP_OUTPUT, 0));
+    }
+    edges_.push_back(ModuloEdge(ws.back(), ws[0], DEP_OUTPUT, 1));
+  }
+}
+
+void LoopPipeliner::SetupOperands() {
+  int num_ops = ops_.size();
+  operands_.resize(num_ops);
+  chain_src_.resize(num_ops);
+  has_chained_dst_.resize(num_ops, false);
+  for (int b = 0; b < num_ops; ++b) {
+    IInsn *insn = ops_[b].insn_;
+    operands_[b] = insn->inputs_;
+    chain_src_[b].resize(insn->inputs_.size(), -1);
+    int time = ops_[b].time_;
+    for (int i = 0; i < insn->inputs_.size(); ++i) {
+      IRegister *reg = insn->inputs_[i];
+      auto it = writers_.find(reg);
+      if (it == writers_.end()) {
+	continue;
+      }
+      vector<int> &ws = it->second;
+      int src = -1;
+      for (int w : ws) {
+	if (ops_[w].pos_ < ops_[b].pos_) {
+	  src = w;
+	}
+      }
+      if (src < 0) {
+	// From the previous iteration.
+	continue;
+      }
+      if (ops_[src].time_ == time) {
+	chain_src_[b][i] = src;
+	has_chained_dst_[src] = true;
+	continue;
+      }
+      if (src != ws.back()) {
+	continue;
+      }
+      // The next iteration overwrites the register after this.
+      int first_time = ops_[ws[0]].time_;
+      int next_write = first_time + ii_;
+      if (time > next_write) {
+	int nth = (time - next_write + ii_ - 1) / ii_;
+	operands_[b][i] = GetCopyReg(reg, nth, first_time);
+      }
+    }
+  }
+}
+
+// Copies at (first write time + II * nth) for the nth register.
+IRegister *LoopPipeliner::GetCopyReg(IRegister *reg, int nth,
+				     int first_time) {
+  vector<IRegister *> &regs = copy_regs_[reg];
+  while (regs.size() < nth) {
+    IRegister *src = regs.empty() ? reg : regs.back();
+    IRegister *copy =
+      DesignTool::AllocRegister(tab_, reg->GetName() + "_s" +
+				Util::Itoa(regs.size() + 1), 0);
+    copy->value_type_ = reg->value_type_;
+    regs.push_back(copy);
+    IInsn *insn = new IInsn(assign_);
+    insn->inputs_.push_back(src);
+    insn->outputs_.push_back(copy);
+    ModuloOp op;
+    op.insn_ = insn;
+    op.pos_ = body_states_.size();
+    op.time_ = first_time + ii_ * regs.size();
+    ops_.push_back(op);
+    operands_.push_back(insn->inputs_);
+    chain_src_.push_back(vector<int>(1, -1));
+    has_chained_dst_.push_back(false);
+  }
+  return regs[nth - 1];
+}
+
+void LoopPipeliner::Generate() {
+  vector<vector<IState *> > prologue;
+  for (int p = 0; p < num_stages_ - 1; ++p) {
+    prologue.push_back(AllocBlock());
+    EmitBlock(prologue.back(), 0, p);
+  }
+  vector<IState *> kernel = AllocBlock();
+  EmitBlock(kernel, 0, num_stages_ - 1);
+  vector<vector<IState *> > epilogue;
+  for (int e = 1; e < num_stages_; ++e) {
+    epilogue.push_back(AllocBlock());
+    EmitBlock(epilogue.back(), e, num_stages_ - 1);
+  }
+  for (int p = 0; p < prologue.size(); ++p) {
+    IState *next =
+      (p + 1 < prologue.size()) ? prologue[p + 1][0] : kernel[0];
+    Connect(prologue[p], next);
+  }
+  IState *exit_st = lb_->GetExitState();
+  IState *after_kernel = epilogue.empty() ? exit_st : epilogue[0][0];
+  AddKernelCounter(kernel, after_kernel);
+  for (int e = 0; e < epilogue.size(); ++e) {
+    IState *next =
+      (e + 1 < epilogue.size()) ? epilogue[e + 1][0] : exit_st;
+    Connect(epilogue[e], next);
+  }
+  IState *first = prologue.empty() ? kernel[0] : prologue[0][0];
+  entry_tr_->target_states_[0] = first;
+  Annotate(kernel);
+}
+
+void LoopPipeliner::EmitBlock(const vector<IState *> &sts, int min_stage,
+			      int max_stage) {
+  vector<map<int, IRegister *> > wires(sts.size());
+  for (int op = 0; op < ops_.size(); ++op) {
+    int time = ops_[op].time_;
+    int stage = time / ii_;
+    if (stage < min_stage || stage > max_stage) {
+      continue;
+    }
+    int slot = time % ii_;
+    EmitOp(op, sts[slot], &wires[slot]);
+  }
+}
+
+void LoopPipeliner::EmitOp(int op, IState *st, map<int, IRegister *> *wires) {
+  IInsn *oinsn = ops_[op].insn_;
+  IInsn *insn = new IInsn(oinsn->GetResource());
+  insn->inputs_ = operands_[op];
+  for (int i = 0; i < insn->inputs_.size(); ++i) {
+    int src = chain_src_[op][i];
+    if (src >= 0) {
+      insn->inputs_[i] = (*wires)[src];
+    }
+  }
+  insn->outputs_ = oinsn->outputs_;
+  st->insns_.push_back(insn);
+  if (!has_chained_dst_[op]) {
+    return;
+  }
+  IRegister *reg = oinsn->outputs_[0];
+  IRegister *wire = AllocWire(reg, "_pw");
+  insn->outputs_[0] = wire;
+  (*wires)[op] = wire;
+  IInsn *assign = new IInsn(assign_);
+  assign->inputs_.push_back(wire);
+  assign->outputs_.push_back(reg);
+  st->insns_.push_back(assign);
+}
+
+IRegister *LoopPipeliner::AllocWire(IRegister *reg, const string &suffix) {
+  IRegister *wire = DesignTool::AllocRegister(tab_, reg->GetName() + suffix,
+					      0);
+  wire->value_type_ = reg->value_type_;
+  wire->SetStateLocal(true);
+  return wire;
+}
+
+vector<IState *> LoopPipeliner::AllocBlock() {
+  vector<IState *> sts;
+  for (int i = 0; i < ii_; ++i) {
+    IState *st = new IState(tab_);
+    tab_->states_.push_back(st);
+    sts.push_back(st);
+  }
+  return sts;
+}
+
+void LoopPipeliner::Connect(const vector<IState *> &sts, IState *next) {
+  for (int i = 0; i < sts.size(); ++i) {
+    IState *n = (i + 1 < sts.size()) ? sts[i + 1] : next;
+    DesignTool::AddNextState(sts[i], n);
+  }
+}
+
+// Kernel pass kc (0 origin) repeats while (Kc - 1 > kc). The condition
+// is a register computed in the previous pass, so that the transition
+// doesn't depend on a wire.
+void LoopPipeliner::AddKernelCounter(const vector<IState *> &kernel,
+				     IState *next) {
+  uint64_t kernel_count = trip_count_ - num_stages_ + 1;
+  if (kernel_count == 1) {
+    Connect(kernel, next);
+    return;
+  }
+  vector<IState *> head(kernel.begin(), kernel.end() - 1);
+  Connect(head, kernel.back());
+  int width = 1;
+  while ((kernel_count >> width) != 0) {
+    ++width;
+  }
+  string name = index_->GetName();
+  IRegister *kc = DesignTool::AllocRegister(tab_, name + "_kc", width);
+  IRegister *cond = DesignTool::AllocRegister(tab_, name + "_kcond", 0);
+  IInsn *kc_init = new IInsn(assign_);
+  kc_init->inputs_.push_back(DesignTool::AllocConstNum(tab_, width, 0));
+  kc_init->outputs_.push_back(kc);
+  entry_st_->insns_.push_back(kc_init);
+  IInsn *cond_init = new IInsn(assign_);
+  cond_init->inputs_.push_back(DesignTool::AllocConstNum(tab_, 0, 1));
+  cond_init->outputs_.push_back(cond);
+  entry_st_->insns_.push_back(cond_init);
+
+  IState *last = kernel.back();
+  IInsn *incr = new IInsn(DesignTool::CreateBinOpResource(tab_,
+							  resource::kAdd,
+							  width));
+  incr->inputs_.push_back(kc);
+  incr->inputs_.push_back(DesignTool::AllocConstNum(tab_, width, 1));
+  incr->outputs_.push_back(kc);
+  last->insns_.push_back(incr);
+  // For the next pass kc + 1.
+  IInsn *compare = new IInsn(DesignTool::CreateBinOpResource(tab_,
+							     resource::kGt,
+							     width));
+  compare->inputs_.push_back(DesignTool::AllocConstNum(tab_, width,
+						       kernel_count - 2));
+  compare->inputs_.push_back(kc);
+  compare->outputs_.push_back(cond);
+  last->insns_.push_back(compare);
+  IInsn *tr = DesignUtil::GetTransitionInsn(last);
+  tr->inputs_.push_back(cond);
+  tr->target_states_.push_back(next);
+  tr->target_states_.push_back(kernel[0]);
+}
+
+void LoopPipeliner::Annotate(const vector<IState *> &kernel) {
+  if (!annotation_->IsEnabled()) {
+    return;
+  }
+  annotation_->Table(tab_) << "Pipelined loop " << index_->GetName()
+			   << ": II=" << ii_ << " (MII=" << mii_ << ")"
+			   << " stages=" << num_stages_
+			   << " trip count=" << trip_count_ << "\n";
+  for (int i = 0; i < kernel.size(); ++i) {
+    annotation_->State(kernel[i]) << "kernel " << i << "/" << ii_ << "\n";
+  }
+}
+
+}  // namespace pipeline
+}  // namespace opt
+}  // namespace iroha
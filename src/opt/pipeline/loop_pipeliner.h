@@ -0,0 +1,88 @@
+// -*- C++ -*-
+//
+// Software pipelining of a loop with a static trip count.
+//
+//   (Sa) i <- init ... -> (P0..) prologue -> (K..) kernel x Kc
+//                          -> (E1..) epilogue -> (Se) exit
+//
+// Each block has II states. The kernel repeats Kc = (trip count - stages + 1)
+// times with a dedicated counter, so the original compare and branch of
+// the index are removed. Original loop states become unreachable.
+//
+#ifndef _opt_pipeline_loop_pipeliner_h_
+#define _opt_pipeline_loop_pipeliner_h_
+
+#include "opt/common.h"
+#include "opt/pipeline/modulo_scheduler.h"
+
+namespace iroha {
+namespace opt {
+namespace loop {
+class LoopBlock;
+}  // namespace loop
+namespace pipeline {
+
+class LoopPipeliner {
+public:
+  LoopPipeliner(ITable *tab, loop::LoopBlock *lb, IRegister *index,
+		DelayInfo *delay_info, DebugAnnotation *annotation);
+
+  // Returns false and keeps the table as is, if the loop can't be
+  // pipelined.
+  bool Pipeline();
+  int GetII();
+
+private:
+  bool CollectStates();
+  bool CheckEntry();
+  bool CheckCondition();
+  bool CollectOps();
+  bool IsPipelinableInsn(IInsn *insn);
+  bool IsIncrement(IInsn *insn);
+  void BuildEdges();
+  void SetupOperands();
+  IRegister *GetCopyReg(IRegister *reg, int nth, int first_time);
+  void Generate();
+  void EmitBlock(const vector<IState *> &sts, int min_stage, int max_stage);
+  void EmitOp(int op, IState *st, map<int, IRegister *> *wires);
+  IRegister *AllocWire(IRegister *reg, const string &suffix);
+  vector<IState *> AllocBlock();
+  void Connect(const vector<IState *> &sts, IState *next);
+  void AddKernelCounter(const vector<IState *> &kernel, IState *next);
+  void Annotate(const vector<IState *> &kernel);
+
+  ITable *tab_;
+  loop::LoopBlock *lb_;
+  IRegister *index_;
+  DelayInfo *delay_info_;
+  DebugAnnotation *annotation_;
+  IResource *assign_;
+  // compare state .. branch state.
+  vector<IState *> header_states_;
+  vector<IState *> body_states_;
+  set<IState *> loop_states_;
+  // Transition into the loop from outside.
+  IState *entry_st_;
+  IInsn *entry_tr_;
+  long long trip_count_;
+  int ii_;
+  int mii_;
+  int num_stages_;
+  vector<ModuloOp> ops_;
+  vector<ModuloEdge> edges_;
+  vector<int> res_limits_;
+  // Writer ops of each register in the body order.
+  map<IRegister *, vector<int> > writers_;
+  // Per op and input index.
+  vector<vector<IRegister *> > operands_;
+  vector<vector<int> > chain_src_;
+  vector<bool> has_chained_dst_;
+  // Registers to keep the value of the last writer until late readers.
+  map<IRegister *, vector<IRegister *> > copy_regs_;
+};
+
+}  // namespace pipeline
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_pipeline_loop_pipeliner_h_
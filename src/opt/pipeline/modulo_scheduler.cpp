@@ -0,0 +1,349 @@
+#include "opt/pipeline/modulo_scheduler.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+namespace pipeline {
+
+// Number of placements per op before giving up an II.
+static const int kBudgetRatio = 6;
+
+ModuloOp::ModuloOp()
+  : insn_(nullptr), pos_(0), delay_(0), res_index_(-1), time_(-1) {
+}
+
+ModuloEdge::ModuloEdge(int src, int dst, ModuloDepType type, int distance)
+  : src_(src), dst_(dst), type_(type), distance_(distance) {
+}
+
+ModuloScheduler::ModuloScheduler(vector<ModuloOp> *ops,
+				 const vector<ModuloEdge> &edges,
+				 const vector<int> &res_limits, int max_delay)
+  : ops_(*ops), edges_(edges), res_limits_(res_limits),
+    max_delay_(max_delay), mii_(0), ii_(0) {
+  in_edges_.resize(ops_.size());
+  out_edges_.resize(ops_.size());
+  for (int i = 0; i < edges_.size(); ++i) {
+    in_edges_[edges_[i].dst_].push_back(i);
+    out_edges_[edges_[i].src_].push_back(i);
+  }
+}
+
+bool ModuloScheduler::Schedule(int max_ii) {
+  int ii = ComputeResMII();
+  while (ii <= max_ii && HasPositiveCycle(ii)) {
+    ++ii;
+  }
+  mii_ = ii;
+  for (; ii <= max_ii; ++ii) {
+    if (ScheduleForII(ii)) {
+      ii_ = ii;
+      Normalize();
+      return true;
+    }
+  }
+  return false;
+}
+
+int ModuloScheduler::GetMII() {
+  return mii_;
+}
+
+int ModuloScheduler::GetII() {
+  return ii_;
+}
+
+int ModuloScheduler::GetNumStages() {
+  int max_time = 0;
+  for (ModuloOp &op : ops_) {
+    if (op.time_ > max_time) {
+      max_time = op.time_;
+    }
+  }
+  return max_time / ii_ + 1;
+}
+
+bool ModuloScheduler::IsChained(const ModuloEdge &e) {
+  return (e.type_ == DEP_FLOW && e.distance_ == 0 &&
+	  ops_[e.src_].time_ == ops_[e.dst_].time_);
+}
+
+int ModuloScheduler::ComputeResMII() {
+  vector<int> uses(res_limits_.size(), 0);
+  for (ModuloOp &op : ops_) {
+    if (op.res_index_ >= 0) {
+      ++uses[op.res_index_];
+    }
+  }
+  int mii = 1;
+  for (int i = 0; i < uses.size(); ++i) {
+    int n = (uses[i] + res_limits_[i] - 1) / res_limits_[i];
+    if (n > mii) {
+      mii = n;
+    }
+  }
+  return mii;
+}
+
+// Longest paths with (latency - ii * distance) as the edge weight.
+bool ModuloScheduler::HasPositiveCycle(int ii) {
+  const int kNoPath = -(1 << 28);
+  int n = ops_.size();
+  vector<vector<int> > d(n, vector<int>(n, kNoPath));
+  for (const ModuloEdge &e : edges_) {
+    int w = GetMinLatency(e) - ii * e.distance_;
+    if (w > d[e.src_][e.dst_]) {
+      d[e.src_][e.dst_] = w;
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int i = 0; i < n; ++i) {
+      if (d[i][k] == kNoPath) {
+	continue;
+      }
+      for (int j = 0; j < n; ++j) {
+	if (d[k][j] == kNoPath) {
+	  continue;
+	}
+	if (d[i][k] + d[k][j] > d[i][j]) {
+	  d[i][j] = d[i][k] + d[k][j];
+	}
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      if (d[i][i] > 0) {
+	return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ModuloScheduler::ComputeHeights(int ii) {
+  int n = ops_.size();
+  heights_.assign(n, 0);
+  // Converges within n rounds as there is no positive cycle.
+  for (int round = 0; round < n; ++round) {
+    bool changed = false;
+    for (const ModuloEdge &e : edges_) {
+      int h = heights_[e.dst_] + GetMinLatency(e) - ii * e.distance_;
+      if (h > heights_[e.src_]) {
+	heights_[e.src_] = h;
+	changed = true;
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+}
+
+bool ModuloScheduler::ScheduleForII(int ii) {
+  int n = ops_.size();
+  ComputeHeights(ii);
+  for (ModuloOp &op : ops_) {
+    op.time_ = -1;
+  }
+  acc_delay_.assign(n, 0);
+  prev_time_.assign(n, -1);
+  mrt_.assign(res_limits_.size(), vector<vector<int> >(ii));
+  int budget = n * kBudgetRatio;
+  for (int op = PickOp(); op >= 0; op = PickOp()) {
+    if (budget == 0) {
+      return false;
+    }
+    --budget;
+    int estart = GetEarliestTime(op, ii);
+    int time = -1;
+    for (int t = estart; t < estart + ii; ++t) {
+      if (!HasResourceConflict(op, t, ii)) {
+	time = t;
+	break;
+      }
+    }
+    if (time < 0) {
+      // Forces the placement and evicts others.
+      if (prev_time_[op] < 0 || estart > prev_time_[op]) {
+	time = estart;
+      } else {
+	time = prev_time_[op] + 1;
+      }
+      int r = ops_[op].res_index_;
+      vector<int> &users = mrt_[r][time % ii];
+      while (users.size() >= res_limits_[r]) {
+	Unplace(users[0], ii);
+      }
+    }
+    Place(op, time, ii);
+    for (int ei : out_edges_[op]) {
+      const ModuloEdge &e = edges_[ei];
+      if (e.dst_ != op && ops_[e.dst_].time_ >= 0 && !IsSatisfied(e, ii)) {
+	Unplace(e.dst_, ii);
+      }
+    }
+    for (int ei : in_edges_[op]) {
+      const ModuloEdge &e = edges_[ei];
+      if (e.src_ != op && ops_[e.src_].time_ >= 0 && !IsSatisfied(e, ii)) {
+	Unplace(e.src_, ii);
+      }
+    }
+  }
+  return Verify(ii);
+}
+
+// Unscheduled op with the largest height. Earlier one in the body first.
+int ModuloScheduler::PickOp() {
+  int best = -1;
+  for (int i = 0; i < ops_.size(); ++i) {
+    if (ops_[i].time_ >= 0) {
+      continue;
+    }
+    if (best < 0 || heights_[i] > heights_[best]) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+int ModuloScheduler::GetEarliestTime(int op, int ii) {
+  int estart = 0;
+  for (int ei : in_edges_[op]) {
+    const ModuloEdge &e = edges_[ei];
+    if (e.src_ == op || ops_[e.src_].time_ < 0) {
+      continue;
+    }
+    int lat = GetMinLatency(e);
+    if (e.type_ == DEP_FLOW && e.distance_ == 0 && !CanChain(e.src_, op)) {
+      lat = 1;
+    }
+    int t = ops_[e.src_].time_ + lat - ii * e.distance_;
+    if (t > estart) {
+      estart = t;
+    }
+  }
+  return estart;
+}
+
+bool ModuloScheduler::CanChain(int src, int dst) {
+  return acc_delay_[src] + ops_[dst].delay_ <= max_delay_;
+}
+
+int ModuloScheduler::GetMinLatency(const ModuloEdge &e) {
+  switch (e.type_) {
+  case DEP_FLOW:
+    if (e.distance_ == 0 &&
+	ops_[e.src_].delay_ + ops_[e.dst_].delay_ <= max_delay_) {
+      return 0;
+    }
+    return 1;
+  case DEP_ANTI:
+    return 0;
+  case DEP_OUTPUT:
+    return 1;
+  }
+  return 1;
+}
+
+bool ModuloScheduler::HasResourceConflict(int op, int time, int ii) {
+  int r = ops_[op].res_index_;
+  if (r < 0) {
+    return false;
+  }
+  return (mrt_[r][time % ii].size() >= res_limits_[r]);
+}
+
+void ModuloScheduler::Place(int op, int time, int ii) {
+  ModuloOp &o = ops_[op];
+  o.time_ = time;
+  prev_time_[op] = time;
+  if (o.res_index_ >= 0) {
+    mrt_[o.res_index_][time % ii].push_back(op);
+  }
+  int acc = 0;
+  for (int ei : in_edges_[op]) {
+    const ModuloEdge &e = edges_[ei];
+    if (e.src_ != op && ops_[e.src_].time_ >= 0 && IsChained(e)) {
+      if (acc_delay_[e.src_] > acc) {
+	acc = acc_delay_[e.src_];
+      }
+    }
+  }
+  acc_delay_[op] = acc + o.delay_;
+}
+
+void ModuloScheduler::Unplace(int op, int ii) {
+  ModuloOp &o = ops_[op];
+  if (o.res_index_ >= 0) {
+    vector<int> &users = mrt_[o.res_index_][o.time_ % ii];
+    for (auto it = users.begin(); it != users.end(); ++it) {
+      if (*it == op) {
+	users.erase(it);
+	break;
+      }
+    }
+  }
+  o.time_ = -1;
+}
+
+bool ModuloScheduler::IsSatisfied(const ModuloEdge &e, int ii) {
+  int src_time = ops_[e.src_].time_;
+  int dst_time = ops_[e.dst_].time_ + ii * e.distance_;
+  if (e.type_ == DEP_FLOW && e.distance_ == 0) {
+    if (dst_time == src_time) {
+      return CanChain(e.src_, e.dst_);
+    }
+    return dst_time > src_time;
+  }
+  int lat = (e.type_ == DEP_ANTI) ? 0 : 1;
+  return dst_time >= src_time + lat;
+}
+
+// Checks the result again, since accumulated delays can be stale after
+// evictions.
+bool ModuloScheduler::Verify(int ii) {
+  vector<int> order;
+  for (int i = 0; i < ops_.size(); ++i) {
+    order.push_back(i);
+  }
+  // Chained sources are always earlier in the body.
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+      return ops_[a].pos_ < ops_[b].pos_;
+    });
+  for (int op : order) {
+    Place(op, ops_[op].time_, ii);
+    if (acc_delay_[op] > ops_[op].delay_ && acc_delay_[op] > max_delay_) {
+      return false;
+    }
+  }
+  for (const ModuloEdge &e : edges_) {
+    if (!IsSatisfied(e, ii)) {
+      return false;
+    }
+  }
+  for (int r = 0; r < res_limits_.size(); ++r) {
+    for (int s = 0; s < ii; ++s) {
+      // Place() above added the ops once more.
+      if (mrt_[r][s].size() > 2 * res_limits_[r]) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+void ModuloScheduler::Normalize() {
+  int min_time = -1;
+  for (ModuloOp &op : ops_) {
+    if (min_time < 0 || op.time_ < min_time) {
+      min_time = op.time_;
+    }
+  }
+  for (ModuloOp &op : ops_) {
+    op.time_ -= min_time;
+  }
+}
+
+}  // namespace pipeline
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,108 @@
+// -*- C++ -*-
+//
+// Iterative modulo scheduling (B. R. Rau, MICRO-27 1994) of a loop body.
+//
+// Each op is placed at a time (cycle) from the start of its iteration.
+// Iterations start every II cycles, so an op occupies its resource at
+// the slot (time % II) of every II cycles.
+//
+#ifndef _opt_pipeline_modulo_scheduler_h_
+#define _opt_pipeline_modulo_scheduler_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+namespace opt {
+namespace pipeline {
+
+// An insn in the loop body.
+class ModuloOp {
+public:
+  ModuloOp();
+
+  IInsn *insn_;
+  // Index of the original state in the body. Ops in a same state read
+  // registers before any of them writes.
+  int pos_;
+  // From DelayInfo.
+  int delay_;
+  // Index of the resource limit for an exclusive resource or -1.
+  int res_index_;
+  // Result.
+  int time_;
+};
+
+enum ModuloDepType {
+  // Write -> Read. Can be in the same cycle (chained with a wire) if the
+  // accumulated delay fits.
+  DEP_FLOW,
+  // Read -> Write. Can be in the same cycle since registers are updated at
+  // the end of the cycle.
+  DEP_ANTI,
+  // Write -> Write.
+  DEP_OUTPUT,
+};
+
+// Dependency from src_ to dst_ of |distance_| iterations later.
+class ModuloEdge {
+public:
+  ModuloEdge(int src, int dst, ModuloDepType type, int distance);
+
+  int src_;
+  int dst_;
+  ModuloDepType type_;
+  int distance_;
+};
+
+class ModuloScheduler {
+public:
+  // res_limits: Number of available units for each res_index_.
+  ModuloScheduler(vector<ModuloOp> *ops, const vector<ModuloEdge> &edges,
+		  const vector<int> &res_limits, int max_delay);
+
+  // Tries from the minimum II up to max_ii and sets time_ of each op.
+  bool Schedule(int max_ii);
+  int GetMII();
+  int GetII();
+  int GetNumStages();
+  // True if dst reads the output of src through a wire in the same cycle.
+  bool IsChained(const ModuloEdge &e);
+
+private:
+  int ComputeResMII();
+  bool HasPositiveCycle(int ii);
+  void ComputeHeights(int ii);
+  bool ScheduleForII(int ii);
+  int PickOp();
+  int GetEarliestTime(int op, int ii);
+  bool CanChain(int src, int dst);
+  int GetMinLatency(const ModuloEdge &e);
+  bool HasResourceConflict(int op, int time, int ii);
+  void Place(int op, int time, int ii);
+  void Unplace(int op, int ii);
+  bool IsSatisfied(const ModuloEdge &e, int ii);
+  bool Verify(int ii);
+  void Normalize();
+
+  vector<ModuloOp> &ops_;
+  const vector<ModuloEdge> &edges_;
+  const vector<int> &res_limits_;
+  int max_delay_;
+  int mii_;
+  int ii_;
+  // Edge indexes of each op.
+  vector<vector<int> > in_edges_;
+  vector<vector<int> > out_edges_;
+  vector<int> heights_;
+  // Accumulated delay in the cycle including the chained sources.
+  vector<int> acc_delay_;
+  vector<int> prev_time_;
+  // Ops using each res_index_ at each slot.
+  vector<vector<vector<int> > > mrt_;
+};
+
+}  // namespace pipeline
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_pipeline_modulo_scheduler_h_
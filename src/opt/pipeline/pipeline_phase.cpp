@@ -1,5 +1,13 @@
 #include "opt/pipeline/pipeline_phase.h"
 
+#include "iroha/i_design.h"
+#include "iroha/resource_params.h"
+#include "opt/analysis_manager.h"
+#include "opt/delay_info.h"
+#include "opt/loop/loop_block.h"
+#include "opt/optimizer.h"
+#include "opt/pipeline/loop_pipeliner.h"
+
 namespace iroha {
 namespace opt {
 namespace pipeline {
@@ -11,7 +19,39 @@ Phase *PipelinePhase::Create() {
   return new PipelinePhase();
 }
 
+bool PipelinePhase::IsTableLocal() {
+  return true;
+}
+
+bool PipelinePhase::ApplyForDesign(IDesign *design) {
+  int max_delay = design->GetParams()->GetMaxDelayPs();
+  delay_info_.reset(DelayInfo::Create(optimizer_->GetPlatformDB(), max_delay));
+  return Phase::ApplyForDesign(design);
+}
+
 bool PipelinePhase::ApplyForTable(const string &key, ITable *table) {
+  // Pipelining allocates new registers.
+  vector<IRegister *> regs = table->registers_;
+  for (IRegister *reg : regs) {
+    auto *params = reg->GetParams(false);
+    if (params == nullptr) {
+      continue;
+    }
+    if (!params->GetIsPipeline() || params->GetPipelineII() > 0) {
+      continue;
+    }
+    AnalysisManager *analysis = optimizer_->GetAnalysisManager();
+    loop::LoopBlock *lb = analysis->GetLoopBlock(table, reg);
+    if (lb == nullptr) {
+      continue;
+    }
+    LoopPipeliner pipeliner(table, lb, reg, delay_info_.get(), annotation_);
+    if (!pipeliner.Pipeline()) {
+      continue;
+    }
+    params->SetPipelineII(pipeliner.GetII());
+    analysis->Invalidate(table);
+  }
   return true;
 }
 
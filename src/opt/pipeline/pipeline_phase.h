@@ -2,24 +2,31 @@
 #ifndef _opt_pipeline_pipeline_phase_h_
 #define _opt_pipeline_pipeline_phase_h_
 
+#include "opt/common.h"
 #include "opt/phase.h"
 
 namespace iroha {
 namespace opt {
 namespace pipeline {
 
+// Pipelines loops with PIPELINE param on the index register and records
+// the achieved II to PIPELINE-II.
 class PipelinePhase : public Phase {
 public:
   virtual ~PipelinePhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
+  virtual bool ApplyForDesign(IDesign *design);
   virtual bool ApplyForTable(const string &key, ITable *table);
+
+  std::unique_ptr<DelayInfo> delay_info_;
 };
 
 }  // namespace pipeline
 }  // namespace opt
 }  // namespace iroha
 
-#endif  // _opt_unroll_unroll_phase_h_
+#endif  // _opt_pipeline_pipeline_phase_h_
@@ -2,6 +2,7 @@
 
 #include "iroha/i_design.h"
 #include "iroha/resource_params.h"
+#include "opt/analysis_manager.h"
 #include "opt/delay_info.h"
 #include "opt/optimizer.h"
 #include "opt/profile/profile.h"
@@ -18,6 +19,10 @@ Phase *SchedPhase::Create() {
   return new SchedPhase();
 }
 
+bool SchedPhase::IsTableLocal() {
+  return true;
+}
+
 bool SchedPhase::ApplyForDesign(IDesign *design) {
   if (!profile::Profile::HasProfile(design)) {
     profile::Profile::FillFakeProfile(design);
@@ -29,7 +34,8 @@ bool SchedPhase::ApplyForDesign(IDesign *design) {
 }
 
 bool SchedPhase::ApplyForTable(const string &key, ITable *table) {
-  TableScheduler sched(table, delay_info_.get(), annotation_);
+  TableScheduler sched(table, delay_info_.get(),
+		       optimizer_->GetAnalysisManager(), annotation_);
   return sched.Perform();
 }
 
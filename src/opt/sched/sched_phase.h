@@ -14,6 +14,7 @@ public:
   virtual ~SchedPhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForDesign(IDesign *design);
@@ -5,6 +5,7 @@
 #include "iroha/resource_attr.h"
 #include "iroha/resource_class.h"
 #include "iroha/resource_params.h"
+#include "opt/analysis_manager.h"
 #include "opt/bb_set.h"
 #include "opt/debug_annotation.h"
 #include "opt/delay_info.h"
@@ -38,8 +39,10 @@ private:
 };
 
 TableScheduler::TableScheduler(ITable *table, DelayInfo *delay_info,
+			       AnalysisManager *analysis,
 			       DebugAnnotation *annotation)
-  : table_(table), delay_info_(delay_info), annotation_(annotation) {
+  : table_(table), delay_info_(delay_info), analysis_(analysis),
+    annotation_(annotation), bset_(nullptr) {
   data_path_set_.reset(new DataPathSet());
 }
 
@@ -47,7 +50,7 @@ TableScheduler::~TableScheduler() {
 }
 
 bool TableScheduler::Perform() {
-  bset_.reset(BBSet::Create(table_, true, annotation_));
+  bset_ = analysis_->GetBBSet(table_, true);
   if (annotation_->IsEnabled()) {
     annotation_->DumpIntermediateTable(table_);
   }
@@ -55,7 +58,7 @@ bool TableScheduler::Perform() {
   // Assign ids to newly allocated insns.
   Validator::ValidateTable(table_);
 
-  data_path_set_->Build(bset_.get());
+  data_path_set_->Build(bset_);
   data_path_set_->SetDelay(delay_info_);
   if (annotation_->IsEnabled()) {
     annotation_->StartSubSection("data_path", false);
@@ -70,11 +73,12 @@ bool TableScheduler::Perform() {
 
   Relocator rel(data_path_set_.get());
   rel.Relocate();
-
-  // Assign ids to newly allocated insns.
-  Validator::ValidateTable(table_);
+  analysis_->Invalidate(table_);
 
   if (annotation_->IsEnabled()) {
+    // Assign ids to newly allocated insns. Optimizer validates the design
+    // after the phase otherwise.
+    Validator::ValidateTable(table_);
     annotation_->DumpIntermediateTable(table_);
   }
 
@@ -11,7 +11,7 @@ namespace sched {
 class TableScheduler {
 public:
   TableScheduler(ITable *table, DelayInfo *delay_info,
-		 DebugAnnotation *annotation);
+		 AnalysisManager *analysis, DebugAnnotation *annotation);
   virtual ~TableScheduler();
   bool Perform();
 
@@ -20,8 +20,9 @@ private:
 
   ITable *table_;
   DelayInfo *delay_info_;
+  AnalysisManager *analysis_;
   DebugAnnotation *annotation_;
-  unique_ptr<BBSet> bset_;
+  BBSet *bset_;
 
   unique_ptr<DataPathSet> data_path_set_;
 };
@@ -3,6 +3,7 @@
 #include "design/design_tool.h"
 #include "iroha/resource_class.h"
 #include "iroha/stl_util.h"
+#include "opt/analysis_manager.h"
 #include "opt/bb_set.h"
 #include "opt/data_flow.h"
 
@@ -11,8 +12,10 @@ namespace iroha {
 namespace opt {
 namespace ssa {
 
-PhiBuilder::PhiBuilder(ITable *tab, DebugAnnotation *annotation)
-  : table_(tab), annotation_(annotation), phi_(nullptr) {
+PhiBuilder::PhiBuilder(ITable *tab, AnalysisManager *analysis,
+		       DebugAnnotation *annotation)
+  : table_(tab), analysis_(analysis), annotation_(annotation),
+    phi_(nullptr), bset_(nullptr), data_flow_(nullptr) {
 }
 
 PhiBuilder::~PhiBuilder() {
@@ -21,8 +24,8 @@ PhiBuilder::~PhiBuilder() {
 }
 
 void PhiBuilder::Perform() {
-  bset_.reset(BBSet::Create(table_, false, annotation_));
-  data_flow_.reset(DataFlow::Create(bset_.get(), annotation_));
+  bset_ = analysis_->GetBBSet(table_, false);
+  data_flow_ = analysis_->GetDataFlow(table_);
   phi_ = DesignTool::GetOneResource(table_, resource::kPhi);
 
   for (BB *bb : bset_->bbs_) {
@@ -40,6 +43,9 @@ void PhiBuilder::Perform() {
   for (BB *bb : bset_->bbs_) {
     UpdateVersionsForBB(bb);
   }
+  // Only registers are renamed.
+  analysis_->Invalidate(table_, AnalysisManager::ANALYSIS_BB_SET |
+			AnalysisManager::ANALYSIS_DOMINATOR_TREE);
 }
 
 void PhiBuilder::CalculatePHIInputsForBB(BB *bb) {
@@ -10,7 +10,8 @@ namespace ssa {
 
 class PhiBuilder {
 public:
-  PhiBuilder(ITable *tab, DebugAnnotation *annotation);
+  PhiBuilder(ITable *tab, AnalysisManager *analysis,
+	     DebugAnnotation *annotation);
   ~PhiBuilder();
   void Perform();
 
@@ -35,10 +36,11 @@ private:
   IRegister *FindVersionedReg(RegDef *reg_def);
 
   ITable *table_;
+  AnalysisManager *analysis_;
   DebugAnnotation *annotation_;
   IResource *phi_;
-  unique_ptr<BBSet> bset_;
-  unique_ptr<DataFlow> data_flow_;
+  BBSet *bset_;
+  DataFlow *data_flow_;
   vector<PHI *> phis_;
   map<IInsn *, set<RegDef *> > insn_to_reg_defs_;
   // For versioning.
@@ -2,6 +2,7 @@
 
 #include "design/design_tool.h"
 #include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
 #include "opt/bb_set.h"
 #include "opt/data_flow.h"
 
@@ -9,8 +10,10 @@ namespace iroha {
 namespace opt {
 namespace ssa {
 
-PhiCleaner::PhiCleaner(ITable *table, DebugAnnotation *annotation)
-  : table_(table), annotation_(annotation), nth_sel_(0) {
+PhiCleaner::PhiCleaner(ITable *table, AnalysisManager *analysis,
+		       DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    bset_(nullptr), data_flow_(nullptr), nth_sel_(0) {
 }
 
 PhiCleaner::~PhiCleaner() {
@@ -20,8 +23,8 @@ void PhiCleaner::Perform() {
   phi_ = DesignTool::GetOneResource(table_, resource::kPhi);
   sel_ = DesignTool::GetOneResource(table_, resource::kSelect);
   assign_ = DesignTool::GetOneResource(table_, resource::kSet);
-  bset_.reset(BBSet::Create(table_, false, annotation_));
-  data_flow_.reset(DataFlow::Create(bset_.get(), annotation_));
+  bset_ = analysis_->GetBBSet(table_, false);
+  data_flow_ = analysis_->GetDataFlow(table_);
 
   for (RegDef *reg_def : data_flow_->all_defs_) {
     reg_def_map_[reg_def->insn].insert(reg_def);
@@ -30,6 +33,9 @@ void PhiCleaner::Perform() {
   for (BB *bb : bset_->bbs_) {
     ProcessBB(bb);
   }
+  // Replaces phis with insns in the same states.
+  analysis_->Invalidate(table_, AnalysisManager::ANALYSIS_BB_SET |
+			AnalysisManager::ANALYSIS_DOMINATOR_TREE);
 }
 
 void PhiCleaner::ProcessBB(BB *bb) {
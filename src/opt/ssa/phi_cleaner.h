@@ -10,7 +10,8 @@ namespace ssa {
 
 class PhiCleaner {
 public:
-  PhiCleaner(ITable *table, DebugAnnotation *annotation);
+  PhiCleaner(ITable *table, AnalysisManager *analysis,
+	     DebugAnnotation *annotation);
   ~PhiCleaner();
 
   void Perform();
@@ -22,9 +23,10 @@ private:
 		    IInsn *phi_insn);
 
   ITable *table_;
+  AnalysisManager *analysis_;
   DebugAnnotation *annotation_;
-  unique_ptr<BBSet> bset_;
-  unique_ptr<DataFlow> data_flow_;
+  BBSet *bset_;
+  DataFlow *data_flow_;
   IResource *phi_;
   IResource *sel_;
   IResource *assign_;
@@ -5,6 +5,7 @@
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
 #include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
 #include "opt/bb_set.h"
 #include "opt/data_flow.h"
 #include "opt/dominator_tree.h"
@@ -14,8 +15,10 @@ namespace iroha {
 namespace opt {
 namespace ssa {
 
-PhiInjector::PhiInjector(ITable *table, DebugAnnotation *annotation)
-  : table_(table), annotation_(annotation), phi_(nullptr) {
+PhiInjector::PhiInjector(ITable *table, AnalysisManager *analysis,
+			 DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    phi_(nullptr), bset_(nullptr), data_flow_(nullptr), dom_tree_(nullptr) {
 }
 
 PhiInjector::~PhiInjector() {
@@ -24,9 +27,9 @@ PhiInjector::~PhiInjector() {
 void PhiInjector::Perform() {
   phi_ = DesignTool::GetOneResource(table_, resource::kPhi);
   tr_ = DesignUtil::FindTransitionResource(table_);
-  bset_.reset(BBSet::Create(table_, false, annotation_));
-  data_flow_.reset(DataFlow::Create(bset_.get(), annotation_));
-  dom_tree_.reset(DominatorTree::Create(bset_.get(), annotation_));
+  bset_ = analysis_->GetBBSet(table_, false);
+  data_flow_ = analysis_->GetDataFlow(table_);
+  dom_tree_ = analysis_->GetDominatorTree(table_);
 
   // Insert PHIs.
   CollectSingularRegister();
@@ -38,6 +41,8 @@ void PhiInjector::Perform() {
   CollectOriginalDefs();
   PropagatePHIs();
   CommitPHIInsn();
+  // Prepends states for phis.
+  analysis_->Invalidate(table_);
 }
 
 void PhiInjector::CollectSingularRegister() {
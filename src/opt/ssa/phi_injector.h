@@ -10,7 +10,8 @@ namespace ssa {
 
 class PhiInjector {
 public:
-  PhiInjector(ITable *table, DebugAnnotation *annotation);
+  PhiInjector(ITable *table, AnalysisManager *analysis,
+	      DebugAnnotation *annotation);
   ~PhiInjector();
 
   void Perform();
@@ -31,12 +32,13 @@ public:
   void PrependState(BB *bb);
 
   ITable *table_;
+  AnalysisManager *analysis_;
   DebugAnnotation *annotation_;
   IResource *phi_;
   IResource *tr_;
-  unique_ptr<BBSet> bset_;
-  unique_ptr<DataFlow> data_flow_;
-  unique_ptr<DominatorTree> dom_tree_;
+  BBSet *bset_;
+  DataFlow *data_flow_;
+  DominatorTree *dom_tree_;
   set<IRegister *> singular_regs_;
   map<IRegister *, PerRegister *> reg_phis_map_;
 };
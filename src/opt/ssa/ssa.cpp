@@ -1,5 +1,7 @@
 #include "opt/ssa/ssa.h"
 
+#include "opt/analysis_manager.h"
+#include "opt/optimizer.h"
 #include "opt/ssa/ssa_converter.h"
 #include "opt/ssa/phi_cleaner.h"
 
@@ -14,8 +16,18 @@ Phase *SSAConverterPhase::Create() {
   return new SSAConverterPhase();
 }
 
+bool SSAConverterPhase::IsTableLocal() {
+  return true;
+}
+
+int SSAConverterPhase::GetPreservedAnalyses() {
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
 bool SSAConverterPhase::ApplyForTable(const string &key, ITable *table) {
-  SSAConverter converter(table, annotation_);
+  SSAConverter converter(table, optimizer_->GetAnalysisManager(),
+			 annotation_);
   converter.Perform();
   return true;
 }
@@ -27,8 +39,17 @@ Phase *PhiCleanerPhase::Create() {
   return new PhiCleanerPhase();
 }
 
+bool PhiCleanerPhase::IsTableLocal() {
+  return true;
+}
+
+int PhiCleanerPhase::GetPreservedAnalyses() {
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
 bool PhiCleanerPhase::ApplyForTable(const string &key, ITable *table) {
-  PhiCleaner cleaner(table, annotation_);
+  PhiCleaner cleaner(table, optimizer_->GetAnalysisManager(), annotation_);
   cleaner.Perform();
   return true;
 }
@@ -13,6 +13,9 @@ public:
   virtual ~SSAConverterPhase();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
 };
@@ -22,6 +25,9 @@ public:
   virtual ~PhiCleanerPhase();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
 };
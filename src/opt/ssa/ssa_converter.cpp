@@ -5,6 +5,7 @@
 #include "iroha/i_design.h"
 #include "iroha/logging.h"
 #include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
 #include "opt/bb_set.h"
 #include "opt/data_flow.h"
 #include "opt/dominator_tree.h"
@@ -16,8 +17,9 @@ namespace iroha {
 namespace opt {
 namespace ssa {
 
-SSAConverter::SSAConverter(ITable *table, DebugAnnotation *annotation)
-  : table_(table), annotation_(annotation) {
+SSAConverter::SSAConverter(ITable *table, AnalysisManager *analysis,
+			   DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation) {
 }
 
 SSAConverter::~SSAConverter() {
@@ -25,12 +27,14 @@ SSAConverter::~SSAConverter() {
 
 void SSAConverter::Perform() {
   InjectInitialValueAssigns();
+  analysis_->Invalidate(table_, AnalysisManager::ANALYSIS_BB_SET |
+			AnalysisManager::ANALYSIS_DOMINATOR_TREE);
   // PhiInjector injects just phi insns and their output register.
   // PhiBuilder updates affected registers.
-  PhiInjector injector(table_, annotation_);
+  PhiInjector injector(table_, analysis_, annotation_);
   injector.Perform();
 
-  PhiBuilder phi_builder(table_, annotation_);
+  PhiBuilder phi_builder(table_, analysis_, annotation_);
   phi_builder.Perform();
 }
 
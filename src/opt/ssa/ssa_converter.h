@@ -10,7 +10,8 @@ namespace ssa {
 
 class SSAConverter {
 public:
-  SSAConverter(ITable *table, DebugAnnotation *annotation);
+  SSAConverter(ITable *table, AnalysisManager *analysis,
+	       DebugAnnotation *annotation);
   ~SSAConverter();
 
   void Perform();
@@ -19,6 +20,7 @@ private:
   void InjectInitialValueAssigns();
 
   ITable *table_;
+  AnalysisManager *analysis_;
   DebugAnnotation *annotation_;
 };
 
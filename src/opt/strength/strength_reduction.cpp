@@ -0,0 +1,287 @@
+#include "opt/strength/strength_reduction.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/insn_operands.h"
+#include "iroha/resource_class.h"
+#include "opt/debug_annotation.h"
+#include "platform/platform_db.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+namespace strength {
+
+static uint64_t Mask(int width) {
+  if (width >= 64) {
+    return ~0ULL;
+  }
+  return (1ULL << width) - 1;
+}
+
+// Number of adder stages to sum n terms in a balanced tree.
+static int Levels(int n) {
+  int levels = 0;
+  while ((1 << levels) < n) {
+    ++levels;
+  }
+  return levels;
+}
+
+StrengthReduction::StrengthReduction(ITable *table,
+				     platform::PlatformDB *platform_db,
+				     DebugAnnotation *annotation)
+  : table_(table), platform_db_(platform_db), annotation_(annotation),
+    index_(nullptr), assign_(nullptr), num_reduced_(0) {
+}
+
+void StrengthReduction::Perform() {
+  index_ = DefUseIndex::GetOrCreate(table_);
+  for (IState *st : table_->states_) {
+    // Copies the list, since new insns are inserted.
+    vector<IInsn *> insns = st->insns_;
+    for (IInsn *insn : insns) {
+      if (insn->GetResource()->GetClass()->GetName() == resource::kMul &&
+	  ReduceMul(st, insn)) {
+	++num_reduced_;
+      }
+    }
+  }
+  if (annotation_->IsEnabled() && num_reduced_ > 0) {
+    annotation_->Table(table_) << "Strength reduced " << num_reduced_
+			       << " multiplies\n";
+  }
+}
+
+// e.g. 7 = 8 - 1 gives pos = {3}, neg = {0}.
+void StrengthReduction::GetDigits(uint64_t c, int width, vector<int> *pos,
+				  vector<int> *neg) {
+  c &= Mask(width);
+  for (int i = 0; i < width && c != 0; ++i) {
+    if (c & 1) {
+      if ((c & 3) == 3) {
+	// A run of 1s becomes -1 here and +1 above it.
+	neg->push_back(i);
+	c += 1;
+      } else {
+	pos->push_back(i);
+	c -= 1;
+      }
+    }
+    c >>= 1;
+  }
+}
+
+// Before:
+//  S1: Rx <(mul)- Ra, 7
+// After:
+//  S1: Wt <(shift left)- Ra, 3
+//      Rx <(sub)- Wt, Ra
+bool StrengthReduction::ReduceMul(IState *st, IInsn *insn) {
+  IRegister *x;
+  uint64_t c;
+  if (!GetOperands(insn, &x, &c)) {
+    return false;
+  }
+  int width = insn->outputs_[0]->value_type_.GetWidth();
+  vector<int> pos;
+  vector<int> neg;
+  GetDigits(c, width, &pos, &neg);
+  if (!IsFaster(insn->GetResource(), width, pos, neg)) {
+    return false;
+  }
+  if (pos.empty() && neg.empty()) {
+    if (assign_ == nullptr) {
+      assign_ = DesignTool::GetOneResource(table_, resource::kSet);
+    }
+    insn->SetResource(assign_);
+    insn->SetOperand("");
+    insn->inputs_.clear();
+    insn->inputs_.push_back(DesignTool::AllocConstNum(table_, width, 0));
+  } else if (neg.empty() && pos.size() == 1) {
+    insn->SetResource(GetShifter());
+    insn->SetOperand(operand::kLeft);
+    insn->inputs_.clear();
+    insn->inputs_.push_back(x);
+    insn->inputs_.push_back(DesignTool::AllocConstNum(table_, 32, pos[0]));
+  } else if (neg.empty()) {
+    vector<IRegister *> terms;
+    BuildTerms(st, insn, x, pos, &terms);
+    int half = terms.size() / 2;
+    vector<IRegister *> lhs(terms.begin(), terms.begin() + half);
+    vector<IRegister *> rhs(terms.begin() + half, terms.end());
+    SetBinOp(insn, resource::kAdd, BuildSum(st, insn, lhs),
+	     BuildSum(st, insn, rhs));
+  } else {
+    IRegister *lhs;
+    if (pos.empty()) {
+      lhs = DesignTool::AllocConstNum(table_, width, 0);
+    } else {
+      vector<IRegister *> terms;
+      BuildTerms(st, insn, x, pos, &terms);
+      lhs = BuildSum(st, insn, terms);
+    }
+    vector<IRegister *> terms;
+    BuildTerms(st, insn, x, neg, &terms);
+    SetBinOp(insn, resource::kSub, lhs, BuildSum(st, insn, terms));
+  }
+  index_->UpdateInsn(insn);
+  return true;
+}
+
+// The result is the same as the multiplier modulo 2^width of the output.
+bool StrengthReduction::GetOperands(IInsn *insn, IRegister **x,
+				    uint64_t *c) {
+  IResource *res = insn->GetResource();
+  if (insn->inputs_.size() != 2 || insn->outputs_.size() != 1 ||
+      !insn->target_states_.empty() || res->input_types_.size() != 2 ||
+      res->output_types_.size() != 1) {
+    return false;
+  }
+  const IValueType &out = insn->outputs_[0]->value_type_;
+  if (out.IsSigned() || out.IsWide() || out.GetWidth() == 0 ||
+      res->output_types_[0].IsSigned() ||
+      res->output_types_[0].GetWidth() < out.GetWidth()) {
+    return false;
+  }
+  int k;
+  if (insn->inputs_[1]->IsConst()) {
+    k = 1;
+  } else if (insn->inputs_[0]->IsConst()) {
+    k = 0;
+  } else {
+    return false;
+  }
+  *x = insn->inputs_[1 - k];
+  IRegister *creg = insn->inputs_[k];
+  const IValueType &xt = (*x)->value_type_;
+  const IValueType &xp = res->input_types_[1 - k];
+  const IValueType &ct = creg->value_type_;
+  const IValueType &cp = res->input_types_[k];
+  if ((*x)->IsConst() || xt.IsSigned() || xt.IsWide() || xp.IsSigned() ||
+      ct.IsSigned() || ct.IsWide() || cp.IsSigned() || cp.IsWide()) {
+    return false;
+  }
+  // Shifts don't truncate x to the port.
+  if (xt.GetWidth() > xp.GetWidth() && xp.GetWidth() < out.GetWidth()) {
+    return false;
+  }
+  *c = creg->GetInitialValue().GetValue0() & Mask(ct.GetWidth()) &
+    Mask(cp.GetWidth());
+  return true;
+}
+
+// Shifts by constants are wires and don't count.
+bool StrengthReduction::IsFaster(IResource *mul, int width,
+				 const vector<int> &pos,
+				 const vector<int> &neg) {
+  int step = GetDelay(resource::kAdd, width);
+  if (!neg.empty()) {
+    step = std::max(step, GetDelay(resource::kSub, width));
+  }
+  int levels;
+  if (neg.empty()) {
+    levels = Levels(pos.size());
+  } else {
+    levels = std::max(Levels(pos.size()), Levels(neg.size())) + 1;
+  }
+  int mul_delay = platform_db_->GetResourceDelay(mul);
+  if (mul_delay <= 0) {
+    // A multiplier is not faster than an adder.
+    mul_delay = GetDelay(resource::kAdd, width);
+  }
+  return levels * step <= mul_delay;
+}
+
+// Same as DelayInfo::GetInsnDelay().
+int StrengthReduction::GetDelay(const string &klass, int width) {
+  vector<int> widths;
+  widths.push_back(width);
+  widths.push_back(width);
+  int d = platform_db_->GetDelay(klass, widths);
+  if (d > 0) {
+    return d;
+  }
+  return 1;
+}
+
+void StrengthReduction::BuildTerms(IState *st, IInsn *insn, IRegister *x,
+				   const vector<int> &amounts,
+				   vector<IRegister *> *terms) {
+  GetShifter();
+  for (int amount : amounts) {
+    if (amount == 0) {
+      terms->push_back(x);
+      continue;
+    }
+    IInsn *shift = DesignTool::CreateShiftInsn(x, true, amount);
+    IRegister *wire = AllocWire(insn);
+    shift->outputs_.push_back(wire);
+    InsertBefore(st, insn, shift);
+    terms->push_back(wire);
+  }
+}
+
+// Sums the terms in a balanced tree of adds.
+IRegister *StrengthReduction::BuildSum(IState *st, IInsn *insn,
+				       const vector<IRegister *> &terms) {
+  if (terms.size() == 1) {
+    return terms[0];
+  }
+  int half = terms.size() / 2;
+  vector<IRegister *> lhs(terms.begin(), terms.begin() + half);
+  vector<IRegister *> rhs(terms.begin() + half, terms.end());
+  IRegister *l = BuildSum(st, insn, lhs);
+  IRegister *r = BuildSum(st, insn, rhs);
+  int width = insn->outputs_[0]->value_type_.GetWidth();
+  IResource *add =
+    DesignTool::CreateBinOpResource(table_, resource::kAdd, width);
+  IInsn *add_insn = new IInsn(add);
+  add_insn->inputs_.push_back(l);
+  add_insn->inputs_.push_back(r);
+  IRegister *wire = AllocWire(insn);
+  add_insn->outputs_.push_back(wire);
+  InsertBefore(st, insn, add_insn);
+  return wire;
+}
+
+void StrengthReduction::SetBinOp(IInsn *insn, const string &klass,
+				 IRegister *lhs, IRegister *rhs) {
+  int width = insn->outputs_[0]->value_type_.GetWidth();
+  insn->SetResource(DesignTool::CreateBinOpResource(table_, klass, width));
+  insn->SetOperand("");
+  insn->inputs_.clear();
+  insn->inputs_.push_back(lhs);
+  insn->inputs_.push_back(rhs);
+}
+
+IRegister *StrengthReduction::AllocWire(IInsn *insn) {
+  IRegister *out = insn->outputs_[0];
+  IRegister *wire = DesignTool::AllocRegister(table_, out->GetName() + "_sr",
+					      out->value_type_.GetWidth());
+  wire->SetStateLocal(true);
+  return wire;
+}
+
+void StrengthReduction::InsertBefore(IState *st, IInsn *insn,
+				     IInsn *new_insn) {
+  auto pos = std::find(st->insns_.begin(), st->insns_.end(), insn);
+  st->insns_.insert(pos, new_insn);
+  index_->AddInsn(st, new_insn);
+}
+
+IResource *StrengthReduction::GetShifter() {
+  IResource *shifter =
+    DesignUtil::FindOneResourceByClassName(table_, resource::kShift);
+  if (shifter == nullptr) {
+    shifter = DesignTool::CreateShifterResource(table_);
+  }
+  return shifter;
+}
+
+}  // namespace strength
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+//
+// Rewrites multiplies by a constant into shifts and adds/subs of the
+// canonical signed digit form of the constant, e.g. x * 7 to
+// (x << 3) - x. Each multiply is rewritten only if the add tree is not
+// slower than the multiplier on the platform.
+//
+#ifndef _opt_strength_strength_reduction_h_
+#define _opt_strength_strength_reduction_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace strength {
+
+class StrengthReduction {
+public:
+  StrengthReduction(ITable *table, platform::PlatformDB *platform_db,
+		    DebugAnnotation *annotation);
+
+  void Perform();
+
+  // Non zero digits of c (mod 2^width) as shift amounts of positive and
+  // negative terms.
+  static void GetDigits(uint64_t c, int width, vector<int> *pos,
+			vector<int> *neg);
+
+private:
+  bool ReduceMul(IState *st, IInsn *insn);
+  bool GetOperands(IInsn *insn, IRegister **x, uint64_t *c);
+  bool IsFaster(IResource *mul, int width, const vector<int> &pos,
+		const vector<int> &neg);
+  int GetDelay(const string &klass, int width);
+  void BuildTerms(IState *st, IInsn *insn, IRegister *x,
+		  const vector<int> &amounts, vector<IRegister *> *terms);
+  IRegister *BuildSum(IState *st, IInsn *insn,
+		      const vector<IRegister *> &terms);
+  void SetBinOp(IInsn *insn, const string &klass, IRegister *lhs,
+		IRegister *rhs);
+  IRegister *AllocWire(IInsn *insn);
+  void InsertBefore(IState *st, IInsn *insn, IInsn *new_insn);
+  IResource *GetShifter();
+
+  ITable *table_;
+  platform::PlatformDB *platform_db_;
+  DebugAnnotation *annotation_;
+  DefUseIndex *index_;
+  IResource *assign_;
+  int num_reduced_;
+};
+
+}  // namespace strength
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_strength_strength_reduction_h_
@@ -0,0 +1,37 @@
+#include "opt/strength/strength_reduction_phase.h"
+
+#include "opt/analysis_manager.h"
+#include "opt/optimizer.h"
+#include "opt/strength/strength_reduction.h"
+
+namespace iroha {
+namespace opt {
+namespace strength {
+
+StrengthReductionPhase::~StrengthReductionPhase() {
+}
+
+Phase *StrengthReductionPhase::Create() {
+  return new StrengthReductionPhase();
+}
+
+bool StrengthReductionPhase::IsTableLocal() {
+  return true;
+}
+
+int StrengthReductionPhase::GetPreservedAnalyses() {
+  // States and transitions are not modified.
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
+bool StrengthReductionPhase::ApplyForTable(const string &key,
+					   ITable *table) {
+  StrengthReduction sr(table, optimizer_->GetPlatformDB(), annotation_);
+  sr.Perform();
+  return true;
+}
+
+}  // namespace strength
+}  // namespace opt
+}  // namespace iroha
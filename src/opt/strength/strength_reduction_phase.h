@@ -0,0 +1,27 @@
+// -*- C++ -*-
+#ifndef _opt_strength_strength_reduction_phase_h_
+#define _opt_strength_strength_reduction_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace strength {
+
+class StrengthReductionPhase : public Phase {
+public:
+  virtual ~StrengthReductionPhase();
+
+  static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace strength
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_strength_strength_reduction_phase_h_
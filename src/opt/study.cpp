@@ -1,6 +1,8 @@
 // placeholder for experiments.
 #include "opt/study.h"
 
+#include "opt/analysis_manager.h"
+
 namespace iroha {
 namespace opt {
 
@@ -11,6 +13,10 @@ Phase *Study::Create() {
   return new Study();
 }
 
+int Study::GetPreservedAnalyses() {
+  return AnalysisManager::ANALYSIS_ALL;
+}
+
 }  // namespace opt
 }  // namespace iroha
 
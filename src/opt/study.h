@@ -12,6 +12,7 @@ public:
   virtual ~Study();
 
   static Phase *Create();
+  virtual int GetPreservedAnalyses();
 };
 
 }  // namespace opt
@@ -79,6 +79,22 @@ IState *StateCopier::GetContinueState() {
   return continue_st_;
 }
 
+IState *StateCopier::GetCopiedState(IState *st) {
+  auto it = state_copy_map_.find(st);
+  if (it == state_copy_map_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+IInsn *StateCopier::GetCopiedInsn(IInsn *insn) {
+  auto it = insn_copy_map_.find(insn);
+  if (it == insn_copy_map_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
 }  // namespace unroll
 }  // namespace opt
 }  // namespace iroha
@@ -18,6 +18,9 @@ public:
   void Copy();
   IState *GetInitialState();
   IState *GetContinueState();
+  // nullptr if the state or insn is not copied.
+  IState *GetCopiedState(IState *st);
+  IInsn *GetCopiedInsn(IInsn *insn);
 
 private:
   void CopyState(IState *st);
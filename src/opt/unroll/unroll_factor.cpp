@@ -0,0 +1,105 @@
+#include "opt/unroll/unroll_factor.h"
+
+#include "iroha/i_design.h"
+#include "opt/loop/loop_block.h"
+#include "opt/sched/resource_entry.h"
+#include "opt/sched/virtual_resource.h"
+#include "opt/sched/virtual_resource_set.h"
+
+namespace iroha {
+namespace opt {
+namespace unroll {
+
+UnrollFactor::UnrollFactor(ITable *tab, loop::LoopBlock *lb,
+			   long long trip_count)
+  : tab_(tab), lb_(lb), trip_count_(trip_count) {
+}
+
+int UnrollFactor::Choose() {
+  int max_factor = kMaxFactor;
+  long long trip_count = trip_count_;
+  if (!GetProfileTripCount(&trip_count)) {
+    return 1;
+  }
+  if (trip_count >= 0 && trip_count < max_factor) {
+    max_factor = trip_count;
+  }
+  int res_limit = GetResourceLimit();
+  if (res_limit < max_factor) {
+    max_factor = res_limit;
+  }
+  for (int factor = max_factor; factor > 1; --factor) {
+    if (GetNumNewStates(factor) <= kMaxNewStates) {
+      return factor;
+    }
+  }
+  return 1;
+}
+
+// Returns false if the loop is cold. Keeps trip_count if the profile
+// isn't available.
+bool UnrollFactor::GetProfileTripCount(long long *trip_count) {
+  const IProfile &loop_prof = lb_->GetCompareState()->GetProfile();
+  if (!loop_prof.valid_) {
+    return true;
+  }
+  long max_count = 0;
+  for (IState *st : tab_->states_) {
+    const IProfile &prof = st->GetProfile();
+    if (prof.valid_ && prof.raw_count_ > max_count) {
+      max_count = prof.raw_count_;
+    }
+  }
+  if (loop_prof.raw_count_ * kColdRatio < max_count) {
+    return false;
+  }
+  const IProfile &entry_prof = lb_->GetEntryAssignState()->GetProfile();
+  if (*trip_count < 0 && entry_prof.valid_ && entry_prof.raw_count_ > 0) {
+    // The compare runs once more than the body for each entry.
+    *trip_count = loop_prof.raw_count_ / entry_prof.raw_count_ - 1;
+  }
+  return true;
+}
+
+int UnrollFactor::GetResourceLimit() {
+  sched::VirtualResourceSet vrs(tab_);
+  vector<IInsn *> insns;
+  for (IState *st : lb_->GetStates()) {
+    for (IInsn *insn : st->insns_) {
+      if (insn->GetResource()->GetClass()->IsExclusive()) {
+	vrs.GetFromInsn(insn);
+	insns.push_back(insn);
+      }
+    }
+  }
+  vrs.BuildDefaultBinding();
+  map<sched::ResourceEntry *, int> uses;
+  for (IInsn *insn : insns) {
+    ++uses[vrs.GetFromInsn(insn)->GetResourceEntry()];
+  }
+  int num_states = lb_->GetStates().size();
+  int limit = kMaxFactor;
+  for (auto &p : uses) {
+    int n = num_states * p.first->GetNumReplicas() / p.second;
+    if (n < limit) {
+      limit = n;
+    }
+  }
+  return limit;
+}
+
+int UnrollFactor::GetNumNewStates(int factor) {
+  // Each copy has a continue state.
+  int num_copies = factor;
+  if (trip_count_ < 0) {
+    // Pre-check state.
+    return num_copies * (lb_->GetStates().size() + 1) + 1;
+  }
+  // Epilogue.
+  num_copies += trip_count_ % factor;
+  return num_copies * (lb_->GetStates().size() + 1);
+}
+
+}  // namespace unroll
+}  // namespace opt
+}  // namespace iroha
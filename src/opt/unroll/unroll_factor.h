@@ -0,0 +1,53 @@
+// -*- C++ -*-
+//
+// Chooses an unroll factor of a loop without LOOP-UNROLL factor.
+//
+// * Profile: Loops executed much less than the hottest state of the
+//   table are not unrolled. The trip count is estimated from the counts
+//   of the compare state and the entry assign state if it isn't a
+//   constant.
+// * Resources: Iterations unrolled by N should fit in the states of one
+//   iteration without using an exclusive resource more than its replicas
+//   in a state.
+// * Budget: Number of states added by the unrolling.
+//
+#ifndef _opt_unroll_unroll_factor_h_
+#define _opt_unroll_unroll_factor_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+namespace opt {
+namespace loop {
+class LoopBlock;
+}  // namespace loop
+namespace unroll {
+
+class UnrollFactor {
+public:
+  // trip_count is -1 if not known.
+  UnrollFactor(ITable *tab, loop::LoopBlock *lb, long long trip_count);
+
+  // Returns 1 if the loop shouldn't be unrolled.
+  int Choose();
+
+  static const int kMaxFactor = 8;
+  static const int kMaxNewStates = 64;
+  // A loop is cold if the hottest state is executed this times more.
+  static const int kColdRatio = 16;
+
+private:
+  bool GetProfileTripCount(long long *trip_count);
+  int GetResourceLimit();
+  int GetNumNewStates(int factor);
+
+  ITable *tab_;
+  loop::LoopBlock *lb_;
+  long long trip_count_;
+};
+
+}  // namespace unroll
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_unroll_unroll_factor_h_
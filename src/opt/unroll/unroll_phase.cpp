@@ -2,7 +2,11 @@
 
 #include "iroha/i_design.h"
 #include "iroha/resource_params.h"
+#include "opt/analysis_manager.h"
+#include "opt/debug_annotation.h"
 #include "opt/loop/loop_block.h"
+#include "opt/optimizer.h"
+#include "opt/unroll/unroll_factor.h"
 #include "opt/unroll/unroller.h"
 
 namespace iroha {
@@ -16,27 +20,62 @@ Phase *UnrollPhase::Create() {
   return new UnrollPhase();
 }
 
+bool UnrollPhase::IsTableLocal() {
+  return true;
+}
+
 bool UnrollPhase::ApplyForTable(const string &key, ITable *table) {
-  for (IRegister *reg : table->registers_) {
+  bool has_profile = HasProfile(table);
+  // Unrolling allocates new registers.
+  vector<IRegister *> regs = table->registers_;
+  for (IRegister *reg : regs) {
     auto *params = reg->GetParams(false);
-    if (params == nullptr) {
+    int unroll_count = 0;
+    if (params != nullptr &&
+	!params->GetValues(resource::kLoopUnroll).empty()) {
+      unroll_count = params->GetLoopUnroll();
+    } else if (!has_profile) {
+      // Loops without the param are unrolled only by the profile.
       continue;
     }
-    int unroll_count = params->GetLoopUnroll();
-    if (unroll_count <= 1) {
-      // 1 for no unroll. 0 for auto (TBD).
+    if (unroll_count == 1) {
+      // 1 for no unroll. 0 for auto.
       continue;
     }
-    loop::LoopBlock lb(table, reg);
-    if (!lb.Build()) {
+    AnalysisManager *analysis = optimizer_->GetAnalysisManager();
+    loop::LoopBlock *lb = analysis->GetLoopBlock(table, reg);
+    if (lb == nullptr) {
       continue;
     }
-    Unroller unroller(table, &lb, unroll_count);
-    unroller.Unroll();
+    Unroller unroller(table, lb, reg);
+    if (!unroller.Check()) {
+      continue;
+    }
+    if (unroll_count == 0) {
+      UnrollFactor factor(table, lb, unroller.GetTripCount());
+      unroll_count = factor.Choose();
+    }
+    if (!unroller.Unroll(unroll_count)) {
+      continue;
+    }
+    if (annotation_->IsEnabled()) {
+      annotation_->Table(table) << "Unrolled the loop of " << reg->GetName()
+				<< " by " << unroll_count << "\n";
+    }
+    analysis->Invalidate(table);
   }
   return true;
 }
 
+bool UnrollPhase::HasProfile(ITable *table) {
+  for (IState *st : table->states_) {
+    if (st->GetProfile().valid_) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace unroll
 }  // namespace opt
 }  // namespace iroha
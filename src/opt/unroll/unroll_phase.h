@@ -13,9 +13,11 @@ public:
   virtual ~UnrollPhase();
 
   static Phase *Create();
+  virtual bool IsTableLocal();
 
 private:
   virtual bool ApplyForTable(const string &key, ITable *table);
+  bool HasProfile(ITable *table);
 };
 
 }  // namespace unroll
@@ -3,49 +3,362 @@
 #include "design/design_util.h"
 #include "design/design_tool.h"
 #include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "iroha/stl_util.h"
 #include "opt/loop/loop_block.h"
+#include "opt/opt_util.h"
 #include "opt/unroll/state_copier.h"
 
 namespace iroha {
 namespace opt {
 namespace unroll {
 
-Unroller::Unroller(ITable *tab, loop::LoopBlock *lb, int unroll_count)
-  : tab_(tab), lb_(lb), unroll_count_(unroll_count) {
-  copiers_.reset(new vector<StateCopier *>());
+// Shifting by 64 or more bits is undefined.
+static bool FitsWidth(uint64_t value, int width) {
+  return width >= 64 || (value >> width) == 0;
 }
 
-bool Unroller::Unroll() {
-  if ((lb_->GetLoopCount() % unroll_count_) != 0) {
+Unroller::Unroller(ITable *tab, loop::LoopBlock *lb, IRegister *index)
+  : tab_(tab), lb_(lb), index_(index), entry_st_(nullptr), init_(0),
+    trip_count_(-1) {
+}
+
+Unroller::~Unroller() {
+  STLDeleteValues(&copiers_);
+}
+
+bool Unroller::Check() {
+  loop_states_.insert(lb_->GetStates().begin(), lb_->GetStates().end());
+  OptUtil::CollectTransitionPreds(tab_, &preds_);
+  return CheckEntry() && CheckIndex() && CheckBound() && CheckCondition();
+}
+
+long long Unroller::GetTripCount() {
+  return trip_count_;
+}
+
+bool Unroller::Unroll(int unroll_count) {
+  if (unroll_count < 2 ||
+      (trip_count_ >= 0 && trip_count_ < unroll_count)) {
+    return false;
+  }
+  IInsn *compare_insn = lb_->GetCompareInsn();
+  if (trip_count_ < 0 &&
+      !FitsWidth(unroll_count - 1,
+		 compare_insn->inputs_[0]->value_type_.GetWidth())) {
+    // Can't compute the limit in the width of the bound.
+    return false;
+  }
+  IState *compare_st = lb_->GetCompareState();
+  IState *exit_st = lb_->GetExitState();
+  vector<StateCopier *> main_copiers;
+  CopyLoop(unroll_count, true, &main_copiers);
+  IState *main_st = GetCompareState(main_copiers[0]);
+  IInsn *head_compare = main_copiers[0]->GetCopiedInsn(compare_insn);
+  IInsn *head_branch = main_copiers[0]->GetCopiedInsn(lb_->GetBranchInsn());
+  Chain(main_copiers, main_st);
+  if (trip_count_ < 0) {
+    // The original loop runs the remaining iterations.
+    head_branch->target_states_[0] = compare_st;
+    RedirectEntry(AddPreCheck(unroll_count, head_compare, main_st));
+    return true;
+  }
+  int rem = trip_count_ % unroll_count;
+  if (rem == 0) {
+    head_branch->target_states_[0] = exit_st;
+  } else {
+    IRegister *count = head_compare->inputs_[0];
+    head_compare->inputs_[0] =
+      DesignTool::AllocConstNum(tab_, count->value_type_.GetWidth(),
+				init_ + trip_count_ - rem);
+    vector<StateCopier *> epilogue_copiers;
+    CopyLoop(rem, false, &epilogue_copiers);
+    Chain(epilogue_copiers, exit_st);
+    head_branch->target_states_[0] = GetCompareState(epilogue_copiers[0]);
+  }
+  RedirectEntry(main_st);
+  return true;
+}
+
+// The loop should be entered only from the initial assignment.
+bool Unroller::CheckEntry() {
+  IState *compare_st = lb_->GetCompareState();
+  IState *st = lb_->GetEntryAssignState();
+  if (loop_states_.find(st) != loop_states_.end()) {
+    return false;
+  }
+  IInsn *init_insn = nullptr;
+  for (IInsn *insn : st->insns_) {
+    for (IRegister *reg : insn->outputs_) {
+      if (reg != index_) {
+	continue;
+      }
+      if (init_insn != nullptr ||
+	  !resource::IsSet(*insn->GetResource()->GetClass()) ||
+	  insn->inputs_.size() != 1 || !insn->inputs_[0]->IsConst()) {
+	return false;
+      }
+      init_insn = insn;
+    }
+  }
+  if (init_insn == nullptr) {
+    return false;
+  }
+  init_ = init_insn->inputs_[0]->GetInitialValue().GetValue0();
+  int num_states = tab_->states_.size();
+  for (int i = 0; i < num_states; ++i) {
+    IState *next = OptUtil::GetOneNextState(st);
+    if (next == nullptr) {
+      return false;
+    }
+    if (next == compare_st) {
+      entry_st_ = st;
+      break;
+    }
+    if (loop_states_.find(next) != loop_states_.end() ||
+	preds_[next].size() != 1) {
+      return false;
+    }
+    for (IInsn *insn : next->insns_) {
+      for (IRegister *reg : insn->outputs_) {
+	if (reg == index_) {
+	  return false;
+	}
+      }
+    }
+    st = next;
+  }
+  if (entry_st_ == nullptr) {
+    return false;
+  }
+  for (IState *pred : preds_[compare_st]) {
+    if (pred != entry_st_ && loop_states_.find(pred) == loop_states_.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Unroller::CheckIndex() {
+  const IValueType &type = index_->value_type_;
+  if (type.IsSigned() || type.IsWide() || type.GetWidth() == 0 ||
+      !FitsWidth(init_, type.GetWidth())) {
+    return false;
+  }
+  IState *incr_st = nullptr;
+  for (IState *st : lb_->GetStates()) {
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *reg : insn->outputs_) {
+	if (reg != index_) {
+	  continue;
+	}
+	if (incr_st != nullptr || !IsIncrement(insn)) {
+	  return false;
+	}
+	incr_st = st;
+      }
+    }
+  }
+  if (incr_st == nullptr) {
+    return false;
+  }
+  return CheckIncrement(incr_st);
+}
+
+// Each iteration should pass the increment just once.
+bool Unroller::CheckIncrement(IState *incr_st) {
+  IState *compare_st = lb_->GetCompareState();
+  if (incr_st != compare_st &&
+      IsReachable(compare_st, compare_st, incr_st)) {
     return false;
   }
-  for (int i = 0; i < unroll_count_; ++i) {
-    bool is_head = (i == 0);
-    UnrollOne(is_head);
+  return !IsReachable(incr_st, incr_st, compare_st);
+}
+
+bool Unroller::CheckBound() {
+  IInsn *compare_insn = lb_->GetCompareInsn();
+  IResource *res = compare_insn->GetResource();
+  if (compare_insn->inputs_.size() != 2 ||
+      compare_insn->outputs_.size() != 1 || res->input_types_.size() != 2) {
+    return false;
+  }
+  IRegister *bound = compare_insn->inputs_[0];
+  const IValueType &type = bound->value_type_;
+  if (type.IsSigned() || type.IsWide() || type.GetWidth() == 0) {
+    return false;
+  }
+  int width = index_->value_type_.GetWidth();
+  if (type.GetWidth() > width) {
+    width = type.GetWidth();
+  }
+  // Compares without truncation.
+  for (IValueType &t : res->input_types_) {
+    if (t.IsSigned() || t.GetWidth() < width) {
+      return false;
+    }
+  }
+  if (bound->IsConst()) {
+    uint64_t count = bound->GetInitialValue().GetValue0();
+    if (!FitsWidth(count, index_->value_type_.GetWidth())) {
+      return false;
+    }
+    trip_count_ = (count > init_) ? (count - init_) : 0;
+    return true;
+  }
+  for (IState *st : lb_->GetStates()) {
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *reg : insn->outputs_) {
+	if (reg == bound) {
+	  return false;
+	}
+      }
+    }
+  }
+  trip_count_ = -1;
+  return true;
+}
+
+bool Unroller::CheckCondition() {
+  // The condition will be computed only in the first copy.
+  IInsn *compare_insn = lb_->GetCompareInsn();
+  IInsn *branch_insn = lb_->GetBranchInsn();
+  IRegister *cond = compare_insn->outputs_[0];
+  for (IState *st : tab_->states_) {
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *reg : insn->inputs_) {
+	if (reg == cond && insn != branch_insn) {
+	  return false;
+	}
+      }
+      for (IRegister *reg : insn->outputs_) {
+	if (reg == cond && insn != compare_insn) {
+	  return false;
+	}
+      }
+    }
   }
-  Reconnect();
   return true;
 }
 
-void Unroller::UnrollOne(bool is_head) {
-  StateCopier *copier = new StateCopier(tab_, lb_, is_head);
-  copier->Copy();
-  copiers_->push_back(copier);
+bool Unroller::IsIncrement(IInsn *insn) {
+  IResource *res = insn->GetResource();
+  if (res->GetClass()->GetName() != resource::kAdd ||
+      insn->inputs_.size() != 2 || insn->outputs_.size() != 1 ||
+      res->input_types_.size() != 2 || res->output_types_.size() != 1) {
+    return false;
+  }
+  int width = index_->value_type_.GetWidth();
+  for (IValueType &t : res->input_types_) {
+    if (t.IsSigned() || t.GetWidth() < width) {
+      return false;
+    }
+  }
+  if (res->output_types_[0].IsSigned() ||
+      res->output_types_[0].GetWidth() < width) {
+    return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    IRegister *one = insn->inputs_[1 - i];
+    if (insn->inputs_[i] == index_ && one->IsConst() &&
+	one->GetInitialValue().GetValue0() == 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Walks loop states from the next states of |from| without passing |avoid|.
+bool Unroller::IsReachable(IState *from, IState *to, IState *avoid) {
+  set<IState *> visited;
+  vector<IState *> work;
+  work.push_back(from);
+  while (!work.empty()) {
+    IState *st = work.back();
+    work.pop_back();
+    for (IInsn *insn : st->insns_) {
+      for (IState *next : insn->target_states_) {
+	if (next == to) {
+	  return true;
+	}
+	if (next == avoid || loop_states_.find(next) == loop_states_.end() ||
+	    !visited.insert(next).second) {
+	  continue;
+	}
+	work.push_back(next);
+      }
+    }
+  }
+  return false;
+}
+
+void Unroller::CopyLoop(int num, bool has_head,
+			vector<StateCopier *> *copiers) {
+  for (int i = 0; i < num; ++i) {
+    bool is_head = has_head && (i == 0);
+    StateCopier *copier = new StateCopier(tab_, lb_, is_head);
+    copier->Copy();
+    copiers->push_back(copier);
+    copiers_.push_back(copier);
+  }
+}
+
+IState *Unroller::GetCompareState(StateCopier *copier) {
+  return copier->GetCopiedState(lb_->GetCompareState());
+}
+
+void Unroller::Chain(const vector<StateCopier *> &copiers, IState *next) {
+  for (int i = 0; i < copiers.size() - 1; ++i) {
+    DesignTool::AddNextState(copiers[i]->GetContinueState(),
+			     GetCompareState(copiers[i + 1]));
+  }
+  DesignTool::AddNextState(copiers.back()->GetContinueState(), next);
+}
+
+// Before:
+//  (Sa) -> (Sb) R > i
+// After:
+//  (Sa) -> (P) lim <- R - (N - 1), if R > N - 2 then main else Sb
+IState *Unroller::AddPreCheck(int unroll_count, IInsn *head_compare,
+			      IState *main_st) {
+  IRegister *bound = head_compare->inputs_[0];
+  int width = bound->value_type_.GetWidth();
+  IState *st = new IState(tab_);
+  tab_->states_.push_back(st);
+  IRegister *lim =
+    DesignTool::AllocRegister(tab_, index_->GetName() + "_lim", width);
+  IInsn *sub_insn =
+    new IInsn(DesignTool::CreateBinOpResource(tab_, resource::kSub, width));
+  sub_insn->inputs_.push_back(bound);
+  sub_insn->inputs_.push_back(DesignTool::AllocConstNum(tab_, width,
+							unroll_count - 1));
+  sub_insn->outputs_.push_back(lim);
+  st->insns_.push_back(sub_insn);
+  IRegister *cond =
+    DesignTool::AllocRegister(tab_, index_->GetName() + "_unroll", 0);
+  cond->SetStateLocal(true);
+  IInsn *gt_insn =
+    new IInsn(DesignTool::CreateBinOpResource(tab_, resource::kGt, width));
+  gt_insn->inputs_.push_back(bound);
+  gt_insn->inputs_.push_back(DesignTool::AllocConstNum(tab_, width,
+						       unroll_count - 2));
+  gt_insn->outputs_.push_back(cond);
+  st->insns_.push_back(gt_insn);
+  IInsn *tr = DesignUtil::GetTransitionInsn(st);
+  tr->inputs_.push_back(cond);
+  tr->target_states_.push_back(lb_->GetCompareState());
+  tr->target_states_.push_back(main_st);
+  head_compare->inputs_[0] = lim;
+  return st;
 }
 
-void Unroller::Reconnect() {
-  IState *es = lb_->GetEntryAssignState();
-  IInsn *tr = DesignUtil::FindTransitionInsn(es);
-  tr->target_states_.clear();
-  tr->target_states_.push_back(copiers_->at(0)->GetInitialState());
-  for (int i = 0; i < copiers_->size() - 1; ++i) {
-    StateCopier *cur = copiers_->at(i);
-    StateCopier *next = copiers_->at(i + 1);
-    DesignTool::AddNextState(cur->GetContinueState(), next->GetInitialState());
+void Unroller::RedirectEntry(IState *st) {
+  for (IInsn *insn : entry_st_->insns_) {
+    for (int i = 0; i < insn->target_states_.size(); ++i) {
+      if (insn->target_states_[i] == lb_->GetCompareState()) {
+	insn->target_states_[i] = st;
+      }
+    }
   }
-  StateCopier *head = copiers_->at(0);
-  StateCopier *last = copiers_->at(copiers_->size() - 1);
-  DesignTool::AddNextState(last->GetContinueState(), head->GetInitialState());
 }
 
 }  // namespace unroll
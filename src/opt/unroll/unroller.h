@@ -1,4 +1,23 @@
 // -*- C++ -*-
+//
+// Partial unrolling of a loop by N.
+//
+// Main loop: N copies of the loop states. Only the first copy has the
+// compare and the branch, and it enters the copies if N more iterations
+// remain.
+//
+//  Constant trip count T:
+//   (Sa) i <- init -> main (i < init + T - T % N) -> epilogue -> (Se)
+//   The epilogue is T % N copies without the compare.
+//
+//  Register bound R:
+//   (Sa) i <- init -> (P) pre-check: lim <- R - (N - 1)
+//         R >= N - 1 ? -> main (i < lim) -> original loop -> (Se)
+//                    : -> original loop -> (Se)
+//   The original loop runs the remaining iterations.
+//
+// The index should be incremented by 1 once in each iteration.
+//
 #ifndef _opt_unroll_unroller_h_
 #define _opt_unroll_unroller_h_
 
@@ -15,18 +34,40 @@ class StateCopier;
 
 class Unroller {
 public:
-  Unroller(ITable *tab, loop::LoopBlock *lb, int unroll_count);
+  Unroller(ITable *tab, loop::LoopBlock *lb, IRegister *index);
+  ~Unroller();
 
-  bool Unroll();
+  // Returns false if the loop can't be unrolled.
+  bool Check();
+  // -1 if the bound is a register. Valid after Check().
+  long long GetTripCount();
+  bool Unroll(int unroll_count);
 
 private:
-  void UnrollOne(bool is_head);
-  void Reconnect();
+  bool CheckEntry();
+  bool CheckIndex();
+  bool CheckIncrement(IState *incr_st);
+  bool CheckBound();
+  bool CheckCondition();
+  bool IsIncrement(IInsn *insn);
+  bool IsReachable(IState *from, IState *to, IState *avoid);
+  void CopyLoop(int num, bool has_head, vector<StateCopier *> *copiers);
+  IState *GetCompareState(StateCopier *copier);
+  void Chain(const vector<StateCopier *> &copiers, IState *next);
+  IState *AddPreCheck(int unroll_count, IInsn *head_compare,
+		      IState *main_st);
+  void RedirectEntry(IState *st);
 
   ITable *tab_;
   loop::LoopBlock *lb_;
-  int unroll_count_;
-  std::unique_ptr<vector<StateCopier *> > copiers_;
+  IRegister *index_;
+  set<IState *> loop_states_;
+  // The only state outside of the loop which transits to the compare.
+  IState *entry_st_;
+  map<IState *, set<IState *> > preds_;
+  uint64_t init_;
+  long long trip_count_;
+  vector<StateCopier *> copiers_;
 };
 
 }  // namespace unroll
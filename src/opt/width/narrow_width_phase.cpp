@@ -0,0 +1,37 @@
+#include "opt/width/narrow_width_phase.h"
+
+#include "opt/analysis_manager.h"
+#include "opt/optimizer.h"
+#include "opt/width/width_narrower.h"
+
+namespace iroha {
+namespace opt {
+namespace width {
+
+NarrowWidthPhase::~NarrowWidthPhase() {
+}
+
+Phase *NarrowWidthPhase::Create() {
+  return new NarrowWidthPhase();
+}
+
+bool NarrowWidthPhase::IsTableLocal() {
+  return true;
+}
+
+int NarrowWidthPhase::GetPreservedAnalyses() {
+  // States and transitions are not modified.
+  return AnalysisManager::ANALYSIS_BB_SET |
+    AnalysisManager::ANALYSIS_DOMINATOR_TREE;
+}
+
+bool NarrowWidthPhase::ApplyForTable(const string &key, ITable *table) {
+  WidthNarrower narrower(table, optimizer_->GetAnalysisManager(),
+			 annotation_);
+  narrower.Perform();
+  return true;
+}
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
@@ -0,0 +1,27 @@
+// -*- C++ -*-
+#ifndef _opt_width_narrow_width_phase_h_
+#define _opt_width_narrow_width_phase_h_
+
+#include "opt/phase.h"
+
+namespace iroha {
+namespace opt {
+namespace width {
+
+class NarrowWidthPhase : public Phase {
+public:
+  virtual ~NarrowWidthPhase();
+
+  static Phase *Create();
+  virtual int GetPreservedAnalyses();
+  virtual bool IsTableLocal();
+
+private:
+  virtual bool ApplyForTable(const string &key, ITable *table);
+};
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_width_narrow_width_phase_h_
@@ -0,0 +1,577 @@
+#include "opt/width/value_range.h"
+
+#include "design/def_use_index.h"
+#include "design/design_util.h"
+#include "iroha/i_design.h"
+#include "iroha/insn_operands.h"
+#include "iroha/resource_class.h"
+#include "opt/analysis_manager.h"
+#include "opt/bb_set.h"
+#include "opt/dominator_tree.h"
+#include "opt/opt_util.h"
+
+namespace iroha {
+namespace opt {
+namespace width {
+
+// A range growing more times than this is widened.
+static const int kWidenLimit = 3;
+
+ValueRange::ValueRange(ITable *table, AnalysisManager *analysis)
+  : table_(table), analysis_(analysis), index_(nullptr), bset_(nullptr),
+    dom_tree_(nullptr), changed_(false) {
+}
+
+void ValueRange::Perform() {
+  index_ = DefUseIndex::GetOrCreate(table_);
+  InitRanges();
+  CollectGuards();
+  do {
+    changed_ = false;
+    for (IState *st : table_->states_) {
+      for (IInsn *insn : st->insns_) {
+	Update(st, insn);
+      }
+    }
+  } while (changed_);
+}
+
+ValueRange::Range ValueRange::GetRange(IRegister *reg) {
+  auto it = ranges_.find(reg);
+  if (it == ranges_.end()) {
+    return Range();
+  }
+  return it->second;
+}
+
+ValueRange::Range ValueRange::GetInputRange(IInsn *insn, int index) {
+  return ReadRange(index_->GetState(insn), insn->inputs_[index]);
+}
+
+ValueRange::Range ValueRange::GetResultRange(IInsn *insn) {
+  return Evaluate(index_->GetState(insn), insn);
+}
+
+bool ValueRange::IsTracked(const IValueType &type) {
+  return !type.IsSigned() && !type.IsWide();
+}
+
+ValueRange::Range ValueRange::FullRange(const IValueType &type) {
+  if (!IsTracked(type)) {
+    return Range();
+  }
+  return Range(0, Mask(type.GetWidth()));
+}
+
+uint64_t ValueRange::Mask(int width) {
+  if (width <= 0) {
+    // Scalar.
+    return 1;
+  }
+  if (width >= 64) {
+    return ~0ULL;
+  }
+  return (1ULL << width) - 1;
+}
+
+int ValueRange::Bits(uint64_t value) {
+  int n = 1;
+  while (n < 64 && (value >> n) != 0) {
+    ++n;
+  }
+  return n;
+}
+
+void ValueRange::InitRanges() {
+  for (IRegister *reg : table_->registers_) {
+    const IValueType &type = reg->value_type_;
+    if (!IsTracked(type)) {
+      continue;
+    }
+    uint64_t mask = Mask(type.GetWidth());
+    if (reg->IsConst()) {
+      uint64_t v = reg->GetInitialValue().GetValue0() & mask;
+      ranges_[reg] = Range(v, v);
+    } else if (index_->GetDefs(reg).empty()) {
+      // e.g. an input or a register written by other tables.
+      ranges_[reg] = FullRange(type);
+    } else if (reg->HasInitialValue()) {
+      uint64_t v = reg->GetInitialValue().GetValue0() & mask;
+      ranges_[reg] = Range(v, v);
+    } else {
+      ranges_[reg] = Range(0, 0);
+    }
+  }
+}
+
+// Before:
+//  S1: c <(gt)- x, K
+//      (tr)- c -> S3 (else S2)
+//  S2: .. (x <= K here)
+//
+// A guard from a branch to T applies to the states dominated by T, if
+// T is only reached from the branch and x is not written between the
+// compare and the states. In a loop like
+//  S2: ..
+//  S4: x <- x + 1, -> S1
+// the increment reads x <= K, so the range of x converges to [0, K + 1].
+void ValueRange::CollectGuards() {
+  vector<pair<IState *, IInsn *> > branches;
+  for (IState *st : table_->states_) {
+    IInsn *insn = DesignUtil::FindTransitionInsn(st);
+    if (insn != nullptr && insn->target_states_.size() == 2 &&
+	insn->inputs_.size() == 1) {
+      branches.push_back(make_pair(st, insn));
+    }
+  }
+  if (branches.empty()) {
+    return;
+  }
+  map<IState *, set<IState *> > targets;
+  map<IState *, set<IState *> > preds;
+  OptUtil::CollectTransitionTargets(table_, &targets);
+  OptUtil::CollectTransitionPreds(table_, &preds);
+  bset_ = analysis_->GetBBSet(table_, false);
+  dom_tree_ = analysis_->GetDominatorTree(table_);
+  for (auto &p : branches) {
+    CollectGuard(p.first, p.second, targets, preds);
+  }
+}
+
+void ValueRange::CollectGuard(IState *branch_st, IInsn *tr,
+			      map<IState *, set<IState *> > &targets,
+			      map<IState *, set<IState *> > &preds) {
+  IRegister *cond = tr->inputs_[0];
+  const vector<IInsn *> &cond_defs = index_->GetDefs(cond);
+  if (cond_defs.size() != 1) {
+    return;
+  }
+  IInsn *compare = cond_defs[0];
+  IState *compare_st = index_->GetState(compare);
+  if (compare_st == branch_st) {
+    if (!cond->IsStateLocal()) {
+      // Reads the result of the previous compare.
+      return;
+    }
+  } else {
+    if (cond->IsStateLocal() || preds[branch_st].size() != 1 ||
+	*preds[branch_st].begin() != compare_st ||
+	targets[compare_st].size() != 1) {
+      return;
+    }
+  }
+  for (int t = 0; t < 2; ++t) {
+    IRegister *reg;
+    Range range;
+    if (!GetGuardRange(compare, t == 1, &reg, &range)) {
+      continue;
+    }
+    IState *target = tr->target_states_[t];
+    if (target == branch_st || preds[target].size() != 1) {
+      continue;
+    }
+    auto it = bset_->state_to_bb_.find(target);
+    if (it == bset_->state_to_bb_.end() ||
+	it->second->states_[0] != target) {
+      continue;
+    }
+    BB *target_bb = it->second;
+    set<IState *> dominated;
+    for (IState *st : table_->states_) {
+      auto jt = bset_->state_to_bb_.find(st);
+      if (jt != bset_->state_to_bb_.end() &&
+	  dom_tree_->Dominates(target_bb, jt->second)) {
+	dominated.insert(st);
+      }
+    }
+    // Defs in other states reach the dominated states only through the
+    // target, where the guard holds again.
+    vector<IState *> work;
+    for (IInsn *def : index_->GetDefs(reg)) {
+      IState *def_st = index_->GetState(def);
+      if (def_st == branch_st || def_st == compare_st) {
+	return;
+      }
+      if (dominated.find(def_st) != dominated.end()) {
+	work.push_back(def_st);
+      }
+    }
+    // States after a def without passing the target again. A def state
+    // itself still reads the guarded value.
+    set<IState *> written;
+    while (!work.empty()) {
+      IState *st = work.back();
+      work.pop_back();
+      for (IState *next : targets[st]) {
+	if (next != target && dominated.find(next) != dominated.end() &&
+	    written.insert(next).second) {
+	  work.push_back(next);
+	}
+      }
+    }
+    for (IState *st : table_->states_) {
+      if (dominated.find(st) != dominated.end() &&
+	  written.find(st) == written.end()) {
+	AddGuard(st, reg, range);
+      }
+    }
+  }
+}
+
+// Range of the compared register when the branch is taken (cond is
+// true) or not.
+bool ValueRange::GetGuardRange(IInsn *compare, bool taken, IRegister **reg,
+			       Range *range) {
+  IResource *res = compare->GetResource();
+  const string &name = res->GetClass()->GetName();
+  if (!resource::IsNumToBoolExclusiveBinOp(*res->GetClass()) ||
+      compare->inputs_.size() != 2 || res->input_types_.size() != 2) {
+    return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    const IValueType &type = compare->inputs_[i]->value_type_;
+    const IValueType &port = res->input_types_[i];
+    // Inputs are truncated to the ports.
+    if (!IsTracked(type) || !IsTracked(port) ||
+	Mask(port.GetWidth()) < Mask(type.GetWidth())) {
+      return false;
+    }
+  }
+  bool reg_first;
+  IRegister *k;
+  if (compare->inputs_[1]->IsConst()) {
+    *reg = compare->inputs_[0];
+    k = compare->inputs_[1];
+    reg_first = true;
+  } else if (compare->inputs_[0]->IsConst()) {
+    *reg = compare->inputs_[1];
+    k = compare->inputs_[0];
+    reg_first = false;
+  } else {
+    return false;
+  }
+  if ((*reg)->IsConst() || (*reg)->IsStateLocal()) {
+    return false;
+  }
+  uint64_t m = Mask((*reg)->value_type_.GetWidth());
+  uint64_t v = k->GetInitialValue().GetValue0() &
+    Mask(k->value_type_.GetWidth());
+  uint64_t lo = 0;
+  uint64_t hi = m;
+  if (name == resource::kEq) {
+    if (!taken) {
+      return false;
+    }
+    lo = hi = v;
+  } else {
+    // Normalizes to (reg > v) or (reg >= v).
+    bool is_gt = (name == resource::kGt);
+    bool holds = taken;
+    if (!reg_first) {
+      // v > reg is !(reg >= v) and v >= reg is !(reg > v).
+      is_gt = !is_gt;
+      holds = !holds;
+    }
+    if (is_gt) {
+      if (holds) {
+	if (v >= m) {
+	  return false;
+	}
+	lo = v + 1;
+      } else {
+	hi = v;
+      }
+    } else {
+      if (holds) {
+	lo = v;
+      } else {
+	if (v == 0) {
+	  return false;
+	}
+	hi = v - 1;
+      }
+    }
+  }
+  if (hi > m) {
+    hi = m;
+  }
+  if (lo > hi) {
+    return false;
+  }
+  *range = Range(lo, hi);
+  return true;
+}
+
+void ValueRange::AddGuard(IState *st, IRegister *reg, const Range &r) {
+  map<IRegister *, Range> &guards = guards_[st];
+  auto it = guards.find(reg);
+  if (it == guards.end()) {
+    guards[reg] = r;
+    return;
+  }
+  Range &g = it->second;
+  g.lo = std::max(g.lo, r.lo);
+  g.hi = std::min(g.hi, r.hi);
+  if (g.lo > g.hi) {
+    // Not reachable.
+    g.lo = g.hi;
+  }
+}
+
+void ValueRange::Update(IState *st, IInsn *insn) {
+  if (insn->outputs_.empty()) {
+    return;
+  }
+  if (insn->outputs_.size() != 1 || !insn->target_states_.empty()) {
+    for (IRegister *reg : insn->outputs_) {
+      Join(reg, Range());
+    }
+    return;
+  }
+  Join(insn->outputs_[0], Evaluate(st, insn));
+}
+
+void ValueRange::Join(IRegister *reg, const Range &r) {
+  auto it = ranges_.find(reg);
+  if (it == ranges_.end()) {
+    return;
+  }
+  Range &cur = it->second;
+  Range u = Union(cur, Truncate(r, reg->value_type_));
+  if (u.lo == cur.lo && u.hi == cur.hi) {
+    return;
+  }
+  if (++num_updates_[reg] > kWidenLimit) {
+    u.lo = 0;
+    u.hi = Mask(Bits(u.hi));
+  }
+  cur = u;
+  changed_ = true;
+}
+
+ValueRange::Range ValueRange::ReadRange(IState *st, IRegister *reg) {
+  Range r = GetRange(reg);
+  if (!r.known || reg->IsStateLocal()) {
+    return r;
+  }
+  auto it = guards_.find(st);
+  if (it == guards_.end()) {
+    return r;
+  }
+  auto jt = it->second.find(reg);
+  if (jt == it->second.end()) {
+    return r;
+  }
+  const Range &g = jt->second;
+  r.lo = std::max(r.lo, g.lo);
+  r.hi = std::min(r.hi, g.hi);
+  if (r.lo > r.hi) {
+    // Not reachable.
+    r.lo = r.hi;
+  }
+  return r;
+}
+
+ValueRange::Range ValueRange::Evaluate(IState *st, IInsn *insn) {
+  IResource *res = insn->GetResource();
+  IResourceClass *rc = res->GetClass();
+  const string &name = rc->GetName();
+  vector<Range> in;
+  for (IRegister *reg : insn->inputs_) {
+    in.push_back(ReadRange(st, reg));
+  }
+  if (resource::IsSet(*rc)) {
+    if (in.size() != 1) {
+      return Range();
+    }
+    return in[0];
+  }
+  if (name == resource::kPhi) {
+    if (in.empty()) {
+      return Range();
+    }
+    Range r = in[0];
+    for (const Range &i : in) {
+      r = Union(r, i);
+    }
+    return r;
+  }
+  if (resource::IsSelect(*rc)) {
+    if (in.size() != 3) {
+      return Range();
+    }
+    // inputs: cond, false value, true value.
+    if (in[0].known && in[0].lo > 0) {
+      return in[2];
+    }
+    if (in[0].known && in[0].hi == 0) {
+      return in[1];
+    }
+    return Union(in[1], in[2]);
+  }
+  if (resource::IsExclusiveBinOp(*rc)) {
+    if (in.size() != 2 || res->input_types_.size() != 2 ||
+	res->output_types_.size() != 1) {
+      return Range();
+    }
+    return EvaluateExclusiveBinOp(name,
+				  Truncate(in[0], res->input_types_[0]),
+				  Truncate(in[1], res->input_types_[1]),
+				  res);
+  }
+  if (resource::IsLightBinOp(*rc)) {
+    if (in.size() != 2 || !in[0].known || !in[1].known) {
+      return Range();
+    }
+    const Range &a = in[0];
+    const Range &b = in[1];
+    if (name == resource::kBitAnd) {
+      return Range(0, std::min(a.hi, b.hi));
+    }
+    uint64_t hi = Mask(Bits(a.hi | b.hi));
+    if (name == resource::kBitOr) {
+      return Range(std::max(a.lo, b.lo), hi);
+    }
+    return Range(0, hi);
+  }
+  if (resource::IsBitShiftOp(*rc)) {
+    if (in.size() != 2) {
+      return Range();
+    }
+    return EvaluateShift(insn, in[0]);
+  }
+  if (resource::IsBitSel(*rc)) {
+    if (in.size() != 3) {
+      return Range();
+    }
+    return EvaluateBitSel(insn, in[0]);
+  }
+  if (resource::IsBitConcat(*rc)) {
+    return EvaluateBitConcat(insn, in);
+  }
+  // bit-inv and others can be any value of the output.
+  return Range();
+}
+
+ValueRange::Range ValueRange::EvaluateExclusiveBinOp(const string &name,
+						     const Range &a,
+						     const Range &b,
+						     IResource *res) {
+  const IValueType &out = res->output_types_[0];
+  if (name == resource::kGt || name == resource::kGte ||
+      name == resource::kEq) {
+    return Range(0, 1);
+  }
+  if (!a.known || !b.known) {
+    return FullRange(out);
+  }
+  Range r;
+  if (name == resource::kAdd) {
+    uint64_t hi = a.hi + b.hi;
+    if (hi < a.hi) {
+      return FullRange(out);
+    }
+    r = Range(a.lo + b.lo, hi);
+  } else if (name == resource::kSub) {
+    if (a.lo < b.hi) {
+      // May wrap around.
+      return FullRange(out);
+    }
+    r = Range(a.lo - b.hi, a.hi - b.lo);
+  } else if (name == resource::kMul) {
+    if (a.hi != 0 && b.hi > ~0ULL / a.hi) {
+      return FullRange(out);
+    }
+    r = Range(a.lo * b.lo, a.hi * b.hi);
+  } else {
+    return FullRange(out);
+  }
+  return Truncate(r, out);
+}
+
+// Same as
+//  assign insn_o = x << amount;
+// The expression has the width of the output at least.
+ValueRange::Range ValueRange::EvaluateShift(IInsn *insn, const Range &a) {
+  IRegister *amount_reg = insn->inputs_[1];
+  if (!a.known || !amount_reg->IsConst() ||
+      amount_reg->value_type_.IsWide()) {
+    return Range();
+  }
+  uint64_t amount = amount_reg->GetInitialValue().GetValue0();
+  if (amount >= 64) {
+    return Range(0, 0);
+  }
+  if (insn->GetOperand() != operand::kLeft) {
+    return Range(a.lo >> amount, a.hi >> amount);
+  }
+  if (a.hi > (~0ULL >> amount)) {
+    return Range();
+  }
+  return Range(a.lo << amount, a.hi << amount);
+}
+
+ValueRange::Range ValueRange::EvaluateBitSel(IInsn *insn, const Range &a) {
+  IRegister *msb_reg = insn->inputs_[1];
+  IRegister *lsb_reg = insn->inputs_[2];
+  if (!msb_reg->IsConst() || !lsb_reg->IsConst() ||
+      msb_reg->value_type_.IsWide() || lsb_reg->value_type_.IsWide()) {
+    return Range();
+  }
+  uint64_t msb = msb_reg->GetInitialValue().GetValue0();
+  uint64_t lsb = lsb_reg->GetInitialValue().GetValue0();
+  if (msb < lsb || msb >= 64) {
+    return Range();
+  }
+  uint64_t m = Mask(msb - lsb + 1);
+  if (!a.known) {
+    return Range(0, m);
+  }
+  if ((a.hi >> lsb) > m) {
+    return Range(0, m);
+  }
+  return Range(a.lo >> lsb, a.hi >> lsb);
+}
+
+ValueRange::Range ValueRange::EvaluateBitConcat(IInsn *insn,
+						const vector<Range> &in) {
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+  int width = 0;
+  for (int i = 0; i < in.size(); ++i) {
+    int w = std::max(insn->inputs_[i]->value_type_.GetWidth(), 1);
+    width += w;
+    if (!in[i].known || width > 64) {
+      return Range();
+    }
+    if (w < 64) {
+      lo <<= w;
+      hi <<= w;
+    }
+    lo |= in[i].lo;
+    hi |= in[i].hi;
+  }
+  return Range(lo, hi);
+}
+
+ValueRange::Range ValueRange::Truncate(const Range &r,
+				       const IValueType &type) {
+  if (!IsTracked(type)) {
+    return Range();
+  }
+  if (!r.known || r.hi > Mask(type.GetWidth())) {
+    return FullRange(type);
+  }
+  return r;
+}
+
+ValueRange::Range ValueRange::Union(const Range &a, const Range &b) {
+  if (!a.known || !b.known) {
+    return Range();
+  }
+  return Range(std::min(a.lo, b.lo), std::max(a.hi, b.hi));
+}
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
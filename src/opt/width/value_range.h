@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//
+// Value range analysis of unsigned registers up to 64 bits.
+//
+// Each register gets a [lo, hi] range covering its initial value and the
+// values of all its defs, iterated to a fixpoint (ranges growing in loops
+// are widened to the next power of two). Reads are narrowed by branches
+// comparing the register with a constant, so a loop counter checked
+// against a limit gets a bounded range. Works on SSA and non SSA tables.
+//
+#ifndef _opt_width_value_range_h_
+#define _opt_width_value_range_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace width {
+
+class ValueRange {
+public:
+  struct Range {
+    Range() : known(false), lo(0), hi(0) {}
+    Range(uint64_t l, uint64_t h) : known(true), lo(l), hi(h) {}
+
+    // false if any value of the type is possible and the type isn't
+    // tracked (signed or wider than 64 bits).
+    bool known;
+    uint64_t lo;
+    uint64_t hi;
+  };
+
+  ValueRange(ITable *table, AnalysisManager *analysis);
+
+  void Perform();
+
+  Range GetRange(IRegister *reg);
+  // Value of the input as read by the insn.
+  Range GetInputRange(IInsn *insn, int index);
+  // Result of the insn before it is stored to the output register.
+  // Exclusive binops truncate the result to the output port type.
+  Range GetResultRange(IInsn *insn);
+
+  static bool IsTracked(const IValueType &type);
+  static Range FullRange(const IValueType &type);
+  static uint64_t Mask(int width);
+  // Number of bits to represent the value. At least 1.
+  static int Bits(uint64_t value);
+
+private:
+  void InitRanges();
+  void CollectGuards();
+  void CollectGuard(IState *branch_st, IInsn *tr,
+		    map<IState *, set<IState *> > &targets,
+		    map<IState *, set<IState *> > &preds);
+  bool GetGuardRange(IInsn *compare, bool taken, IRegister **reg,
+		     Range *range);
+  void AddGuard(IState *st, IRegister *reg, const Range &r);
+  void Update(IState *st, IInsn *insn);
+  void Join(IRegister *reg, const Range &r);
+  Range ReadRange(IState *st, IRegister *reg);
+  Range Evaluate(IState *st, IInsn *insn);
+  Range EvaluateExclusiveBinOp(const string &name, const Range &a,
+			       const Range &b, IResource *res);
+  Range EvaluateShift(IInsn *insn, const Range &a);
+  Range EvaluateBitSel(IInsn *insn, const Range &a);
+  Range EvaluateBitConcat(IInsn *insn, const vector<Range> &in);
+  static Range Truncate(const Range &r, const IValueType &type);
+  static Range Union(const Range &a, const Range &b);
+
+  ITable *table_;
+  AnalysisManager *analysis_;
+  DefUseIndex *index_;
+  BBSet *bset_;
+  DominatorTree *dom_tree_;
+  map<IRegister *, Range> ranges_;
+  // Number of times each range grew, to widen it.
+  map<IRegister *, int> num_updates_;
+  // Ranges of registers known at the beginning of each state.
+  map<IState *, map<IRegister *, Range> > guards_;
+  bool changed_;
+};
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_width_value_range_h_
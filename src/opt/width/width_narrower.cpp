@@ -0,0 +1,205 @@
+#include "opt/width/width_narrower.h"
+
+#include "design/def_use_index.h"
+#include "design/design_tool.h"
+#include "iroha/i_design.h"
+#include "iroha/resource_class.h"
+#include "numeric/numeric.h"
+#include "opt/debug_annotation.h"
+#include "opt/width/value_range.h"
+
+#include <algorithm>
+
+namespace iroha {
+namespace opt {
+namespace width {
+
+WidthNarrower::WidthNarrower(ITable *table, AnalysisManager *analysis,
+			     DebugAnnotation *annotation)
+  : table_(table), analysis_(analysis), annotation_(annotation),
+    index_(nullptr), assign_(nullptr),
+    range_(new ValueRange(table, analysis)),
+    num_regs_(0), num_resources_(0) {
+}
+
+WidthNarrower::~WidthNarrower() {
+}
+
+void WidthNarrower::Perform() {
+  if (table_->GetInitialState() == nullptr) {
+    return;
+  }
+  range_->Perform();
+  index_ = DefUseIndex::GetOrCreate(table_);
+  // Ports are computed from the ranges before registers are modified.
+  NarrowResources();
+  NarrowRegisters();
+  if (annotation_->IsEnabled() && (num_regs_ > 0 || num_resources_ > 0)) {
+    annotation_->Table(table_) << "Narrowed " << num_regs_
+			       << " registers and " << num_resources_
+			       << " resources\n";
+  }
+}
+
+void WidthNarrower::NarrowResources() {
+  for (IResource *res : table_->resources_) {
+    if (resource::IsExclusiveBinOp(*res->GetClass()) &&
+	NarrowResource(res)) {
+      ++num_resources_;
+    }
+  }
+}
+
+// Each port gets the width of the widest value over the insns using the
+// resource, but never grows since inputs are truncated to the port.
+bool WidthNarrower::NarrowResource(IResource *res) {
+  if (res->input_types_.size() != 2 || res->output_types_.size() != 1) {
+    return false;
+  }
+  for (IValueType &t : res->input_types_) {
+    if (!ValueRange::IsTracked(t)) {
+      return false;
+    }
+  }
+  IValueType &out = res->output_types_[0];
+  if (!ValueRange::IsTracked(out)) {
+    return false;
+  }
+  const vector<IInsn *> &insns = index_->GetInsnsByResource(res);
+  if (insns.empty()) {
+    return false;
+  }
+  bool num_out = resource::IsNumToNumExclusiveBinOp(*res->GetClass());
+  vector<int> widths(2, 0);
+  int out_width = 0;
+  for (IInsn *insn : insns) {
+    if (insn->inputs_.size() != 2 || insn->outputs_.size() != 1) {
+      return false;
+    }
+    for (int i = 0; i < 2; ++i) {
+      int w = res->input_types_[i].GetWidth();
+      ValueRange::Range r = range_->GetInputRange(insn, i);
+      if (r.known) {
+	w = std::min(w, ValueRange::Bits(r.hi));
+      }
+      widths[i] = std::max(widths[i], w);
+    }
+    if (num_out) {
+      int w = out.GetWidth();
+      ValueRange::Range r = range_->GetResultRange(insn);
+      if (r.known) {
+	w = std::min(w, ValueRange::Bits(r.hi));
+      }
+      out_width = std::max(out_width, w);
+    }
+  }
+  bool narrowed = false;
+  for (int i = 0; i < 2; ++i) {
+    IValueType &t = res->input_types_[i];
+    if (widths[i] < t.GetWidth()) {
+      t.SetWidth(widths[i]);
+      narrowed = true;
+    }
+  }
+  if (num_out && out_width < out.GetWidth()) {
+    out.SetWidth(out_width);
+    narrowed = true;
+  }
+  return narrowed;
+}
+
+void WidthNarrower::NarrowRegisters() {
+  // Copies the list, since extended wires are added.
+  vector<IRegister *> regs = table_->registers_;
+  for (IRegister *reg : regs) {
+    if (reg->IsConst() || !ValueRange::IsTracked(reg->value_type_) ||
+	index_->GetDefs(reg).empty()) {
+      continue;
+    }
+    ValueRange::Range r = range_->GetRange(reg);
+    if (!r.known) {
+      continue;
+    }
+    int width = ValueRange::Bits(r.hi);
+    if (width < reg->value_type_.GetWidth()) {
+      NarrowRegister(reg, width);
+      ++num_regs_;
+    }
+  }
+}
+
+void WidthNarrower::NarrowRegister(IRegister *reg, int width) {
+  // Copies the uses, since replacing inputs modifies them.
+  vector<IInsn *> uses = index_->GetUses(reg);
+  for (IInsn *insn : uses) {
+    if (!IsWidthSensitiveUse(insn, reg, width)) {
+      continue;
+    }
+    IRegister *wire = GetExtendedWire(index_->GetState(insn), insn, reg);
+    for (int i = 0; i < insn->inputs_.size(); ++i) {
+      if (insn->inputs_[i] == reg) {
+	insn->inputs_[i] = wire;
+      }
+    }
+    index_->UpdateInsn(insn);
+  }
+  reg->value_type_.SetWidth(width);
+  if (reg->HasInitialValue()) {
+    Numeric v = reg->GetInitialValue();
+    v.type_.SetWidth(width);
+    reg->SetInitialValue(v);
+  }
+}
+
+// Zero extension to a wider operand doesn't change the result of these.
+bool WidthNarrower::IsWidthSensitiveUse(IInsn *insn, IRegister *reg,
+					int width) {
+  IResourceClass *rc = insn->GetResource()->GetClass();
+  if (resource::IsSet(*rc) || resource::IsSelect(*rc) ||
+      rc->GetName() == resource::kPhi || resource::IsTransition(*rc) ||
+      resource::IsExclusiveBinOp(*rc) || resource::IsLightBinOp(*rc) ||
+      resource::IsLightUniOp(*rc) || resource::IsBitShiftOp(*rc)) {
+    return false;
+  }
+  if (resource::IsBitSel(*rc) && insn->inputs_.size() == 3 &&
+      insn->inputs_[0] == reg && insn->inputs_[1]->IsConst() &&
+      !insn->inputs_[1]->value_type_.IsWide() &&
+      insn->inputs_[1]->GetInitialValue().GetValue0() < width) {
+    return false;
+  }
+  // e.g. bit-concat, ports of other resources.
+  return true;
+}
+
+// Before:
+//  S1: Rx <(bit-concat)- Ra, Rb
+// After:
+//  S1: Wa <(assign)- Ra
+//      Rx <(bit-concat)- Wa, Rb
+IRegister *WidthNarrower::GetExtendedWire(IState *st, IInsn *insn,
+					  IRegister *reg) {
+  auto key = make_pair(st, reg);
+  auto it = ext_wires_.find(key);
+  if (it != ext_wires_.end()) {
+    return it->second;
+  }
+  if (assign_ == nullptr) {
+    assign_ = DesignTool::GetOneResource(table_, resource::kSet);
+  }
+  IRegister *wire = DesignTool::AllocRegister(table_,
+					      reg->GetName() + "_ext", 0);
+  wire->value_type_ = reg->value_type_;
+  wire->SetStateLocal(true);
+  IInsn *assign = new IInsn(assign_);
+  assign->inputs_.push_back(reg);
+  assign->outputs_.push_back(wire);
+  auto pos = std::find(st->insns_.begin(), st->insns_.end(), insn);
+  st->insns_.insert(pos, assign);
+  index_->AddInsn(st, assign);
+  ext_wires_[key] = wire;
+  return wire;
+}
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
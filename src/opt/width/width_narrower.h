@@ -0,0 +1,52 @@
+// -*- C++ -*-
+//
+// Narrows registers and ports of exclusive binops to the widths required
+// by the value ranges. Uses depending on the width of a narrowed register
+// (e.g. bit-concat) read a wire extended to the original width.
+//
+#ifndef _opt_width_width_narrower_h_
+#define _opt_width_width_narrower_h_
+
+#include "opt/common.h"
+
+namespace iroha {
+class DefUseIndex;
+
+namespace opt {
+namespace width {
+
+class ValueRange;
+
+class WidthNarrower {
+public:
+  WidthNarrower(ITable *table, AnalysisManager *analysis,
+		DebugAnnotation *annotation);
+  ~WidthNarrower();
+
+  void Perform();
+
+private:
+  void NarrowResources();
+  bool NarrowResource(IResource *res);
+  void NarrowRegisters();
+  void NarrowRegister(IRegister *reg, int width);
+  bool IsWidthSensitiveUse(IInsn *insn, IRegister *reg, int width);
+  IRegister *GetExtendedWire(IState *st, IInsn *insn, IRegister *reg);
+
+  ITable *table_;
+  AnalysisManager *analysis_;
+  DebugAnnotation *annotation_;
+  DefUseIndex *index_;
+  IResource *assign_;
+  std::unique_ptr<ValueRange> range_;
+  // Extended wire of each register in each state.
+  map<pair<IState *, IRegister *>, IRegister *> ext_wires_;
+  int num_regs_;
+  int num_resources_;
+};
+
+}  // namespace width
+}  // namespace opt
+}  // namespace iroha
+
+#endif  // _opt_width_width_narrower_h_
@@ -53,12 +53,18 @@ PlatformDB::PlatformDB(IPlatform *platform) : platform_(platform) {
 }
 
 int PlatformDB::GetResourceDelay(IResource *res) {
-  const string &klass = res->GetClass()->GetName();
-  LookupCondition cond;
-  cond.klass = klass;
+  vector<int> widths;
   for (auto &ivt : res->input_types_) {
-    cond.inputs_.push_back(ivt.GetWidth());
+    widths.push_back(ivt.GetWidth());
   }
+  return GetDelay(res->GetClass()->GetName(), widths);
+}
+
+int PlatformDB::GetDelay(const string &klass,
+			 const vector<int> &input_widths) {
+  LookupCondition cond;
+  cond.klass = klass;
+  cond.inputs_ = input_widths;
   DefNode *value = FindValue(cond);
   return GetInt(value, "DELAY", 0);
 }
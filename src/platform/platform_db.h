@@ -36,6 +36,9 @@ public:
   PlatformDB(IPlatform *platform);
 
   int GetResourceDelay(IResource *res);
+  // Delay of a resource of the class and input widths, which may not
+  // exist yet.
+  int GetDelay(const string &klass, const vector<int> &input_widths);
 
 private:
   DefNode *FindValue(const LookupCondition &lookup_cond);
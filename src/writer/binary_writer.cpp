@@ -0,0 +1,333 @@
+#include "writer/binary_writer.h"
+
+#include "iroha/binary_format.h"
+#include "iroha/i_design.h"
+#include "iroha/i_platform.h"
+#include "iroha/logging.h"
+#include "iroha/resource_class.h"
+#include "iroha/resource_params.h"
+#include "numeric/numeric.h"
+
+namespace iroha {
+namespace writer {
+
+// Objects outside of the table can't be encoded as indexes.
+template<class T>
+static int GetIndex(const map<const T *, int> &index, const T *obj,
+		    const char *what) {
+  auto it = index.find(obj);
+  CHECK(it != index.end()) << what << " isn't in the table";
+  return it->second;
+}
+
+BinaryWriter::BinaryWriter(const IDesign *design, ostream &os)
+  : design_(design), os_(os) {
+}
+
+void BinaryWriter::Write() {
+  buf_.append(binary::kMagic, binary::kMagicLength);
+  WriteUInt(binary::kVersion);
+  WriteResourceParams(design_->GetParams());
+  WriteUInt(design_->platforms_.size());
+  for (auto *platform : design_->platforms_) {
+    WritePlatform(*platform);
+  }
+  WriteUInt(design_->array_images_.size());
+  for (auto *im : design_->array_images_) {
+    WriteArrayImage(*im);
+  }
+  WriteUInt(design_->modules_.size());
+  for (auto *mod : design_->modules_) {
+    WriteModule(*mod);
+  }
+  os_.write(buf_.data(), buf_.size());
+}
+
+void BinaryWriter::WriteModule(const IModule &mod) {
+  WriteInt(mod.GetId());
+  WriteStr(mod.GetName());
+  IModule *parent = mod.GetParentModule();
+  if (parent != nullptr) {
+    WriteUInt(1);
+    WriteInt(parent->GetId());
+  } else {
+    WriteUInt(0);
+  }
+  WriteResourceParams(mod.GetParams());
+  WriteUInt(mod.tables_.size());
+  for (auto *tab : mod.tables_) {
+    WriteTable(*tab);
+  }
+}
+
+void BinaryWriter::WriteTable(const ITable &tab) {
+  reg_index_.clear();
+  res_index_.clear();
+  state_index_.clear();
+  insn_index_.clear();
+  int idx = 0;
+  for (auto *reg : tab.registers_) {
+    reg_index_[reg] = idx++;
+  }
+  idx = 0;
+  for (auto *res : tab.resources_) {
+    res_index_[res] = idx++;
+  }
+  idx = 0;
+  int insn_idx = 0;
+  for (auto *st : tab.states_) {
+    state_index_[st] = idx++;
+    for (auto *insn : st->insns_) {
+      insn_index_[insn] = insn_idx++;
+    }
+  }
+
+  WriteInt(tab.GetId());
+  WriteStr(tab.GetName());
+  WriteUInt(tab.registers_.size());
+  for (auto *reg : tab.registers_) {
+    WriteRegister(*reg);
+  }
+  WriteUInt(tab.resources_.size());
+  for (auto *res : tab.resources_) {
+    WriteResource(*res);
+  }
+  // Number of states and insns comes first to allow forward references.
+  WriteUInt(tab.states_.size());
+  WriteUInt(insn_index_.size());
+  IState *initial = tab.GetInitialState();
+  if (initial != nullptr) {
+    WriteUInt(GetIndex(state_index_, initial, "initial state") + 1);
+  } else {
+    WriteUInt(0);
+  }
+  for (auto *st : tab.states_) {
+    WriteState(*st);
+  }
+}
+
+void BinaryWriter::WriteRegister(const IRegister &reg) {
+  WriteInt(reg.GetId());
+  WriteStr(reg.GetName());
+  if (reg.IsConst()) {
+    WriteUInt(binary::REG_CONST);
+  } else if (reg.IsStateLocal()) {
+    WriteUInt(binary::REG_WIRE);
+  } else {
+    WriteUInt(binary::REG_NORMAL);
+  }
+  WriteValueType(reg.value_type_);
+  if (reg.HasInitialValue()) {
+    WriteUInt(1);
+    WriteValue(reg.value_type_, reg.GetInitialValue());
+  } else {
+    WriteUInt(0);
+  }
+  ResourceParams *params = const_cast<IRegister &>(reg).GetParams(false);
+  WriteUInt(params != nullptr);
+  if (params != nullptr) {
+    WriteResourceParams(params);
+  }
+}
+
+void BinaryWriter::WriteResource(const IResource &res) {
+  const IResourceClass &rc = *(res.GetClass());
+  WriteInt(res.GetId());
+  WriteStr(rc.GetName());
+  WriteValueTypes(res.input_types_);
+  WriteValueTypes(res.output_types_);
+  WriteResourceParams(res.GetParams());
+  int flags = 0;
+  const IArray *array = res.GetArray();
+  if (array != nullptr) {
+    flags |= binary::RES_ARRAY;
+    if (array->GetArrayImage() != nullptr) {
+      flags |= binary::RES_ARRAY_IMAGE;
+    }
+  }
+  if (resource::IsTaskCall(rc)) {
+    flags |= binary::RES_CALLEE_TABLE;
+  }
+  if (res.GetParentResource() != nullptr) {
+    flags |= binary::RES_PARENT_RESOURCE;
+  }
+  WriteUInt(flags);
+  if (flags & binary::RES_ARRAY) {
+    WriteUInt(array->GetAddressWidth());
+    WriteValueType(array->GetDataType());
+    WriteUInt(array->IsExternal());
+    WriteUInt(array->IsRam());
+    if (flags & binary::RES_ARRAY_IMAGE) {
+      WriteInt(array->GetArrayImage()->GetId());
+    }
+  }
+  if (flags & binary::RES_CALLEE_TABLE) {
+    const ITable *table = res.GetCalleeTable();
+    CHECK(table) << "callee table isn't specified";
+    WriteInt(table->GetModule()->GetId());
+    WriteInt(table->GetId());
+  }
+  if (flags & binary::RES_PARENT_RESOURCE) {
+    const IResource *source = res.GetParentResource();
+    const ITable *table = source->GetTable();
+    WriteInt(table->GetModule()->GetId());
+    WriteInt(table->GetId());
+    WriteInt(source->GetId());
+  }
+}
+
+void BinaryWriter::WriteState(const IState &st) {
+  WriteInt(st.GetId());
+  const IProfile &profile = st.GetProfile();
+  WriteUInt(profile.valid_);
+  if (profile.valid_) {
+    WriteInt(profile.raw_count_);
+    WriteInt(profile.normalized_count_);
+  }
+  WriteUInt(st.insns_.size());
+  for (auto *insn : st.insns_) {
+    WriteInsn(*insn);
+  }
+}
+
+void BinaryWriter::WriteInsn(const IInsn &insn) {
+  WriteInt(insn.GetId());
+  auto rit = res_index_.find(insn.GetResource());
+  CHECK(rit != res_index_.end()) << "insn uses a resource in other table";
+  WriteUInt(rit->second);
+  WriteStr(insn.GetOperand());
+  WriteUInt(insn.target_states_.size());
+  for (IState *st : insn.target_states_) {
+    WriteUInt(GetIndex(state_index_, st, "state"));
+  }
+  WriteUInt(insn.inputs_.size());
+  for (IRegister *reg : insn.inputs_) {
+    WriteUInt(GetIndex(reg_index_, reg, "register"));
+  }
+  WriteUInt(insn.outputs_.size());
+  for (IRegister *reg : insn.outputs_) {
+    WriteUInt(GetIndex(reg_index_, reg, "register"));
+  }
+  WriteUInt(insn.depending_insns_.size());
+  for (IInsn *dep : insn.depending_insns_) {
+    WriteUInt(GetIndex(insn_index_, dep, "insn"));
+  }
+}
+
+void BinaryWriter::WriteValueType(const IValueType &type) {
+  // LSB is the signedness.
+  WriteUInt((type.GetWidth() << 1) | (type.IsSigned() ? 1 : 0));
+}
+
+void BinaryWriter::WriteValueTypes(const vector<IValueType> &types) {
+  WriteUInt(types.size());
+  for (auto &type : types) {
+    WriteValueType(type);
+  }
+}
+
+void BinaryWriter::WriteValue(const IValueType &type, const Numeric &value) {
+  // Raw limbs in little endian.
+  const uint64_t *limbs = Numeric::GetLimbs(value.type_, value.GetArray());
+  int count = type.GetValueCount();
+  int max_count = Numeric::GetLimbCount(value.type_);
+  if (count > max_count) {
+    count = max_count;
+  }
+  WriteUInt(count);
+  for (int i = 0; i < count; ++i) {
+    uint64_t v = limbs[i];
+    char b[8];
+    for (int j = 0; j < 8; ++j) {
+      b[j] = (v >> (j * 8)) & 0xff;
+    }
+    buf_.append(b, 8);
+  }
+}
+
+void BinaryWriter::WriteResourceParams(const ResourceParams *params) {
+  vector<string> keys = params->GetParamKeys();
+  WriteUInt(keys.size());
+  for (string &key : keys) {
+    WriteStr(key);
+    vector<string> values = params->GetValues(key);
+    WriteUInt(values.size());
+    for (string &value : values) {
+      WriteStr(value);
+    }
+  }
+}
+
+void BinaryWriter::WriteArrayImage(const IArrayImage &im) {
+  WriteInt(im.GetId());
+  WriteStr(im.GetName());
+  WriteUInt(im.values_.size());
+  for (uint64_t v : im.values_) {
+    WriteUInt(v);
+  }
+}
+
+void BinaryWriter::WritePlatform(const IPlatform &platform) {
+  WriteStr(platform.GetName());
+  WriteUInt(platform.defs_.size());
+  for (auto *def : platform.defs_) {
+    WriteNode(def->condition_);
+    WriteNode(def->value_);
+  }
+}
+
+void BinaryWriter::WriteNode(const platform::DefNode *node) {
+  // 0: null, 1: atom, 2: list
+  if (node == nullptr) {
+    WriteUInt(0);
+    return;
+  }
+  if (node->is_atom_) {
+    WriteUInt(1);
+    WriteStr(node->str_);
+    if (node->str_.empty()) {
+      WriteInt(node->num_);
+    }
+    return;
+  }
+  WriteUInt(2);
+  WriteUInt(node->nodes_.size());
+  for (auto *child : node->nodes_) {
+    WriteNode(child);
+  }
+}
+
+void BinaryWriter::WriteUInt(uint64_t u) {
+  char b[10];
+  int len = 0;
+  do {
+    char c = u & 0x7f;
+    u >>= 7;
+    if (u) {
+      c |= 0x80;
+    }
+    b[len++] = c;
+  } while (u);
+  buf_.append(b, len);
+}
+
+void BinaryWriter::WriteInt(int64_t i) {
+  // zigzag
+  WriteUInt((((uint64_t)i) << 1) ^ (uint64_t)(i >> 63));
+}
+
+void BinaryWriter::WriteStr(const string &str) {
+  auto it = strings_.find(str);
+  if (it != strings_.end()) {
+    WriteUInt(it->second);
+    return;
+  }
+  int idx = strings_.size();
+  strings_[str] = idx;
+  WriteUInt(idx);
+  WriteUInt(str.size());
+  buf_.append(str);
+}
+
+}  // namespace writer
+}  // namespace iroha
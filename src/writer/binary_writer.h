@@ -0,0 +1,53 @@
+// -*- C++ -*-
+//
+// Writes IDesign in the binary format (see iroha/binary_format.h).
+//
+#ifndef _writer_binary_writer_h_
+#define _writer_binary_writer_h_
+
+#include "iroha/common.h"
+
+#include <map>
+
+namespace iroha {
+namespace writer {
+
+class BinaryWriter {
+public:
+  BinaryWriter(const IDesign *design, ostream &os);
+
+  void Write();
+
+private:
+  void WriteModule(const IModule &mod);
+  void WriteTable(const ITable &tab);
+  void WriteRegister(const IRegister &reg);
+  void WriteResource(const IResource &res);
+  void WriteState(const IState &st);
+  void WriteInsn(const IInsn &insn);
+  void WriteValueType(const IValueType &type);
+  void WriteValueTypes(const vector<IValueType> &types);
+  void WriteValue(const IValueType &type, const Numeric &value);
+  void WriteResourceParams(const ResourceParams *params);
+  void WriteArrayImage(const IArrayImage &im);
+  void WritePlatform(const IPlatform &platform);
+  void WriteNode(const platform::DefNode *node);
+  void WriteUInt(uint64_t u);
+  void WriteInt(int64_t i);
+  void WriteStr(const string &str);
+
+  const IDesign *design_;
+  ostream &os_;
+  string buf_;
+  map<string, int> strings_;
+  // Indexes of objects in the current table.
+  map<const IRegister *, int> reg_index_;
+  map<const IResource *, int> res_index_;
+  map<const IState *, int> state_index_;
+  map<const IInsn *, int> insn_index_;
+};
+
+}  // namespace writer
+}  // namespace iroha
+
+#endif  // _writer_binary_writer_h_
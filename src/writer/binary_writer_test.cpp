@@ -0,0 +1,163 @@
+// Round trip tests of the binary format against the text format.
+//
+// binary_writer_test [.iroha files]...
+#include "builder/design_builder.h"
+#include "builder/reader.h"
+#include "iroha/i_design.h"
+#include "iroha/test_util.h"
+#include "writer/binary_writer.h"
+#include "writer/exp_writer.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace iroha;
+using namespace std;
+
+namespace {
+
+const char kDesign[] =
+  "(PARAMS (RESET-POLARITY true) (X \"a b\"))\n"
+  "(PLATFORM generic\n"
+  " (DEF (COND (AND (CLASS add) (< (INPUT 0) 16))) (VALUE (DELAY 2000)))\n"
+  " (DEF (COND) (VALUE (DELAY 1))))\n"
+  "(ARRAY-IMAGE 1 img (1 2 3 18446744073709551615))\n"
+  "(MODULE 1 top\n"
+  " (PARAMS)\n"
+  " (TABLE 1 ()\n"
+  "  (REGISTERS\n"
+  "   (REGISTER 1 c REG (UINT 32) 0)\n"
+  "   (REGISTER 2 () CONST (UINT 32) 10)\n"
+  "   (REGISTER 3 cond WIRE (UINT 0) ())\n"
+  "   (REGISTER 4 s REG (INT 16) () (PARAMS (LOOP-UNROLL 2))))\n"
+  "  (RESOURCES\n"
+  "   (RESOURCE 1 gt ((UINT 32) (UINT 32)) ((UINT 0)) (PARAMS))\n"
+  "   (RESOURCE 2 tr () () (PARAMS))\n"
+  "   (RESOURCE 3 add ((UINT 32) (UINT 32)) ((UINT 32)) (PARAMS))\n"
+  "   (RESOURCE 4 task-call () () (PARAMS) (CALLEE-TABLE 2 1))\n"
+  "   (RESOURCE 5 array () () (PARAMS)\n"
+  "    (ARRAY 2 (UINT 64) INTERNAL ROM 1))\n"
+  "   (RESOURCE 6 shared-reg () ((UINT 32)) (PARAMS)))\n"
+  "  (INITIAL 1)\n"
+  "  (STATE 1\n"
+  "   (PROFILE 100 7)\n"
+  "   (INSN 1 gt 1 () () (1 2) (3) ())\n"
+  "   (INSN 2 tr 2 () (2 4) (3) () (1)))\n"
+  "  (STATE 4\n"
+  "   (INSN 3 add 3 () () (1 2) (1) ())\n"
+  "   (INSN 4 task-call 4 () () () () ())\n"
+  "   (INSN 5 tr 2 () (1) () () (3)))\n"
+  "  (STATE 2)))\n"
+  "(MODULE 2 sub\n"
+  " (PARAMS)\n"
+  " (PARENT 1)\n"
+  " (TABLE 1 task\n"
+  "  (REGISTERS)\n"
+  "  (RESOURCES\n"
+  "   (RESOURCE 1 task () () (PARAMS))\n"
+  "   (RESOURCE 2 shared-reg-reader () ((UINT 32)) (PARAMS)\n"
+  "    (PARENT-RESOURCE 1 1 6)))\n"
+  "  (INITIAL 1)\n"
+  "  (STATE 1 (INSN 1 task 1 () () () () ()))))\n";
+
+IDesign *BuildFromText(const string &text) {
+  istringstream is(text);
+  builder::Reader reader(is);
+  unique_ptr<builder::File> f(reader.Read());
+  builder::DesignBuilder builder;
+  return builder.Build(f->exps);
+}
+
+IDesign *BuildFromBinary(const string &bin) {
+  builder::DesignBuilder builder;
+  return builder.BuildBinary(bin.data(), bin.size());
+}
+
+string WriteText(const IDesign *design) {
+  ostringstream os;
+  writer::ExpWriter writer(design, os);
+  writer.Write();
+  return os.str();
+}
+
+string WriteBinary(const IDesign *design) {
+  ostringstream os;
+  writer::BinaryWriter writer(design, os);
+  writer.Write();
+  return os.str();
+}
+
+void RoundTrip(const string &text) {
+  unique_ptr<IDesign> design(BuildFromText(text));
+  ASSERT(design.get() != nullptr);
+  string bin = WriteBinary(design.get());
+  unique_ptr<IDesign> design2(BuildFromBinary(bin));
+  ASSERT(design2.get() != nullptr);
+  ASSERT(WriteText(design.get()) == WriteText(design2.get()));
+  ASSERT(bin == WriteBinary(design2.get()));
+}
+
+}  // namespace
+
+void Basic() {
+  TEST_CASE("Basic");
+  RoundTrip(kDesign);
+}
+
+void WideValue() {
+  TEST_CASE("WideValue");
+  unique_ptr<IDesign> design(BuildFromText(kDesign));
+  IRegister *reg = design->modules_[0]->tables_[0]->registers_[1];
+  for (int w : {128, 600}) {
+    Numeric value;
+    value.type_.SetWidth(w);
+    Numeric::MayPopulateStorage(value.type_, nullptr,
+				value.GetMutableArray());
+    Numeric::Clear(value.type_, value.GetMutableArray());
+    uint64_t *limbs = Numeric::GetMutableLimbs(value.type_,
+					       value.GetMutableArray());
+    limbs[0] = 1;
+    limbs[1] = 0x123456789abcdefULL;
+    limbs[value.type_.GetValueCount() - 1] = 0x8000000000000000ULL;
+    reg->SetInitialValue(value);
+
+    unique_ptr<IDesign> design2(BuildFromBinary(WriteBinary(design.get())));
+    ASSERT(design2.get() != nullptr);
+    IRegister *reg2 = design2->modules_[0]->tables_[0]->registers_[1];
+    ASSERT_EQ(w, reg2->value_type_.GetWidth());
+    const Numeric &value2 = reg2->GetInitialValue();
+    ASSERT(value2.type_.IsExtraWide() == value.type_.IsExtraWide());
+    ASSERT(Numeric::Format(value.type_, value.GetArray()) ==
+	   Numeric::Format(value2.type_, value2.GetArray()));
+  }
+}
+
+void Truncated() {
+  TEST_CASE("Truncated");
+  unique_ptr<IDesign> design(BuildFromText(kDesign));
+  string bin = WriteBinary(design.get());
+  for (size_t len = 0; len < bin.size(); len += 7) {
+    unique_ptr<IDesign> design2(BuildFromBinary(bin.substr(0, len)));
+    ASSERT(design2.get() == nullptr);
+  }
+}
+
+void Files(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    TEST_CASE(argv[i]);
+    ifstream ifs(argv[i]);
+    ASSERT(!ifs.fail());
+    stringstream ss;
+    ss << ifs.rdbuf();
+    RoundTrip(ss.str());
+  }
+}
+
+int main(int argc, char **argv) {
+  Basic();
+  WideValue();
+  Truncated();
+  Files(argc, argv);
+
+  return 0;
+}
@@ -99,7 +99,7 @@ void ArrayResource::BuildInternalSRAM() {
 }
 
 void ArrayResource::BuildSRAMWrite() {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("sram_write", &callers);
   ostream &fs = tab_.StateOutputSectionStream();
   fs << "      " << SigName("wdata_en") << " <= ";
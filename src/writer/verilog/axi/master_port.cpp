@@ -46,7 +46,7 @@ void MasterPort::BuildResource() {
      << "      " << WenPort() << " <= 0;\n"
      << "      " << ReqPort() << " <= 0;\n";
 
-  map<IState *, IInsn *> accessors;
+  StateInsnMap accessors;
   CollectResourceCallers("*", &accessors);
   ostream &ss = tab_.StateOutputSectionStream();
   ss << "      " << ReqPort() << " <= ";
@@ -56,7 +56,7 @@ void MasterPort::BuildResource() {
     ss << "(" << JoinStatesWithSubState(accessors, 0) << ") && !"
        << AckPort() <<";\n";
   }
-  map<IState *, IInsn *> writers;
+  StateInsnMap writers;
   CollectResourceCallers("write", &writers);
   ss << "      " << WenPort() << " <= ";
   if (writers.size() == 0) {
@@ -4,7 +4,7 @@ namespace iroha {
 namespace writer {
 namespace verilog {
 
-bool DebugMarker::enabled_;
+thread_local bool DebugMarker::enabled_;
 
 string DebugMarker::Output(const char *fn, int ln, const char *msg) {
   if (!enabled_) {
@@ -17,7 +17,8 @@ public:
   static string Output(const char *fn, int ln, const char *msg);
 
 private:
-  static bool enabled_;
+  // Per thread, since writers for different designs may run concurrently.
+  static thread_local bool enabled_;
 };
 
 }  // namespace verilog
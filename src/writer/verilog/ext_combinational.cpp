@@ -32,7 +32,7 @@ void ExtCombinational::BuildResource() {
   }
   BuildEmbeddedModule(connection);
 
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("", &callers);
   if (callers.size() == 0) {
     return;
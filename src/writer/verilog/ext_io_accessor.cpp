@@ -25,7 +25,7 @@ void ExtIOAccessor::BuildResource() {
 }
 
 void ExtIOAccessor::BuildOutputResource() {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectOutputCallers(&callers);
   if (callers.size() == 0) {
     return;
@@ -48,8 +48,8 @@ void ExtIOAccessor::BuildOutputResource() {
   rvs << v << ";\n";
 }
 
-void ExtIOAccessor::CollectOutputCallers(map<IState *, IInsn *> *callers) {
-  map<IState *, IInsn *> all_callers;
+void ExtIOAccessor::CollectOutputCallers(StateInsnMap *callers) {
+  StateInsnMap all_callers;
   CollectResourceCallers("", &all_callers);
   for (auto it : all_callers) {
     IInsn *insn = it.second;
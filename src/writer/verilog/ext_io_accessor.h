@@ -22,7 +22,7 @@ public:
 
 private:
   void BuildOutputResource();
-  void CollectOutputCallers(map<IState *, IInsn *> *callers);
+  void CollectOutputCallers(StateInsnMap *callers);
   string GetName();
 
   static void OutputFeature(const IResource *accessor, bool *o, bool *p);
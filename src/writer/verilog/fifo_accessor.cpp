@@ -70,9 +70,9 @@ void FifoAccessor::BuildWriter() {
 
 void FifoAccessor::BuildReq(bool is_writer) {
   ostream &ss = tab_.StateOutputSectionStream();
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("", &callers);
-  map<IState *, IInsn *> nw_callers;
+  StateInsnMap nw_callers;
   CollectResourceCallers(operand::kNoWait, &nw_callers);
   string sig;
   string ack;
@@ -47,7 +47,7 @@ void Operator::BuildExclusiveBinOp() {
   ostream &rs = tab_.ResourceSectionStream();
   const string &res_name = res_.GetClass()->GetName();
   rs << "  // " << res_name << ":" << res_.GetId() << "\n";
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("", &callers);
   if (callers.size() == 0) {
     return;
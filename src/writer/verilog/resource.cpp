@@ -181,11 +181,20 @@ void Resource::BuildInsn(IInsn *insn, State *st) {
   }
 }
 
+bool StateIdLess::operator()(const IState *s1, const IState *s2) const {
+  int t1 = s1->GetTable()->GetId();
+  int t2 = s2->GetTable()->GetId();
+  if (t1 != t2) {
+    return t1 < t2;
+  }
+  return s1->GetId() < s2->GetId();
+}
+
 void Resource::CollectNames(Names *names) {
 }
 
 void Resource::CollectResourceCallers(const string &opr,
-				      map<IState *, IInsn *> *callers) const {
+				      StateInsnMap *callers) const {
   vector<string> v;
   Util::SplitStringUsing(opr, ",", &v);
   set<string> oprs;
@@ -206,7 +215,7 @@ void Resource::CollectResourceCallers(const string &opr,
 }
 
 void Resource::WriteInputSel(const string &name,
-			     const map<IState *, IInsn *> &callers,
+			     const StateInsnMap &callers,
 			     int nth,
 			     ostream &os) {
   WriteWire(name, res_.input_types_[nth], os);
@@ -241,7 +250,7 @@ void Resource::WriteWire(const string &name, const IValueType &type,
   os << name << ";\n";
 }
 
-void Resource::WriteStateUnion(const map<IState *, IInsn *> &callers,
+void Resource::WriteStateUnion(const StateInsnMap &callers,
 			       ostream &os) {
   if (callers.size() == 0) {
     os << "0";
@@ -256,7 +265,7 @@ void Resource::WriteStateUnion(const map<IState *, IInsn *> &callers,
   }
 }
 
-string Resource::JoinStates(const map<IState *, IInsn *> &sts) const {
+string Resource::JoinStates(const StateInsnMap &sts) const {
   vector<string> conds;
   for (auto &p : sts) {
     IState *st = p.first;
@@ -267,7 +276,7 @@ string Resource::JoinStates(const map<IState *, IInsn *> &sts) const {
   return Util::Join(conds, " || ");
 }
 
-string Resource::JoinStatesWithSubState(const map<IState *, IInsn *> &sts,
+string Resource::JoinStatesWithSubState(const StateInsnMap &sts,
 					int sub) const {
   vector<string> conds;
   for (auto &p : sts) {
@@ -282,7 +291,7 @@ string Resource::JoinStatesWithSubState(const map<IState *, IInsn *> &sts,
   return Util::Join(conds, " || ");
 }
 
-string Resource::SelectValueByStateWithCallers(const map<IState *, IInsn *> &callers,
+string Resource::SelectValueByStateWithCallers(const StateInsnMap &callers,
 					       const string &default_value) {
   string v = default_value;
   for (auto &c : callers) {
@@ -300,7 +309,7 @@ string Resource::SelectValueByStateWithCallers(const map<IState *, IInsn *> &cal
 }
 
 string Resource::SelectValueByState(const string &default_value) {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("", &callers);
   return SelectValueByStateWithCallers(callers, default_value);
 }
@@ -10,6 +10,13 @@ namespace iroha {
 namespace writer {
 namespace verilog {
 
+// Orders states by ids, so the output doesn't depend on heap addresses.
+struct StateIdLess {
+  bool operator()(const IState *s1, const IState *s2) const;
+};
+
+typedef map<IState *, IInsn *, StateIdLess> StateInsnMap;
+
 class Resource {
 public:
   Resource(const IResource &res, const Table &tab);
@@ -25,22 +32,22 @@ public:
   const Table &GetTable() const;
   const IResource &GetIResource() const;
 
-  string JoinStatesWithSubState(const map<IState *, IInsn *> &sts, int sub) const;
+  string JoinStatesWithSubState(const StateInsnMap &sts, int sub) const;
   void CollectResourceCallers(const string &opr,
-			      map<IState *, IInsn *> *callers) const;
+			      StateInsnMap *callers) const;
 
 protected:
   void WriteInputSel(const string &name,
-		     const map<IState *, IInsn *> &callers,
+		     const StateInsnMap &callers,
 		     int nth,
 		     ostream &os);
   void WriteWire(const string &name, const IValueType &type,
 		 ostream &os);
-  string JoinStates(const map<IState *, IInsn *> &sts) const;
-  void WriteStateUnion(const map<IState *, IInsn *> &callers,
+  string JoinStates(const StateInsnMap &sts) const;
+  void WriteStateUnion(const StateInsnMap &callers,
 		       ostream &os);
   string SelectValueByState(const string &default_value);
-  string SelectValueByStateWithCallers(const map<IState *, IInsn *> &callers,
+  string SelectValueByStateWithCallers(const StateInsnMap &callers,
 				       const string &default_value);
   void AddPortToTop(const string &port, bool is_output, bool from_embedded,
 		    int width);
@@ -81,7 +81,7 @@ void SharedMemoryAccessor::BuildMemoryAccessorResource(const Resource &accessor,
     tab.AddReg(SharedMemory::MemoryRdataBuf(*mem, &res), data_width);
   }
   ostream &ss = tab.StateOutputSectionStream();
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   accessor.CollectResourceCallers("", &callers);
   string ack = wire::Names::AccessorWire(rn, &res, "ack");
   if (gen_reg) {
@@ -98,7 +98,7 @@ void SharedMemoryAccessor::BuildMemoryAccessorResource(const Resource &accessor,
   if (resource::IsSharedMemory(*klass) ||
       resource::IsSharedMemoryWriter(*klass)) {
     is << "      " << WEnSrc(res) << " <= 0;\n";
-    map<IState *, IInsn *> writers;
+    StateInsnMap writers;
     if (resource::IsSharedMemory(*klass)) {
       for (auto it : callers) {
 	IInsn *insn = it.second;
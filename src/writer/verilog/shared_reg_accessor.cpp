@@ -59,7 +59,7 @@ void SharedRegAccessor::BuildSharedRegReaderResource() {
   rs << "  // shared-reg-reader\n";
   ostream &rvs = tab_.ResourceValueSectionStream();
   if (UseMailbox(&res_)) {
-    map<IState *, IInsn *> getters;
+    StateInsnMap getters;
     CollectResourceCallers(operand::kGetMailbox, &getters);
     rvs << "  assign " << wire::Names::AccessorWire(rrn, &res_, "get_req")
 	<< " = "
@@ -77,13 +77,13 @@ void SharedRegAccessor::BuildSharedRegWriterResource() {
   rs << "  // shared-reg-writer\n";
   ostream &rvs = tab_.ResourceValueSectionStream();
   // Write en signal (only for pure writes, not for notify, put_mailbox).
-  map<IState *, IInsn *> wen_callers;
+  StateInsnMap wen_callers;
   CollectResourceCallers("", &wen_callers);
   rvs << "  assign " << wire::Names::AccessorWire(wrn, &res_, "wen") << " = ";
   WriteStateUnion(wen_callers, rvs);
   rvs << ";\n";
   // Write data.
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("*", &callers);
   rvs << "  assign " << wire::Names::AccessorWire(wrn, &res_, "w") << " = ";
   string v;
@@ -98,7 +98,7 @@ void SharedRegAccessor::BuildSharedRegWriterResource() {
   rvs << v << ";\n";
   // write notify signal.
   if (UseNotify(&res_)) {
-    map<IState *, IInsn *> notifiers;
+    StateInsnMap notifiers;
     CollectResourceCallers(operand::kNotify, &notifiers);
     rvs << "  assign " << wire::Names::AccessorWire(wrn, &res_, "notify")
 	<< " = ";
@@ -107,7 +107,7 @@ void SharedRegAccessor::BuildSharedRegWriterResource() {
   }
   // write mailbox req signal.
   if (UseMailbox(&res_)) {
-    map<IState *, IInsn *> putters;
+    StateInsnMap putters;
     CollectResourceCallers(operand::kPutMailbox, &putters);
     rvs << "  assign " << wire::Names::AccessorWire(wrn, &res_, "put_req")
 	<< " = "
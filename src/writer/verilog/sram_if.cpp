@@ -31,7 +31,7 @@ void SramIf::BuildResource() {
   os << "  assign " << prefix << "rdata = "
      << SharedMemory::MemoryRdataPin(*mem, 1) << ";\n";
 
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("*", &callers);
   if (callers.size() > 0) {
     ostream &rs = tab_.ResourceSectionStream();
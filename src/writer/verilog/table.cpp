@@ -147,7 +147,12 @@ void Table::BuildMultiCycleStateReg() {
     }
   }
   ostream &ws = tmpl_->GetStream(kInsnWireDeclSection);
-  for (IResource *res : mc_resources) {
+  // Follows the order in the table to make the output independent from
+  // the addresses.
+  for (IResource *res : i_table_->resources_) {
+    if (mc_resources.find(res) == mc_resources.end()) {
+      continue;
+    }
     string w = InsnWriter::MultiCycleStateName(*res);
     ws << "  reg [1:0] " << w << ";\n";
     ostream &is = InitialValueSectionStream();
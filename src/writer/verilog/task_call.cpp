@@ -16,7 +16,7 @@ TaskCall::TaskCall(const IResource &res, const Table &table)
 }
 
 void TaskCall::BuildResource() {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("", &callers);
   ostream &ss = tab_.StateOutputSectionStream();
   string en = Task::TaskEnablePin(*(res_.GetCalleeTable()), &res_);
@@ -60,7 +60,7 @@ string Ticker::TickerName(const IResource &res) {
 }
 
 bool Ticker::HasSelfDecrement() {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectResourceCallers("*", &callers);
   for (auto it : callers) {
     IInsn *insn = it.second;
@@ -83,9 +83,9 @@ bool Ticker::HasAccessorDecrement() {
 }
 
 string Ticker::BuildSelfDecrement() {
-  map<IState *, IInsn *> allCallers;
+  StateInsnMap allCallers;
   CollectResourceCallers("*", &allCallers);
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   for (auto it : allCallers) {
     IInsn *insn = it.second;
     if (insn->inputs_.size() > 0) {
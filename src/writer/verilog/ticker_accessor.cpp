@@ -17,7 +17,7 @@ TickerAccessor::TickerAccessor(const IResource &res, const Table &table)
 }
 
 void TickerAccessor::BuildResource() {
-  map<IState *, IInsn *> callers;
+  StateInsnMap callers;
   CollectDecrementCallers(&callers);
   if (callers.size() == 0) {
     return;
@@ -78,8 +78,8 @@ bool TickerAccessor::UseDecrement(const IResource *accessor) {
   return false;
 }
 
-void TickerAccessor::CollectDecrementCallers(map<IState *, IInsn *> *callers) {
-  map<IState *, IInsn *> all_callers;
+void TickerAccessor::CollectDecrementCallers(StateInsnMap *callers) {
+  StateInsnMap all_callers;
   CollectResourceCallers("", &all_callers);
   for (auto it : all_callers) {
     IInsn *insn = it.second;
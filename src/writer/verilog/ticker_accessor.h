@@ -19,7 +19,7 @@ public:
   static bool UseDecrement(const IResource *accessor);
 
 private:
-  void CollectDecrementCallers(map<IState *, IInsn *> *callers);
+  void CollectDecrementCallers(StateInsnMap *callers);
 };
 
 }  // namespace verilog
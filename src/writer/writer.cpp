@@ -1,6 +1,8 @@
 #include "writer/writer.h"
 
 #include "iroha/iroha.h"
+#include "iroha/logging.h"
+#include "writer/binary_writer.h"
 #include "writer/connection.h"
 #include "writer/dot_writer.h"
 #include "writer/exp_writer.h"
@@ -8,6 +10,7 @@
 #include "writer/verilog/verilog_writer.h"
 
 #include <fstream>
+#include <sstream>
 
 namespace iroha {
 namespace writer {
@@ -18,25 +21,34 @@ Writer::Writer(const IDesign *design)
 }
 
 bool Writer::Write(const string &fn) {
-  ostream *os;
-  unique_ptr<ostream> os_deleter;
   if (fn.empty()) {
-    os = &cout;
-  } else {
-    string fn_path = fn;
-    if (!root_dir_.empty()) {
-      fn_path = root_dir_ + "/" + fn_path;
-    }
-    os = new ofstream(fn_path);
-    if (!(*os)) {
-      cerr << "Failed to open [" << fn_path << "]\n";
-      return false;
-    }
-    os_deleter.reset(os);
-    if (!output_marker_.empty()) {
-      cout << output_marker_ << fn << "\n";
-    }
+    return WriteToStream(fn, cout);
+  }
+  // The file is written after the whole output is built, so a fatal error
+  // (e.g. in another file of a -j batch) doesn't leave a partial file.
+  ostringstream buf;
+  bool res = WriteToStream(fn, buf);
+  string fn_path = fn;
+  if (!root_dir_.empty()) {
+    fn_path = root_dir_ + "/" + fn_path;
+  }
+  ofstream os(fn_path);
+  if (!os) {
+    LOG(USER) << "Failed to open [" << fn_path << "]";
+    return false;
+  }
+  if (!output_marker_.empty()) {
+    cout << output_marker_ << fn << "\n";
   }
+  os << buf.str();
+  if (!os) {
+    LOG(USER) << "Failed to write [" << fn << "]";
+    res = false;
+  }
+  return res;
+}
+
+bool Writer::WriteToStream(const string &fn, ostream &os) {
   string shell;
   if (output_shell_module_) {
     shell = ShellModuleName(fn);
@@ -45,23 +57,26 @@ bool Writer::Write(const string &fn) {
   if (language_ == "verilog") {
     Connection conn(design_);
     conn.Build();
-    verilog::VerilogWriter writer(design_, conn, flavor_, debug_, *os);
+    verilog::VerilogWriter writer(design_, conn, flavor_, debug_, os);
     if (!shell.empty()) {
       writer.SetShellModuleName(shell, output_self_contained_, output_vcd_);
     }
     res = writer.Write();
   } else if (language_ == "dot") {
-    DotWriter writer(design_, *os);
+    DotWriter writer(design_, os);
     writer.Write();
   } else if (language_ == "html") {
-    HtmlWriter writer(design_, *os);
+    HtmlWriter writer(design_, os);
+    writer.Write();
+  } else if (language_ == "bin") {
+    BinaryWriter writer(design_, os);
     writer.Write();
   } else {
-    ExpWriter writer(design_, *os);
+    ExpWriter writer(design_, os);
     writer.Write();
   }
-  if (!(*os)) {
-    cerr << "Failed to write [" << fn << "]\n";
+  if (!os) {
+    LOG(USER) << "Failed to write [" << fn << "]";
     res = false;
   }
   return res;
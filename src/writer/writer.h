@@ -26,6 +26,7 @@ public:
   static void DumpTable(const ITable *table, ostream &os);
 
 private:
+  bool WriteToStream(const string &fn, ostream &os);
   static string ShellModuleName(const string &fn);
 
   const IDesign *design_;